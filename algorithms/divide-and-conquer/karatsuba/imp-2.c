@@ -1,53 +1,95 @@
-/* 
+/*
   file: imp-2.c
   author: David De Potter
   email: pl3onasm@gmail.com
   license: MIT, see LICENSE file in repository root folder
   description: Karatsuba multiplication for natural numbers
-  time complexity: O(n^1.585), where n is the number 
+  time complexity: O(n^1.585), where n is the number
     of digits of the maximum of the two input numbers
 */
 
 #include "../../../lib/clib.h"
-#include "natlib/nat.h"
+#include "natlib/lnat.h"
+
+  // number of limbs below which long multiplication is used
+#define CUTOFF 32
 
 //===================================================================
-// Computes the product x * y using Karatsuba's algorithm
-Nat *karatsuba(Nat *x, Nat *y) {
-  
-  if (isZero(x) || isZero(y)) 
-    return zero();
-
-  if (x->size == 1 && y->size == 1)
-    return intToNat(firstDigit(x) * firstDigit(y));
- 
-  size_t exp = MAX(x->size, y->size) / 2;
-  Nat *s1, *s2, *s3, *s4, *x0, *x1, *y0, *y1;
-  
-    // split x and y into two parts:
-    // x = x1 * 10^exp + x0; y = y1 * 10^exp + y0
-  splitNat(x, exp, &x1, &x0); splitNat(y, exp, &y1, &y0);
-
-    // compute first component z1 = x1 * y1 
-    // and third component z3 = x0 * y0
-  Nat *z1 = karatsuba(x1, y1), *z3 = karatsuba(x0, y0);    
-
-    // compute second component 
-    // z2 = (x1 + x0) * (y1 + y0) - z1 - z3
-  Nat *p = karatsuba((s1 = addNat(x1, x0)), (s2 = addNat(y1, y0)));
+// Returns the size of the scratch buffer needed to multiply two
+// numbers of n limbs: each level uses 4(k + 1) limbs for its own
+// intermediate results, where k = ⌈n/2⌉, and passes the rest of
+// the buffer on to its subproblems, the largest of which has
+// k + 1 limbs
+size_t scratchSize(size_t n) {
+  size_t size = 0;
+  while (n >= CUTOFF) {
+    size_t k = n - n / 2;
+    size += 4 * (k + 1);
+    n = k + 1;
+  }
+  return size;
+}
+
+//===================================================================
+// Computes the product z = x * y using Karatsuba's algorithm, where
+// x and y have n limbs each and z has 2n limbs; all intermediate
+// results are kept in the scratch buffer
+void karatsuba(uint32_t const *x, uint32_t const *y, size_t n,
+               uint32_t *z, uint32_t *scratch) {
 
-  Nat *z2 = subNat((s3 = subNat(p, z1)), z3);
+  if (n < CUTOFF) {
+    mulLimbs(x, n, y, n, z);
+    return;
+  }
+
+    // split x and y into two parts, with B = 10⁹:
+    // x = x1 * B^h + x0; y = y1 * B^h + y0,
+    // where x1 and y1 have k ≥ h limbs
+  size_t h = n / 2, k = n - h;
+  uint32_t const *x0 = x, *x1 = x + h, *y0 = y, *y1 = y + h;
+  uint32_t *s1 = scratch, *s2 = s1 + k + 1, *p = s2 + k + 1;
+  uint32_t *next = p + 2 * (k + 1);
+
+    // compute first component z1 = x1 * y1, stored in the
+    // upper half of z, and third component z3 = x0 * y0,
+    // stored in the lower half of z
+  karatsuba(x1, y1, k, z + 2 * h, next);
+  karatsuba(x0, y0, h, z, next);
+
+    // compute second component
+    // z2 = (x1 + x0) * (y1 + y0) - z1 - z3
+  memcpy(s1, x1, k * sizeof(uint32_t)); s1[k] = 0;
+  memcpy(s2, y1, k * sizeof(uint32_t)); s2[k] = 0;
+  addLimbs(s1, k + 1, x0, h);
+  addLimbs(s2, k + 1, y0, h);
+  karatsuba(s1, s2, k + 1, p, next);
+  subLimbs(p, 2 * (k + 1), z + 2 * h, 2 * k);
+  subLimbs(p, 2 * (k + 1), z, 2 * h);
 
     // combine the three components to get the final result
-    // z = [z1 * 10^(2*exp)] + [z2 * 10^exp] + z3
-  mulByPow10(z1, 2 * exp); mulByPow10(z2, exp);
-  Nat *z = addNat((s4 = addNat(z1, z2)), z3);
-  
-    // free all intermediate results
-  freeNat(x0); freeNat(x1); freeNat(y0); freeNat(y1); 
-  freeNat(z1); freeNat(z2); freeNat(z3); freeNat(s1); 
-  freeNat(s2); freeNat(s3); freeNat(s4); freeNat(p);
-  
+    // z = [z1 * B^(2h)] + [z2 * B^h] + z3, where the first and
+    // last terms are already in place; z2 fits in 2n - h limbs
+  addLimbs(z + h, 2 * n - h, p, MIN(2 * (k + 1), 2 * n - h));
+}
+
+//===================================================================
+// Returns the product x * y, padding the shorter number with zeros
+LNat *multiply(LNat *x, LNat *y) {
+
+  if (isZeroLNat(x) || isZeroLNat(y))
+    return newLNat(1);
+
+  size_t n = MAX(x->size, y->size);
+  reserveLNat(x, n);
+  reserveLNat(y, n);
+
+  LNat *z = newLNat(2 * n);
+  uint32_t *scratch = safeCalloc(scratchSize(n) + 1, sizeof(uint32_t));
+  karatsuba(x->limbs, y->limbs, n, z->limbs, scratch);
+  z->size = 2 * n;
+  trimLNat(z);
+
+  free(scratch);
   return z;
 }
 
@@ -55,13 +97,13 @@ Nat *karatsuba(Nat *x, Nat *y) {
 
 int main() {
 
-  Nat *x = readNat(), *y = readNat();
+  LNat *x = readLNat(), *y = readLNat();
 
-  Nat *prod = karatsuba(x, y);
-  showNat(prod);
-  
-  freeNat(x);
-  freeNat(y);
-  freeNat(prod);
+  LNat *prod = multiply(x, y);
+  showLNat(prod);
+
+  freeLNat(x);
+  freeLNat(y);
+  freeLNat(prod);
   return 0;
-}
\ No newline at end of file
+}
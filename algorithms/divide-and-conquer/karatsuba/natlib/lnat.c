@@ -0,0 +1,210 @@
+/*
+  file: lnat.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: arbitrary precision arithmetic for natural numbers,
+    stored as limbs of 9 decimal digits
+*/
+
+#include "../../../../lib/clib.h"
+#include "lnat.h"
+
+//===================================================================
+// Creates a new natural number 0 with given capacity
+LNat *newLNat(size_t capacity) {
+  LNat *n = safeCalloc(1, sizeof(LNat));
+  n->capacity = MAX(capacity, 1);
+  n->limbs = safeCalloc(n->capacity, sizeof(uint32_t));
+  return n;
+}
+
+//===================================================================
+// Deallocates the memory used by a natural number
+void freeLNat(LNat *n) {
+  free(n->limbs);
+  free(n);
+}
+
+//===================================================================
+// Makes sure that n can hold at least capacity limbs
+void reserveLNat(LNat *n, size_t capacity) {
+  if (n->capacity >= capacity)
+    return;
+  n->limbs = safeRealloc(n->limbs, capacity * sizeof(uint32_t));
+  memset(n->limbs + n->capacity, 0,
+         (capacity - n->capacity) * sizeof(uint32_t));
+  n->capacity = capacity;
+}
+
+//===================================================================
+// Packs the decimal digits s[0..len) into a new natural number
+static LNat *digitsToLNat(char const *s, size_t len) {
+  LNat *n = newLNat(len / LNAT_DIGITS + 1);
+  while (len) {
+      // the next limb covers the digits s[from..len)
+    size_t from = len > LNAT_DIGITS ? len - LNAT_DIGITS : 0;
+    uint32_t limb = 0;
+    for (size_t i = from; i < len; ++i)
+      limb = limb * 10 + (s[i] - '0');
+    n->limbs[n->size++] = limb;
+    len = from;
+  }
+  trimLNat(n);
+  return n;
+}
+
+//===================================================================
+// Reads a natural number from stdin
+LNat *readLNat() {
+  reader *R = stdinReader();
+  readerSkipSpace(R);
+
+  int ch = readerPeek(R);
+  if (ch < '0' || ch > '9') {
+    fprintf(stderr, "Invalid input\n");
+    exit(EXIT_FAILURE);
+  }
+
+  size_t len = 0, cap = 100;
+  char *digits = safeCalloc(cap, sizeof(char));
+  while ((ch = readerPeek(R)) >= '0' && ch <= '9') {
+    if (len == cap) {
+      cap *= 2;
+      digits = safeRealloc(digits, cap * sizeof(char));
+    }
+    digits[len++] = readerChar(R);
+  }
+
+  LNat *n = digitsToLNat(digits, len);
+  free(digits);
+  return n;
+}
+
+//===================================================================
+// Shows a natural number
+void showLNat(LNat *n) {
+  if (isZeroLNat(n)) {
+    printf("0\n");
+    return;
+  }
+    // all limbs but the leading one have exactly 9 digits
+  printf("%u", n->limbs[n->size - 1]);
+  for (size_t i = n->size - 1; i-- > 0; )
+    printf("%09u", n->limbs[i]);
+  printf("\n");
+}
+
+//===================================================================
+// Converts a digit based natural number to a limb based one
+LNat *natToLNat(Nat *n) {
+  return digitsToLNat(n->digits + n->start, n->size);
+}
+
+//===================================================================
+// Converts a limb based natural number to a digit based one
+Nat *lnatToNat(LNat *n) {
+  if (isZeroLNat(n))
+    return zero();
+
+  char top[LNAT_DIGITS + 1];
+  size_t topLen = sprintf(top, "%u", n->limbs[n->size - 1]);
+  Nat *nat = newNat(topLen + (n->size - 1) * LNAT_DIGITS + 1);
+  memcpy(nat->digits, top, topLen);
+  nat->size = topLen;
+
+  for (size_t i = n->size - 1; i-- > 0; ) {
+    uint32_t limb = n->limbs[i];
+    for (int j = LNAT_DIGITS - 1; j >= 0; --j) {
+      nat->digits[nat->size + j] = limb % 10 + '0';
+      limb /= 10;
+    }
+    nat->size += LNAT_DIGITS;
+  }
+  return nat;
+}
+
+//===================================================================
+// Adds b to a in place and returns the carry
+uint32_t addLimbs(uint32_t *a, size_t aLen,
+                  uint32_t const *b, size_t bLen) {
+  uint32_t carry = 0;
+  size_t i = 0;
+  for (; i < bLen; ++i) {
+    uint32_t sum = a[i] + b[i] + carry;
+    carry = sum >= LNAT_BASE;
+    a[i] = carry ? sum - LNAT_BASE : sum;
+  }
+  for (; carry && i < aLen; ++i) {
+    carry = a[i] == LNAT_BASE - 1;
+    a[i] = carry ? 0 : a[i] + 1;
+  }
+  return carry;
+}
+
+//===================================================================
+// Subtracts b from a in place and returns the borrow
+uint32_t subLimbs(uint32_t *a, size_t aLen,
+                  uint32_t const *b, size_t bLen) {
+  uint32_t borrow = 0;
+  size_t i = 0;
+  for (; i < bLen; ++i) {
+    uint32_t sub = b[i] + borrow;
+    borrow = a[i] < sub;
+    a[i] = borrow ? a[i] + LNAT_BASE - sub : a[i] - sub;
+  }
+  for (; borrow && i < aLen; ++i) {
+    borrow = a[i] == 0;
+    a[i] = borrow ? LNAT_BASE - 1 : a[i] - 1;
+  }
+  return borrow;
+}
+
+//===================================================================
+// Computes the product of x and y using long multiplication
+void mulLimbs(uint32_t const *x, size_t xLen,
+              uint32_t const *y, size_t yLen, uint32_t *z) {
+  memset(z, 0, (xLen + yLen) * sizeof(uint32_t));
+  for (size_t i = 0; i < xLen; ++i) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < yLen; ++j) {
+      uint64_t cur = z[i + j] + (uint64_t)x[i] * y[j] + carry;
+      z[i + j] = cur % LNAT_BASE;
+      carry = cur / LNAT_BASE;
+    }
+    z[i + yLen] = carry;
+  }
+}
+
+//===================================================================
+// Adds y to x in place
+void addLNat(LNat *x, LNat *y) {
+  size_t size = MAX(x->size, y->size);
+  reserveLNat(x, size + 1);
+  x->size = size;
+  if (addLimbs(x->limbs, size, y->limbs, y->size))
+    x->limbs[x->size++] = 1;
+}
+
+//===================================================================
+// Subtracts y from x in place; requires x >= y
+void subLNat(LNat *x, LNat *y) {
+  if (x->size < y->size ||
+      subLimbs(x->limbs, x->size, y->limbs, y->size)) {
+    fprintf(stderr, "Subtraction not supported "
+                    "for negative numbers\n");
+    exit(EXIT_FAILURE);
+  }
+  trimLNat(x);
+}
+
+//===================================================================
+// Multiplies n by (10⁹)^k in place
+void shiftLNat(LNat *n, size_t k) {
+  if (isZeroLNat(n) || k == 0)
+    return;
+  reserveLNat(n, n->size + k);
+  memmove(n->limbs + k, n->limbs, n->size * sizeof(uint32_t));
+  memset(n->limbs, 0, k * sizeof(uint32_t));
+  n->size += k;
+}
@@ -0,0 +1,79 @@
+#ifndef LNAT_H_INCLUDED
+#define LNAT_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "nat.h"
+
+#define LNAT_BASE 1000000000u   // limb base 10⁹
+#define LNAT_DIGITS 9           // decimal digits per limb
+
+  // A natural number stored as an array of limbs in base 10⁹,
+  // least significant limb first; the decimal digits are only
+  // needed for input and output. Zero has size 0
+typedef struct {
+  uint32_t *limbs;
+  size_t size, capacity;
+} LNat;
+
+  // Creates a new natural number 0 with given capacity in limbs
+LNat *newLNat(size_t capacity);
+
+  // Deallocates the memory used by a natural number
+void freeLNat(LNat *n);
+
+  // Reads a natural number in decimal notation from stdin
+LNat *readLNat();
+
+  // Shows a natural number in decimal notation on stdout
+void showLNat(LNat *n);
+
+  // Converts a digit based natural number to a limb based one
+LNat *natToLNat(Nat *n);
+
+  // Converts a limb based natural number to a digit based one
+Nat *lnatToNat(LNat *n);
+
+  // Makes sure that n can hold at least capacity limbs
+void reserveLNat(LNat *n, size_t capacity);
+
+  // Adds y to x in place
+void addLNat(LNat *x, LNat *y);
+
+  // Subtracts y from x in place
+  // Precondition: x >= y
+void subLNat(LNat *x, LNat *y);
+
+  // Multiplies n by (10⁹)^k in place, by shifting its limbs
+void shiftLNat(LNat *n, size_t k);
+
+  // Returns true if n is zero
+static inline bool isZeroLNat(LNat *n) {
+  return n->size == 0;
+}
+
+  // Removes the leading zero limbs of n
+static inline void trimLNat(LNat *n) {
+  while (n->size && ! n->limbs[n->size - 1])
+    n->size--;
+}
+
+  // Operations on plain limb arrays, least significant limb first
+
+  // Adds b (bLen limbs) to a (aLen ≥ bLen limbs) in place
+  // Returns the carry out of the aLen limbs of a
+uint32_t addLimbs(uint32_t *a, size_t aLen,
+                  uint32_t const *b, size_t bLen);
+
+  // Subtracts b (bLen limbs) from a (aLen ≥ bLen limbs) in place
+  // Returns the borrow out of the aLen limbs of a
+uint32_t subLimbs(uint32_t *a, size_t aLen,
+                  uint32_t const *b, size_t bLen);
+
+  // Computes the product of x (xLen limbs) and y (yLen limbs)
+  // using long multiplication; z should have xLen + yLen limbs
+void mulLimbs(uint32_t const *x, size_t xLen,
+              uint32_t const *y, size_t yLen, uint32_t *z);
+
+#endif // LNAT_H_INCLUDED
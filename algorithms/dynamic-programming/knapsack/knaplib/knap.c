@@ -0,0 +1,198 @@
+/*
+  file: knap.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: 0-1 knapsack without the full DP table, using a
+    single row for the maximum value, a divide-and-conquer
+    reconstruction of an optimal subset, and a bitset for the
+    subset sums of the weights
+*/
+
+#include "knap.h"
+
+  // The reconstruction switches to the full DP table once a
+  // subproblem has at most this many entries
+#define BASE_CASE 65536
+
+//===================================================================
+// Fills row[0..W] with the maximum values of the items [lo, hi) for
+// all capacities 0..W
+static void fillRow(knapItem *items, size_t lo, size_t hi, size_t W,
+                    double *row) {
+  for (size_t w = 0; w <= W; w++)
+    row[w] = 0;
+  for (size_t i = lo; i < hi; i++) {
+    size_t wt = items[i].weight;
+    double v = items[i].value;
+      // from right to left, so that row[w - wt] still belongs to
+      // the previous item
+    for (size_t w = W; w >= wt && w != SIZE_MAX; w--)
+      row[w] = MAX(row[w], row[w - wt] + v);
+  }
+}
+
+//===================================================================
+// Returns the maximum value of a subset of the items with total
+// weight at most W
+double knapValue(knapItem *items, size_t n, size_t W) {
+  double *row = safeCalloc(W + 1, sizeof(double));
+  fillRow(items, 0, n, W, row);
+  double value = row[W];
+  free(row);
+  return value;
+}
+
+//===================================================================
+// Appends an optimal subset of the items [lo, hi) for capacity W
+// to out, using the full DP table as in knapsack-3.c: walking back
+// from the last item, an item is included if leaving it out would
+// lower the value
+static void baseCase(knapItem *items, size_t lo, size_t hi, size_t W,
+                     size_t *out, size_t *count) {
+
+  size_t k = hi - lo;
+  double *table = safeCalloc((k + 1) * (W + 1), sizeof(double));
+  for (size_t i = 1; i <= k; i++) {
+    double *row = table + i * (W + 1), *prev = row - (W + 1);
+    knapItem *it = items + lo + i - 1;
+    for (size_t w = 0; w <= W; w++)
+      row[w] = it->weight <= w ? MAX(prev[w], prev[w - it->weight]
+                                              + it->value)
+                               : prev[w];
+  }
+
+    // the indices are found in decreasing order
+  size_t first = *count;
+  for (size_t i = k, w = W; i > 0; i--)
+    if (table[i * (W + 1) + w] != table[(i - 1) * (W + 1) + w]) {
+      out[(*count)++] = lo + i - 1;
+      w -= items[lo + i - 1].weight;
+    }
+  for (size_t a = first, b = *count; a + 1 < b; a++, b--) {
+    size_t tmp = out[a]; out[a] = out[b - 1]; out[b - 1] = tmp;
+  }
+  free(table);
+}
+
+//===================================================================
+// Appends an optimal subset of the items [lo, hi) for capacity W
+// to out: the best values of the first half for all capacities, and
+// those of the second half, give the capacity w for which the first
+// half with capacity w and the second half with capacity W - w is
+// best, after which both halves are solved independently
+static void reconstruct(knapItem *items, size_t lo, size_t hi,
+                        size_t W, double *f, double *g, size_t *out,
+                        size_t *count) {
+
+  if ((hi - lo) * (W + 1) <= BASE_CASE || hi - lo == 1) {
+    baseCase(items, lo, hi, W, out, count);
+    return;
+  }
+
+  size_t mid = lo + (hi - lo) / 2, split = 0;
+  fillRow(items, lo, mid, W, f);
+  fillRow(items, mid, hi, W, g);
+
+    // on ties, the first half gets the larger capacity, as the
+    // reconstruction in knapsack-3.c prefers leaving out later items
+  for (size_t w = 0; w <= W; w++)
+    if (f[w] + g[W - w] >= f[split] + g[W - split])
+      split = w;
+
+  reconstruct(items, lo, mid, split, f, g, out, count);
+  reconstruct(items, mid, hi, W - split, f, g, out, count);
+}
+
+//===================================================================
+// Returns the indices of the items of an optimal subset
+size_t *knapItems(knapItem *items, size_t n, size_t W, size_t *count) {
+  size_t *out = safeCalloc(n + 1, sizeof(size_t));
+  *count = 0;
+  if (n == 0)
+    return out;
+  double *f = safeCalloc(W + 1, sizeof(double));
+  double *g = safeCalloc(W + 1, sizeof(double));
+  reconstruct(items, 0, n, W, f, g, out, count);
+  free(f);
+  free(g);
+  return out;
+}
+
+  // Four words of a bitset, which the compiler maps onto the SIMD 
+  // registers of the target: two SSE2 registers, or one AVX2 register
+typedef uint64_t wideWord __attribute__ ((vector_size (32)));
+
+//===================================================================
+// Sets dst to src | (src << shift) for the first words of both
+// bitsets, four words at a time; the words are copied in and out
+// of the vectors, since the bitsets need not be aligned
+static void shiftOr(uint64_t *restrict dst,
+                    uint64_t const *restrict src,
+                    size_t words, size_t shift) {
+
+  size_t q = shift / 64, r = shift % 64, i = 0;
+  for ( ; i < MIN(q + 1, words); i++)
+    dst[i] = src[i] | (i == q ? src[0] << r : 0);
+  if (r == 0) {
+    for ( ; i + 4 <= words; i += 4) {
+      wideWord a, b;
+      memcpy(&a, src + i, sizeof(a));
+      memcpy(&b, src + i - q, sizeof(b));
+      a |= b;
+      memcpy(dst + i, &a, sizeof(a));
+    }
+    for ( ; i < words; i++)
+      dst[i] = src[i] | src[i - q];
+    return;
+  }
+  for ( ; i + 4 <= words; i += 4) {
+    wideWord a, b, c;
+    memcpy(&a, src + i, sizeof(a));
+    memcpy(&b, src + i - q, sizeof(b));
+    memcpy(&c, src + i - q - 1, sizeof(c));
+    a |= b << r | c >> (64 - r);
+    memcpy(dst + i, &a, sizeof(a));
+  }
+  for ( ; i < words; i++)
+    dst[i] = src[i] | src[i - q] << r | src[i - q - 1] >> (64 - r);
+}
+
+//===================================================================
+// Returns the set of all subset sums s ≤ W of the weights
+uint64_t *knapSubsetSums(size_t *weights, size_t n, size_t W) {
+
+  size_t words = W / 64 + 1;
+  uint64_t *cur = safeCalloc(words, sizeof(uint64_t));
+  uint64_t *next = safeCalloc(words, sizeof(uint64_t));
+  cur[0] = 1;
+
+    // only the words up to the sum of the weights so far can hold
+    // reachable sums, so that the others need not be shifted
+  size_t reach = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (weights[i] > W)
+      continue;
+    reach = MIN(W, reach + weights[i]);
+    shiftOr(next, cur, reach / 64 + 1, weights[i]);
+    uint64_t *tmp = cur; cur = next; next = tmp;
+  }
+
+    // clear the sums above W in the last word
+  if ((W + 1) % 64)
+    cur[words - 1] &= (UINT64_C(1) << (W + 1) % 64) - 1;
+  free(next);
+  return cur;
+}
+
+//===================================================================
+// Returns the largest subset sum s ≤ W of the weights
+size_t knapMaxSum(size_t *weights, size_t n, size_t W) {
+  uint64_t *sums = knapSubsetSums(weights, n, W);
+  size_t w = W / 64;
+  while (! sums[w])
+    w--;
+  size_t s = 64 * w + 63 - __builtin_clzll(sums[w]);
+  free(sums);
+  return s;
+}
@@ -0,0 +1,42 @@
+#ifndef KNAP_H_INCLUDED
+#define KNAP_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // An item with a weight and a value
+typedef struct {
+  size_t weight;
+  double value;
+} knapItem;
+
+  // Returns the maximum value of a subset of the n items with total
+  // weight at most W, using a single row of the DP table, which is 
+  // updated in place from right to left for each item; 
+  // O(nW) time, O(W) space
+double knapValue(knapItem *items, size_t n, size_t W);
+
+  // Returns the indices of the items of an optimal subset in 
+  // increasing order, and stores their number in *count, using a 
+  // divide-and-conquer reconstruction in the style of Hirschberg's
+  // algorithm that only needs two rows of the DP table at a time;
+  // O(nW) time, O(n + W) space
+size_t *knapItems(knapItem *items, size_t n, size_t W, size_t *count);
+
+  // Returns the set of all sums s ≤ W of subsets of the n weights as
+  // a bitset of W / 64 + 1 words, where bit s is set if s can be 
+  // reached; each weight shifts the whole bitset and ORs it into 
+  // itself, 64 sums per word; O(nW/64) time, O(W/64) space
+uint64_t *knapSubsetSums(size_t *weights, size_t n, size_t W);
+
+  // Returns the largest sum s ≤ W of a subset of the n weights
+size_t knapMaxSum(size_t *weights, size_t n, size_t W);
+
+  // Returns true if bit s of the bitset is set
+static inline bool knapHasSum(uint64_t const *sums, size_t s) {
+  return sums[s / 64] >> (s % 64) & 1;
+}
+
+#endif // KNAP_H_INCLUDED
@@ -0,0 +1,139 @@
+/*
+  Benchmark of the 0-1 knapsack algorithms: the bottom-up DP of
+    knapsack-3.c with a full table, the single row of knapValue,
+    the divide-and-conquer reconstruction of knapItems, and for
+    subset sums, a DP over a row of booleans against the bitset
+    of knapSubsetSums
+  For each capacity W, n random items with weights up to W/8 are
+    packed with each algorithm, as long as the full table fits in
+    about 1 GB, and the values are compared. The memory column
+    shows the bytes of the tables of each algorithm
+  Usage: ./knapBench.out [maxW] [n]
+  Author: David De Potter
+*/
+
+#include "../knap.h"
+#include <time.h>
+
+  // the largest table of knapsack-3.c that is still built
+#define MAX_TABLE (1UL << 30)
+
+//===================================================================
+// Returns the maximum value of the items, using the bottom-up DP
+// of knapsack-3.c with a full (n+1) x (W+1) table
+double computeTable(knapItem *items, size_t n, size_t W) {
+  CREATE_MATRIX(double, memo, n + 1, W + 1, 0);
+  for (size_t i = 1; i <= n; i++)
+    for (size_t w = 1; w <= W; w++)
+      if (items[i - 1].weight <= w)
+        memo[i][w] = MAX(memo[i - 1][w],
+                         memo[i - 1][w - items[i - 1].weight]
+                         + items[i - 1].value);
+      else
+        memo[i][w] = memo[i - 1][w];
+  double value = memo[n][W];
+  FREE_MATRIX(memo, n + 1);
+  return value;
+}
+
+//===================================================================
+// Returns the total value of the items chosen by knapItems, or -1
+// if they weigh more than W
+double computeItems(knapItem *items, size_t n, size_t W) {
+  size_t count, weight = 0, *idx = knapItems(items, n, W, &count);
+  double value = 0;
+  for (size_t i = 0; i < count; i++) {
+    weight += items[idx[i]].weight;
+    value += items[idx[i]].value;
+  }
+  free(idx);
+  return weight <= W ? value : -1;
+}
+
+//===================================================================
+// Returns the largest subset sum s ≤ W of the weights, using a DP
+// over a single row of booleans
+size_t computeBoolSums(size_t *weights, size_t n, size_t W) {
+  bool *reach = safeCalloc(W + 1, sizeof(bool));
+  reach[0] = true;
+  for (size_t i = 0; i < n; i++)
+    for (size_t w = W; w >= weights[i] && w != SIZE_MAX; w--)
+      reach[w] |= reach[w - weights[i]];
+  size_t s = W;
+  while (! reach[s])
+    s--;
+  free(reach);
+  return s;
+}
+
+//===================================================================
+// Returns the time in seconds since start
+double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+// Shows a row of the table: the name of an algorithm, its time,
+// its memory in KB, and its result, compared against ref
+void showRow(char const *name, double time, size_t bytes,
+             double result, double ref) {
+  printf("  %-12s  %9.4fs  %12zu  %14.2lf%s\n", name, time,
+         bytes / 1024, result, result != ref ? " (wrong!)" : "");
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxW = argc > 1 ? strtoul(argv[1], NULL, 10) : 1 << 20;
+  size_t n = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000;
+  srand(42);
+
+  knapItem *items = safeCalloc(n, sizeof(knapItem));
+  size_t *weights = safeCalloc(n, sizeof(size_t));
+
+  for (size_t W = 1024; W <= maxW; W *= 4) {
+    for (size_t i = 0; i < n; i++) {
+      items[i].weight = weights[i] = rand() % (W / 8) + 1;
+      items[i].value = rand() % 1000 + 1;
+    }
+
+    printf("W = %zu, n = %zu\n", W, n);
+    printf("  %-12s  %10s  %12s  %14s\n", "algorithm", "time",
+           "memory (KB)", "result");
+
+    clock_t start = clock();
+    double ref = knapValue(items, n, W);
+    double time = elapsed(start);
+
+    size_t bytes = (n + 1) * (W + 1) * sizeof(double);
+    if (bytes <= MAX_TABLE) {
+      start = clock();
+      double value = computeTable(items, n, W);
+      showRow("table", elapsed(start), bytes, value, ref);
+    } else
+      printf("  %-12s  %10s\n", "table", "skipped");
+
+    showRow("row", time, (W + 1) * sizeof(double), ref, ref);
+
+    start = clock();
+    double value = computeItems(items, n, W);
+    showRow("items", elapsed(start), 2 * (W + 1) * sizeof(double)
+            + (n + 1) * sizeof(size_t) + 65536 * sizeof(double),
+            value, ref);
+
+    start = clock();
+    size_t sum = computeBoolSums(weights, n, W);
+    showRow("bool sums", elapsed(start), (W + 1) * sizeof(bool),
+            sum, sum);
+
+    start = clock();
+    size_t bitSum = knapMaxSum(weights, n, W);
+    showRow("bitset sums", elapsed(start),
+            2 * (W / 64 + 1) * sizeof(uint64_t), bitSum, sum);
+    printf("\n");
+  }
+
+  free(items);
+  free(weights);
+  return 0;
+}
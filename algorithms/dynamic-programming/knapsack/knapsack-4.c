@@ -0,0 +1,76 @@
+/* 
+  file: knapsack-4.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: 0-1 knapsack problem
+    bottom-up DP approach in linear space, where the maximum value
+    is computed with a single row of the table, and the items are
+    reconstructed by divide and conquer (see knaplib/knap.c)
+  time complexity: O(nW)
+  space complexity: O(n + W)
+*/ 
+ 
+#include "../../../lib/clib.h"
+#include "knaplib/knap.h"
+
+//===================================================================
+// Reads items from stdin
+knapItem *readItems (size_t *len) {
+  size_t cap = 100;
+  knapItem *items = safeCalloc(cap, sizeof(knapItem));
+  while (scanf(" ( %zu , %lf ) , ", &items[*len].weight, 
+                                    &items[*len].value) == 2) {
+    if (++*len == cap) {
+      cap *= 2;
+      items = safeRealloc(items, cap * sizeof(knapItem));
+    }
+  }
+
+  items = safeRealloc(items, *len * sizeof(knapItem));
+  return items;
+}
+
+//===================================================================
+// Shows the items that are included in the knapsack along with
+// the total value and weight, last item first as in knapsack-3.c
+void showItems (knapItem *items, size_t *chosen, size_t count,
+                double value) {
+  
+  printf("Items included:\n");
+  size_t totalWeight = 0;
+
+  for (size_t k = count; k--; ) {
+    knapItem *it = items + chosen[k];
+    printf("  (%zu,%.2lf)\n", it->weight, it->value);
+    totalWeight += it->weight;
+  }
+
+  printf("\nTotal value: € %.2lf\n"
+         "Total weight: %zu kg\n", value, totalWeight);
+}
+
+//===================================================================
+
+int main () {
+
+    // read knapsack capacity
+  size_t W;
+  assert(scanf("%zu ", &W) == 1);
+
+    // read items
+  size_t len = 0;
+  knapItem *items = readItems(&len);
+
+  double value = knapValue(items, len, W);
+
+  size_t count;
+  size_t *chosen = knapItems(items, len, W, &count);
+
+  showItems(items, chosen, count, value);
+
+  free(items);
+  free(chosen);
+  
+  return 0;
+}
@@ -3,8 +3,10 @@
   author: David De Potter
   email: pl3onasm@gmail.com
   license: MIT, see LICENSE file in repository root folder
-  description: longest common subsequence, bottom-up DP approach
-  Time complexity: O(nm)
+  description: longest common subsequence, bottom-up DP approach,
+    where the table is filled in anti-diagonal wavefront order by a
+    pool of threads, one tile at a time (see ../wflib/wf.c)
+  Time complexity: O(nm), or O(nm/p) on p processors
   Space complexity: O(nm)
   Note: no need to initialize the table with SIZE_MAX as in 
     lcs-2.c, because we fill the table in a bottom-up fashion
@@ -12,46 +14,67 @@
 */ 
 
 #include "../../../lib/clib.h"
+#include "../wflib/wf.h"
+
+  // The strings and the (|X| + 1) x (|Y| + 1) table, which is 
+  // stored row by row in a single contiguous block
+typedef struct {
+  string *X, *Y;
+  size_t *table, cols;
+} lcsTable;
 
 //===================================================================
-// Returns the length of the longest common subsequence of X and Y
-// using a bottom-up dynamic programming approach
-size_t computeLcs (size_t **table, string *X, string *Y) {
-  
-  for (size_t i = 1; i <= strLen(X); ++i) {
-    for (size_t j = 1; j <= strLen(Y); ++j) {
-      if (charAt(X, i - 1) == charAt(Y, j - 1))
+// Fills the entries (i, j) of the table for i in (r0, r1] and j in 
+// (c0, c1], given that the entries above and to the left of them 
+// are known; row 0 and column 0 are the base cases
+void lcsKernel(size_t r0, size_t r1, size_t c0, size_t c1, 
+               void *arg) {
+
+  lcsTable *L = arg;
+  for (size_t i = r0 + 1; i <= r1; ++i) {
+    size_t *row = L->table + i * L->cols, *up = row - L->cols;
+    for (size_t j = c0 + 1; j <= c1; ++j) {
+      if (charAt(L->X, i - 1) == charAt(L->Y, j - 1))
         // last chars of X and Y are identical: add 1
-        table[i][j] = table[i - 1][j - 1] + 1; 
+        row[j] = up[j - 1] + 1; 
       else 
         // compute the maximum of the LCSs of the two alternatives:
         // either we remove the last char of X or the last char of Y
-        table[i][j] = MAX(table[i - 1][j], table[i][j - 1]); 
+        row[j] = MAX(up[j], row[j - 1]); 
     }
   }
-  return table[strLen(X)][strLen(Y)];
+}
+
+//===================================================================
+// Returns the length of the longest common subsequence of X and Y
+// using a bottom-up dynamic programming approach
+size_t computeLcs (lcsTable *L) {
+  wfRun(strLen(L->X), strLen(L->Y), WF_TILE, lcsKernel, L, 
+        wfProcessors());
+  return L->table[strLen(L->X) * L->cols + strLen(L->Y)];
 } 
 
 //===================================================================
 // Recursively reconstructs a longest common subsequence
 // from the memoization table and prints it
-void reconstructLcs (size_t **table, string *X, size_t x, size_t y) {
+void reconstructLcs (lcsTable *L, size_t x, size_t y) {
   
   if (x == 0 || y == 0) 
     return;
 
-  if (table[x][y] == table[x - 1][y]) 
+  size_t *row = L->table + x * L->cols, *up = row - L->cols;
+  if (row[y] == up[y]) 
     // if the value to the left is the same, we move to the left
-    reconstructLcs(table, X, x - 1, y);
+    reconstructLcs(L, x - 1, y);
 
-  else if (table[x][y] == table[x][y - 1]) 
+  else if (row[y] == row[y - 1]) 
     // if the value above is the same, we move up
-    reconstructLcs(table, X, x, y - 1);
+    reconstructLcs(L, x, y - 1);
 
   else {
     // move diagonally up and left and print char after recursion
-    reconstructLcs(table, X, x - 1, y - 1);
-    printf("%c", charAt(X, x - 1));
+    reconstructLcs(L, x - 1, y - 1);
+    printf("%c", charAt(L->X, x - 1));
   }
 } 
 
@@ -62,15 +85,16 @@ int main () {
   READ_STRING(X, '\n'); 
   READ_STRING(Y, '\n');
 
-  CREATE_MATRIX(size_t, table, strLen(X) + 1, strLen(Y) + 1, 0);
+  lcsTable L = { X, Y, NULL, strLen(Y) + 1 };
+  L.table = safeCalloc((strLen(X) + 1) * L.cols, sizeof(size_t));
 
-  size_t lcs = computeLcs(table, X, Y);
+  size_t lcs = computeLcs(&L);
   
   printf("Max length: %zu\nExample LCS:\n  ", lcs);
-  reconstructLcs(table, X, strLen(X), strLen(Y));
+  reconstructLcs(&L, strLen(X), strLen(Y));
   printf("\n");
 
-  FREE_MATRIX(table, strLen(X) + 1);
+  free(L.table);
   freeString(X);
   freeString(Y);
   
@@ -0,0 +1,35 @@
+/* 
+  file: lcs-4.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: longest common subsequence in linear space, using
+    Hirschberg's divide-and-conquer algorithm, where the rows of 
+    the DP table are computed 64 entries at a time with a 
+    bit-parallel algorithm (see lcslib/lcs.c)
+  Time complexity: O(nm/w), where w = 64 is the word size
+  Space complexity: O(m + σn/w), where σ is the number of distinct
+    characters in Y
+*/ 
+
+#include "../../../lib/clib.h"
+#include "lcslib/lcs.h"
+
+//===================================================================
+
+int main () {
+
+  READ_STRING(X, '\n'); 
+  READ_STRING(Y, '\n');
+
+  string *lcs = lcsHirschberg(X, Y);
+  
+  printf("Max length: %zu\nExample LCS:\n  %s\n", strLen(lcs), 
+         str(lcs));
+
+  freeString(lcs);
+  freeString(X);
+  freeString(Y);
+  
+  return 0;
+}
@@ -0,0 +1,230 @@
+/*
+  file: lcs.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: longest common subsequence in linear space, using a 
+    bit-parallel algorithm for the rows of the DP table, and 
+    Hirschberg's algorithm to reconstruct a longest common 
+    subsequence from these rows
+*/
+
+#include "lcs.h"
+
+  // Hirschberg's algorithm switches to the full DP table once a 
+  // subproblem has at most this many entries
+#define BASE_CASE 4096
+
+  // The state of the bit-parallel algorithm for a range of Y. Bit j
+  // of match[c] is set if Y[j] = c, where the characters of Y are 
+  // mapped to their rank in the alphabet of Y, so that there are 
+  // only as many bit vectors as distinct characters in Y
+typedef struct {
+  size_t words;           // number of words per bit vector
+  size_t sigma;           // number of distinct characters in Y
+  int16_t map[256];       // rank of each character, or -1
+  uint64_t *match;        // sigma bit vectors of the matches
+  uint64_t *row;          // the current row
+} bitRow;
+
+//===================================================================
+// Sets up the match vectors for Y[0..n-1], read backwards if 
+// reverse is true; maxLen is the maximum length of Y that the state
+// will be used for
+static void initBitRow(bitRow *B, unsigned char const *Y, size_t n, 
+                       bool reverse, size_t maxLen) {
+  if (! B->match) {
+    B->sigma = 0;
+    for (size_t c = 0; c < 256; c++) 
+      B->map[c] = -1;
+    for (size_t j = 0; j < maxLen; j++) 
+      if (B->map[Y[j]] < 0) 
+        B->map[Y[j]] = B->sigma++;
+    B->words = maxLen / 64 + 1;
+    B->match = safeCalloc(B->sigma * B->words, sizeof(uint64_t));
+    B->row = safeCalloc(B->words, sizeof(uint64_t));
+  }
+  size_t words = n / 64 + 1;
+  for (size_t j = 0; j < n; j++) {
+    size_t k = reverse ? n - 1 - j : j;
+    B->match[B->map[Y[k]] * B->words + j / 64] |= 
+      UINT64_C(1) << (j % 64);
+  }
+  for (size_t w = 0; w < words; w++) 
+    B->row[w] = UINT64_MAX;
+}
+
+//===================================================================
+// Clears the match vectors that were set for Y[0..n-1], where each 
+// character only set a bit in a single word
+static void clearBitRow(bitRow *B, unsigned char const *Y, size_t n,
+                        bool reverse) {
+  for (size_t j = 0; j < n; j++) {
+    size_t k = reverse ? n - 1 - j : j;
+    B->match[B->map[Y[k]] * B->words + j / 64] = 0;
+  }
+}
+
+//===================================================================
+// Advances the row by the characters X[0..m-1], read backwards if 
+// reverse is true, where the row covers n characters of Y. A zero 
+// bit j in the row means that the LCS of the part of X read so far
+// and Y[0..j] is one longer than that of X and Y[0..j-1]. Each 
+// character c updates the row as (V + U) | (V - U), where U are 
+// the bits of V at positions where Y has c, with the carry and 
+// borrow passed on from word to word
+static void advanceBitRow(bitRow *B, unsigned char const *X, 
+                          size_t m, bool reverse, size_t n) {
+  size_t words = n / 64 + 1;
+  uint64_t *V = B->row;
+  for (size_t i = 0; i < m; i++) {
+    unsigned char c = X[reverse ? m - 1 - i : i];
+    if (B->map[c] < 0) 
+      continue;
+    uint64_t const *M = B->match + B->map[c] * B->words;
+    uint64_t carry = 0, borrow = 0;
+    for (size_t w = 0; w < words; w++) {
+      uint64_t v = V[w], u = v & M[w];
+      uint64_t sum = v + u, diff = v - u;
+      uint64_t sum2 = sum + carry, diff2 = diff - borrow;
+      carry = (sum < v) | (sum2 < sum);
+      borrow = (v < u) | (diff < borrow);
+      V[w] = sum2 | diff2;
+    }
+  }
+}
+
+//===================================================================
+// Stores in L[j] the number of zero bits among the first j bits of
+// the row, which is the LCS length for the first j characters of Y
+static void rowLengths(bitRow *B, size_t n, size_t *L) {
+  L[0] = 0;
+  for (size_t j = 0; j < n; j++) 
+    L[j + 1] = L[j] + ! ((B->row[j / 64] >> (j % 64)) & 1);
+}
+
+//===================================================================
+// Returns the length of a longest common subsequence of X and Y
+size_t lcsLength(string *X, string *Y) {
+  unsigned char const *x = (unsigned char *) str(X);
+  unsigned char const *y = (unsigned char *) str(Y);
+  size_t m = strLen(X), n = strLen(Y), len = 0;
+  bitRow B = { 0 };
+  initBitRow(&B, y, n, false, n);
+  advanceBitRow(&B, x, m, false, n);
+  for (size_t w = 0; w < n / 64; w++) 
+    len += 64 - __builtin_popcountll(B.row[w]);
+  for (size_t j = n / 64 * 64; j < n; j++) 
+    len += ! ((B.row[j / 64] >> (j % 64)) & 1);
+  free(B.match);
+  free(B.row);
+  return len;
+}
+
+  // The state shared by the recursive calls of Hirschberg's algorithm
+typedef struct {
+  bitRow fwd, bwd;        // bit-parallel rows in both directions
+  size_t *L1, *L2;        // LCS lengths for the two halves of X
+  size_t *table;          // DP table for the base case
+  string *lcs;            // the LCS found so far
+} hirschberg;
+
+//===================================================================
+// Appends an LCS of X[0..m-1] and Y[0..n-1] to the LCS, using the 
+// full DP table, which has at most BASE_CASE entries
+static void baseCase(hirschberg *H, unsigned char const *X, size_t m,
+                     unsigned char const *Y, size_t n) {
+  size_t *T = H->table, cols = n + 1;
+  for (size_t i = 0; i <= m; i++) 
+    for (size_t j = 0; j <= n; j++) 
+      T[i * cols + j] = i == 0 || j == 0 ? 0 
+                      : X[i - 1] == Y[j - 1] 
+                      ? T[(i - 1) * cols + j - 1] + 1 
+                      : MAX(T[(i - 1) * cols + j], T[i * cols + j - 1]);
+
+    // trace the table back from the end, and write the LCS at the 
+    // end of the string in reverse order
+  size_t len = T[m * cols + n], start = H->lcs->size;
+  for (size_t k = 0; k < len; k++) 
+    appendChar(H->lcs, 0);
+  for (size_t i = m, j = n, k = len; k > 0; ) {
+    if (T[i * cols + j] == T[(i - 1) * cols + j]) 
+      i--;
+    else if (T[i * cols + j] == T[i * cols + j - 1]) 
+      j--;
+    else {
+      H->lcs->data[start + --k] = X[i - 1];
+      i--; j--;
+    }
+  }
+}
+
+//===================================================================
+// Appends an LCS of X[0..m-1] and Y[0..n-1] to the LCS: X is split 
+// in half, and the LCS lengths of the first half of X with all 
+// prefixes of Y, and of the second half of X with all suffixes of 
+// Y, are computed in linear space; the best split of Y then divides
+// the problem into two independent subproblems
+static void divide(hirschberg *H, unsigned char const *X, size_t m,
+                   unsigned char const *Y, size_t n) {
+  if (m == 0 || n == 0) 
+    return;
+  if (m == 1) {
+      // X[0] is an LCS if it occurs in Y; this case must be handled
+      // here, as splitting X would leave the problem unchanged
+    if (memchr(Y, X[0], n)) 
+      appendChar(H->lcs, X[0]);
+    return;
+  }
+  if ((m + 1) * (n + 1) <= BASE_CASE) {
+    baseCase(H, X, m, Y, n);
+    return;
+  }
+
+  size_t mid = m / 2;
+  initBitRow(&H->fwd, Y, n, false, n);
+  advanceBitRow(&H->fwd, X, mid, false, n);
+  rowLengths(&H->fwd, n, H->L1);
+  clearBitRow(&H->fwd, Y, n, false);
+
+  initBitRow(&H->bwd, Y, n, true, n);
+  advanceBitRow(&H->bwd, X + mid, m - mid, true, n);
+  rowLengths(&H->bwd, n, H->L2);
+  clearBitRow(&H->bwd, Y, n, true);
+
+    // L1[k] is the LCS length of X[0..mid-1] and Y[0..k-1], and 
+    // L2[n-k] that of X[mid..m-1] and Y[k..n-1]
+  size_t best = 0, split = 0;
+  for (size_t k = 0; k <= n; k++) 
+    if (H->L1[k] + H->L2[n - k] >= best) {
+      best = H->L1[k] + H->L2[n - k];
+      split = k;
+    }
+  divide(H, X, mid, Y, split);
+  divide(H, X + mid, m - mid, Y + split, n - split);
+}
+
+//===================================================================
+// Returns a longest common subsequence of X and Y
+string *lcsHirschberg(string *X, string *Y) {
+  unsigned char const *x = (unsigned char *) str(X);
+  unsigned char const *y = (unsigned char *) str(Y);
+  size_t m = strLen(X), n = strLen(Y);
+  hirschberg H = { { 0 }, { 0 }, NULL, NULL, NULL, NULL };
+  H.L1 = safeCalloc(n + 1, sizeof(size_t));
+  H.L2 = safeCalloc(n + 1, sizeof(size_t));
+  H.table = safeCalloc(BASE_CASE, sizeof(size_t));
+  H.lcs = newString(MIN(m, n) + 2);
+  if (n > 0) {
+      // set up the alphabet of Y once for all subproblems
+    initBitRow(&H.fwd, y, 0, false, n);
+    initBitRow(&H.bwd, y, 0, true, n);
+  }
+  divide(&H, x, m, y, n);
+  free(H.fwd.match); free(H.fwd.row);
+  free(H.bwd.match); free(H.bwd.row);
+  free(H.L1);
+  free(H.L2);
+  free(H.table);
+  return H.lcs;
+}
@@ -0,0 +1,19 @@
+#ifndef LCS_H_INCLUDED
+#define LCS_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // Returns the length of a longest common subsequence of X and Y, 
+  // using a bit-parallel algorithm that computes 64 entries of a row 
+  // of the DP table per machine word; O(mn/64) time, O(σn/64) space
+size_t lcsLength(string *X, string *Y);
+
+  // Returns a longest common subsequence of X and Y, using 
+  // Hirschberg's divide-and-conquer algorithm with bit-parallel rows;
+  // O(mn/64) time, O(m + σn/64) space
+string *lcsHirschberg(string *X, string *Y);
+
+#endif // LCS_H_INCLUDED
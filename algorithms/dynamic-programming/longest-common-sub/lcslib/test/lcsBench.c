@@ -0,0 +1,109 @@
+/*
+  Benchmark of the LCS algorithms: the bottom-up DP of lcs-3.c 
+    with a full table, the same DP with only two rows (length 
+    only), the bit-parallel length, and Hirschberg's algorithm 
+    with bit-parallel rows, which also reconstructs an LCS
+  For each size n, two random strings of n characters over an 
+    alphabet of 4 characters are compared with each algorithm, as
+    long as it finishes in reasonable time and memory, and the 
+    lengths are compared
+  Usage: ./lcsBench.out [maxLen]
+  Author: David De Potter
+*/
+
+#include "../lcs.h"
+#include <time.h>
+
+//===================================================================
+// Returns the length of an LCS of X and Y, using the bottom-up DP
+// of lcs-3.c with a full (m+1) x (n+1) table
+size_t computeLcs(string *X, string *Y) {
+  CREATE_MATRIX(size_t, table, strLen(X) + 1, strLen(Y) + 1, 0);
+  for (size_t i = 1; i <= strLen(X); ++i) 
+    for (size_t j = 1; j <= strLen(Y); ++j) 
+      if (charAt(X, i - 1) == charAt(Y, j - 1))
+        table[i][j] = table[i - 1][j - 1] + 1; 
+      else 
+        table[i][j] = MAX(table[i - 1][j], table[i][j - 1]); 
+  size_t len = table[strLen(X)][strLen(Y)];
+  FREE_MATRIX(table, strLen(X) + 1);
+  return len;
+}
+
+//===================================================================
+// Returns the length of an LCS of X and Y, using the same DP, but
+// keeping only the previous row of the table
+size_t computeLcsRows(string *X, string *Y) {
+  size_t n = strLen(Y);
+  size_t *prev = safeCalloc(n + 1, sizeof(size_t));
+  size_t *cur = safeCalloc(n + 1, sizeof(size_t));
+  for (size_t i = 1; i <= strLen(X); ++i) {
+    for (size_t j = 1; j <= n; ++j) 
+      cur[j] = charAt(X, i - 1) == charAt(Y, j - 1) 
+               ? prev[j - 1] + 1 : MAX(prev[j], cur[j - 1]);
+    size_t *tmp = prev; prev = cur; cur = tmp;
+  }
+  size_t len = prev[n];
+  free(prev);
+  free(cur);
+  return len;
+}
+
+//===================================================================
+// Returns the length of the LCS found by Hirschberg's algorithm
+size_t hirschbergLen(string *X, string *Y) {
+  string *lcs = lcsHirschberg(X, Y);
+  size_t len = strLen(lcs);
+  freeString(lcs);
+  return len;
+}
+
+//===================================================================
+// Returns a random string of n characters over {A, C, G, T}
+string *randomString(size_t n) {
+  string *s = newString(n + 1);
+  for (size_t i = 0; i < n; i++) 
+    s->data[i] = "ACGT"[rand() % 4];
+  s->size = n;
+  return s;
+}
+
+//===================================================================
+// Runs an algorithm if enabled, shows its time, and checks its 
+// result against ref (if not 0); returns the length
+size_t bench(size_t (*lcs)(string *, string *), string *X, 
+             string *Y, bool enabled, size_t ref) {
+  if (! enabled) {
+    printf("  %10s", "-");
+    return 0;
+  }
+  clock_t start = clock();
+  size_t len = lcs(X, Y);
+  printf("  %9.4fs", (double)(clock() - start) / CLOCKS_PER_SEC);
+  if (ref && len != ref)
+    printf(" (wrong!)");
+  return len;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxLen = argc > 1 ? strtoul(argv[1], NULL, 10) : 128000;
+  srand(42);
+
+  printf("%8s  %10s  %10s  %10s  %10s  %10s\n", "n", "table", 
+         "two rows", "bits", "hirschberg", "length");
+
+  for (size_t n = 1000; n <= maxLen; n *= 2) {
+    string *X = randomString(n), *Y = randomString(n);
+    printf("%8zu", n);
+    size_t l1 = bench(computeLcs, X, Y, n <= 8000, 0);
+    size_t l2 = bench(computeLcsRows, X, Y, n <= 32000, l1);
+    size_t l3 = bench(lcsLength, X, Y, true, l1 ? l1 : l2);
+    bench(hirschbergLen, X, Y, true, l3);
+    printf("  %10zu\n", l3);
+    freeString(X);
+    freeString(Y);
+  }
+  return 0;
+}
@@ -0,0 +1,37 @@
+/* 
+  file: lis-5.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: longest increasing subsequence
+    solution in linearithmic time over a stream of values, which 
+    are not kept in memory: only the tops of the piles are, while 
+    the records needed for the reconstruction are spilled to disk
+    in chunks (see lislib/lis.c)
+  time complexity: O(n log L), where L is the length of the LIS
+  space complexity: O(L) in memory, O(n) on disk
+*/ 
+
+#include "../../../lib/clib.h"
+#include "lislib/lis.h"
+
+//===================================================================
+
+int main () {
+
+  lisStream *S = lisNewStream(LIS_SPILL);
+  reader *R = stdinReader();
+  long long x;
+  while (readerLong(R, &x))
+    lisPush(S, x);
+
+  size_t subLen;
+  int *lis = lisSequence(S, &subLen);
+
+  printf("Max length: %zu\nSubsequence:\n ", subLen);
+  PRINT_ARRAY(lis, "%d", subLen);
+
+  free(lis);
+  lisFreeStream(S);
+  return 0;
+}
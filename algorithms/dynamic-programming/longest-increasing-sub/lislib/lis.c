@@ -0,0 +1,288 @@
+/*
+  file: lis.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: longest increasing subsequence by patience sorting
+    over streams, with the records for the reconstruction kept in
+    memory or spilled to disk, over a sliding window, and split 
+    over two threads for arrays
+*/
+
+#include "lis.h"
+#include <pthread.h>
+
+  // Below this number of piles, a plain binary search is faster: 
+  // its branches are cheap on so few piles, while each step of the
+  // branchless search waits for the load of the previous one
+#define SHORT_PILES 64
+
+//===================================================================
+// Returns the number of values in the sorted array a[0..n-1] that
+// are at most x; on more than SHORT_PILES values, the loop has no
+// data-dependent branches, as the comparison only selects the next
+// base
+static inline size_t upperBound(int const *a, size_t n, int x) {
+  if (n <= SHORT_PILES) {
+    size_t low = 0, high = n;
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (a[mid] <= x) low = mid + 1;
+      else high = mid;
+    }
+    return low;
+  }
+  int const *base = a;
+  while (n > 1) {
+    size_t half = n / 2;
+    base = base[half] <= x ? base + half : base;
+    n -= half;
+  }
+  return (base - a) + (*base <= x);
+}
+
+//===================================================================
+// Puts x on the leftmost pile whose top value is larger than x, or
+// on a new pile, and returns the index of that pile
+static inline size_t pushTail(int *tails, size_t *len, int x) {
+  size_t k = *len && tails[*len - 1] > x ? upperBound(tails, *len, x)
+                                         : (*len)++;
+  tails[k] = x;
+  return k;
+}
+
+//===================================================================
+// Creates a new stream in the given mode
+lisStream *lisNewStream(lisMode mode) {
+  lisStream *S = safeCalloc(1, sizeof(lisStream));
+  S->mode = mode;
+  S->cap = 64;
+  S->tails = safeCalloc(S->cap, sizeof(int));
+  if (mode == LIS_LENGTH)
+    return S;
+  S->recCap = mode == LIS_SPILL ? LIS_CHUNK : 64;
+  S->recs = safeCalloc(S->recCap, sizeof(lisRecord));
+  if (mode == LIS_SPILL && ! (S->spill = tmpfile())) {
+    fprintf(stderr, "Could not create a spill file\n");
+    exit(EXIT_FAILURE);
+  }
+  return S;
+}
+
+//===================================================================
+// Deallocates the stream and removes its spill file
+void lisFreeStream(lisStream *S) {
+  if (S->spill)
+    fclose(S->spill);
+  free(S->recs);
+  free(S->tails);
+  free(S);
+}
+
+//===================================================================
+// Adds the next value to the stream
+void lisPush(lisStream *S, int x) {
+  if (S->len == S->cap) {
+    S->cap *= 2;
+    S->tails = safeRealloc(S->tails, S->cap * sizeof(int));
+  }
+  size_t k = pushTail(S->tails, &S->len, x);
+  S->count++;
+  if (S->mode == LIS_LENGTH)
+    return;
+
+  if (k > UINT32_MAX) {
+    fprintf(stderr, "Too many piles to keep records\n");
+    exit(EXIT_FAILURE);
+  }
+  if (S->nRecs == S->recCap) {
+    if (S->mode == LIS_SPILL) {
+      if (fwrite(S->recs, sizeof(lisRecord), S->nRecs, S->spill)
+          != S->nRecs) {
+        fprintf(stderr, "Could not write to the spill file\n");
+        exit(EXIT_FAILURE);
+      }
+      S->nRecs = 0;
+    } else {
+      S->recCap *= 2;
+      S->recs = safeRealloc(S->recs, S->recCap * sizeof(lisRecord));
+    }
+  }
+  S->recs[S->nRecs++] = (lisRecord) { x, k };
+}
+
+//===================================================================
+// Scans the records backwards and fills in seq[k - 1] with the 
+// first value on pile k - 1, after which k is decreased
+static void scanRecords(lisRecord *recs, size_t n, int *seq,
+                        size_t *k) {
+  for (size_t i = n; i-- && *k; )
+    if (recs[i].pile == *k - 1)
+      seq[--*k] = recs[i].value;
+}
+
+//===================================================================
+// Returns an LIS of the values pushed so far
+int *lisSequence(lisStream *S, size_t *len) {
+  if (S->mode == LIS_LENGTH) {
+    fprintf(stderr, "The stream keeps no records\n");
+    exit(EXIT_FAILURE);
+  }
+
+  int *seq = safeCalloc(S->len + 1, sizeof(int));
+  size_t k = *len = S->len;
+  scanRecords(S->recs, S->nRecs, seq, &k);
+
+    // the spilled chunks are all full, and are read back from the 
+    // last one to the first, while the file position is restored
+    // afterwards for the next chunks
+  if (S->spill && k) {
+    lisRecord *chunk = safeCalloc(LIS_CHUNK, sizeof(lisRecord));
+    size_t chunks = (S->count - S->nRecs) / LIS_CHUNK;
+    while (chunks-- && k) {
+      if (fseek(S->spill, (long)(chunks * LIS_CHUNK 
+                                 * sizeof(lisRecord)), SEEK_SET)
+          || fread(chunk, sizeof(lisRecord), LIS_CHUNK, S->spill)
+             != LIS_CHUNK) {
+        fprintf(stderr, "Could not read the spill file\n");
+        exit(EXIT_FAILURE);
+      }
+      scanRecords(chunk, LIS_CHUNK, seq, &k);
+    }
+    fseek(S->spill, 0, SEEK_END);
+    free(chunk);
+  }
+  return seq;
+}
+
+  // The end of a pile, as a position that follows all others
+#define NONE SIZE_MAX
+
+  // The piles of a sliding window of w values of arr: each pile is
+  // a linked list of the positions of its values in increasing 
+  // order, where the values themselves decrease; next is indexed by
+  // the position modulo w, as a window holds w positions
+typedef struct {
+  int *arr;
+  size_t w, len;
+  size_t *next, *head, *tail;
+  int *tails;
+} window;
+
+//===================================================================
+// Removes the first value of the window at position s, which is 
+// the first value on pile 0. The values that lose their longest
+// subsequence ending at them move down one pile. On each pile, 
+// these are the values that precede the first remaining value of
+// the pile below it, so that they form a prefix of the pile, which
+// is put in front of the remaining values of the pile below. The 
+// piles above the first pile without such a prefix stay the same
+static void popFirst(window *W, size_t s) {
+  size_t *next = W->next, w = W->w, k;
+  size_t surv = next[s % w];
+  for (k = 1; k < W->len; k++) {
+    size_t i = W->head[k], last = NONE;
+    while (i < surv) {
+      last = i;
+      i = next[i % w];
+    }
+    if (last == NONE)
+      break;
+    next[last % w] = surv;
+    if (surv == NONE) {
+      W->tail[k - 1] = last;
+      W->tails[k - 1] = W->arr[last];
+    }
+    W->head[k - 1] = W->head[k];
+    surv = i;
+  }
+  W->head[k - 1] = surv;
+  if (surv == NONE)
+    W->len--;
+}
+
+//===================================================================
+// Adds the value at position e to the window
+static void pushLast(window *W, size_t e) {
+  size_t len = W->len;
+  size_t k = pushTail(W->tails, &W->len, W->arr[e]);
+  W->next[e % W->w] = NONE;
+  if (k == len)
+    W->head[k] = e;
+  else 
+    W->next[W->tail[k] % W->w] = e;
+  W->tail[k] = e;
+}
+
+//===================================================================
+// Stores the length of an LIS of each window of w values in out
+void lisSlidingWindow(int *arr, size_t n, size_t w, size_t *out) {
+  if (w == 0 || w > n)
+    return;
+  window W = { arr, w, 0, safeCalloc(w, sizeof(size_t)),
+               safeCalloc(w, sizeof(size_t)), 
+               safeCalloc(w, sizeof(size_t)),
+               safeCalloc(w, sizeof(int)) };
+  for (size_t e = 0; e < n; e++) {
+    if (e >= w)
+      popFirst(&W, e - w);
+    pushLast(&W, e);
+    if (e + 1 >= w)
+      out[e + 1 - w] = W.len;
+  }
+  free(W.next);
+  free(W.head);
+  free(W.tail);
+  free(W.tails);
+}
+
+  // The input and piles of a half of the array; the values of a
+  // reversed half are complemented, since ~x reverses the order of 
+  // the values without overflow
+typedef struct {
+  int *arr;
+  size_t n;
+  bool reversed;
+  int *tails;
+  size_t len;
+} half;
+
+//===================================================================
+// Puts the values of a half on piles
+static void *fillHalf(void *arg) {
+  half *H = arg;
+  for (size_t i = 0; i < H->n; i++)
+    pushTail(H->tails, &H->len, H->reversed ? ~H->arr[H->n - 1 - i]
+                                            : H->arr[i]);
+  return NULL;
+}
+
+//===================================================================
+// Returns the length of an LIS of arr
+size_t lisParallelLength(int *arr, size_t n, bool threaded) {
+  half A = { arr, n / 2, false, safeCalloc(n / 2 + 1, sizeof(int)) };
+  half B = { arr + n / 2, n - n / 2, true,
+             safeCalloc(n - n / 2 + 1, sizeof(int)) };
+
+  pthread_t thread;
+  bool spawned = threaded &&
+                 ! pthread_create(&thread, NULL, fillHalf, &B);
+  fillHalf(&A);
+  if (spawned)
+    pthread_join(thread, NULL);
+  else
+    fillHalf(&B);
+
+    // an LIS consists of a subsequence of A with values at most v
+    // and one of B with values at least v, for some value v; the 
+    // first A.tails[k] gives the former k + 1 values, while the 
+    // piles of B with a top value ~h ≤ ~v, i.e. h ≥ v, give the 
+    // latter
+  size_t best = B.len;
+  for (size_t k = 0; k < A.len; k++)
+    best = MAX(best, k + 1 + upperBound(B.tails, B.len, ~A.tails[k]));
+
+  free(A.tails);
+  free(B.tails);
+  return best;
+}
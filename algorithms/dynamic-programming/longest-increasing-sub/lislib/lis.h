@@ -0,0 +1,76 @@
+#ifndef LIS_H_INCLUDED
+#define LIS_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // Subsequences are non-decreasing, as in lis-1.c up to lis-4.c
+
+  // The number of records of a stream that are kept in memory in
+  // spill mode; full chunks are written to a temporary file
+#define LIS_CHUNK (1 << 16)
+
+  // What a stream keeps of its values: nothing, so that only the
+  // length is known, or a record per value for the reconstruction,
+  // either in memory or in chunks on disk
+typedef enum { LIS_LENGTH, LIS_MEMORY, LIS_SPILL } lisMode;
+
+  // A value of a stream and the pile it was put on
+typedef struct {
+  int value;
+  uint32_t pile;
+} lisRecord;
+
+  // The patience sorting state of a stream of values
+typedef struct {
+  lisMode mode;
+  int *tails;             // the smallest top value of each pile
+  size_t len, cap;        // number of piles, capacity of tails
+  size_t count;           // number of values pushed so far
+  lisRecord *recs;        // the records that are still in memory
+  size_t nRecs, recCap;   // their number and capacity
+  FILE *spill;            // the spilled chunks in LIS_SPILL mode
+} lisStream;
+
+  // Creates a new stream in the given mode
+lisStream *lisNewStream(lisMode mode);
+
+  // Deallocates the stream and removes its spill file
+void lisFreeStream(lisStream *S);
+
+  // Adds the next value to the stream: the pile of x is found by a
+  // branchless binary search over the top values of the piles, 
+  // which are stored inline; O(log L) time for an LIS of length L
+void lisPush(lisStream *S, int x);
+
+  // Returns the length of an LIS of the values pushed so far
+static inline size_t lisLength(lisStream *S) {
+  return S->len;
+}
+
+  // Returns an LIS of the values pushed so far, and stores its 
+  // length in *len; the records are scanned backwards, where the
+  // predecessor of a value on pile k is the last value put on pile
+  // k - 1 before it, so that a spilled stream is read back one 
+  // chunk at a time; O(n) time
+int *lisSequence(lisStream *S, size_t *len);
+
+  // Stores the length of an LIS of each window arr[s..s+w-1] in 
+  // out[s], for s = 0..n-w; the piles are updated as the window 
+  // slides, where removing the first value moves each value down at
+  // most one pile, so that it takes O(n log w + nL) time for a 
+  // largest window LIS of length L, and O(w) space
+void lisSlidingWindow(int *arr, size_t n, size_t w, size_t *out);
+
+  // Returns the length of an LIS of arr, splitting the array in two
+  // halves that are processed on two threads if threaded is true: 
+  // the piles of the first half and those of the reversed second 
+  // half give the longest subsequences below and above any value, 
+  // which are combined at the best value. The piles do not suffice
+  // to combine more than two parts, hence the two threads; 
+  // O(n log n) time, O(n) space
+size_t lisParallelLength(int *arr, size_t n, bool threaded);
+
+#endif // LIS_H_INCLUDED
@@ -0,0 +1,155 @@
+/*
+  Benchmark of the LIS algorithms: computeLis of lis-4.c, which
+    keeps the whole array, the pile indices and a parent per value,
+    against a stream that only keeps the length, a stream that 
+    keeps its records in memory or spills them to disk for the 
+    reconstruction, and the length split over two halves on one or
+    two threads; the sliding window is compared against computeLis
+    on each window
+  For each size n, an array of n random values is used, and the 
+    lengths are compared. The memory column shows the bytes that
+    each algorithm keeps in memory besides the input, where lis-4.c
+    also needs the array itself
+  Usage: ./lisBench.out [maxN]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include "../lis.h"
+#include <time.h>
+
+  // the size of the windows
+#define WINDOW 1000
+
+//===================================================================
+// Returns the length of an LIS of arr, using computeLis of lis-4.c
+// with a table of piles and a parent per value
+size_t computeLis (int *arr, size_t len, size_t *table, 
+                   size_t *parents) {
+  
+  size_t subLen = 0;
+  for (size_t i = 0; i < len; i++) {
+    size_t low = 1, high = subLen;
+    while (low <= high) {
+      size_t mid = low + (1 + high - low) / 2;
+      if (arr[i] >= arr[table[mid]]) low = mid + 1;
+      else high = mid - 1;
+    }
+    table[low] = i;
+    parents[i] = table[low - 1];
+    if (low > subLen) subLen = low;
+  }
+  return subLen;
+}
+
+//===================================================================
+// Returns the time in seconds since start, measured on the wall
+// clock, since the threads share the processor time
+double elapsed(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) +
+         (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+//===================================================================
+// Shows a row of the table: the name of an algorithm, its time,
+// its memory in KB, and its result, compared against ref
+void showRow(char const *name, double time, size_t bytes,
+             size_t result, size_t ref) {
+  printf("  %-14s  %9.4fs  %12zu  %10zu%s\n", name, time,
+         bytes / 1024, result, result != ref ? " (wrong!)" : "");
+}
+
+//===================================================================
+// Pushes the values of arr on a stream in the given mode, shows 
+// the time and memory, and returns the length of the LIS; in the
+// modes with records, the LIS is also reconstructed
+size_t benchStream(char const *name, lisMode mode, int *arr, 
+                   size_t n, size_t ref) {
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  lisStream *S = lisNewStream(mode);
+  for (size_t i = 0; i < n; i++)
+    lisPush(S, arr[i]);
+  size_t len = lisLength(S);
+  if (mode != LIS_LENGTH)
+    free(lisSequence(S, &len));
+  double time = elapsed(&start);
+  showRow(name, time, S->cap * sizeof(int) + S->recCap * 
+          sizeof(lisRecord), len, ref);
+  lisFreeStream(S);
+  return len;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxN = argc > 1 ? strtoul(argv[1], NULL, 10) : 1 << 24;
+  srand(42);
+
+  for (size_t n = 1 << 16; n <= maxN; n *= 4) {
+    int *arr = safeCalloc(n, sizeof(int));
+    for (size_t i = 0; i < n; i++)
+      arr[i] = rand();
+
+    printf("n = %zu\n", n);
+    printf("  %-14s  %10s  %12s  %10s\n", "algorithm", "time",
+           "memory (KB)", "length");
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    size_t *table = safeCalloc(n + 1, sizeof(size_t));
+    size_t *parents = safeCalloc(n, sizeof(size_t));
+    size_t ref = computeLis(arr, n, table, parents);
+    showRow("lis-4", elapsed(&start), (2 * n + 1) * sizeof(size_t),
+            ref, ref);
+    free(table);
+    free(parents);
+
+    benchStream("stream", LIS_LENGTH, arr, n, ref);
+    benchStream("stream memory", LIS_MEMORY, arr, n, ref);
+    benchStream("stream spill", LIS_SPILL, arr, n, ref);
+
+    for (int threaded = 0; threaded <= 1; threaded++) {
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      size_t len = lisParallelLength(arr, n, threaded);
+      showRow(threaded ? "halves 2 thr" : "halves", elapsed(&start),
+              (n + 2) * sizeof(int), len, ref);
+    }
+    printf("\n");
+    free(arr);
+  }
+
+    // the windows of WINDOW values of an array of 2^16 values
+  size_t n = 1 << 16, nWin = n - WINDOW + 1;
+  int *arr = safeCalloc(n, sizeof(int));
+  for (size_t i = 0; i < n; i++)
+    arr[i] = rand();
+  size_t *out = safeCalloc(nWin, sizeof(size_t));
+  size_t *table = safeCalloc(WINDOW + 1, sizeof(size_t));
+  size_t *parents = safeCalloc(WINDOW, sizeof(size_t));
+
+  printf("windows of %d values, n = %zu\n", WINDOW, n);
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  size_t sum = 0;
+  for (size_t s = 0; s < nWin; s++)
+    sum += computeLis(arr + s, WINDOW, table, parents);
+  showRow("lis-4", elapsed(&start), (2 * WINDOW + 1) * 
+          sizeof(size_t), sum, sum);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  lisSlidingWindow(arr, n, WINDOW, out);
+  size_t winSum = 0;
+  for (size_t s = 0; s < nWin; s++)
+    winSum += out[s];
+  showRow("sliding", elapsed(&start), WINDOW * (3 * sizeof(size_t)
+          + sizeof(int)), winSum, sum);
+
+  free(arr);
+  free(out);
+  free(table);
+  free(parents);
+  return 0;
+}
@@ -1,56 +1,88 @@
-/* 
+/*
   file: lps-3.c
   author: David De Potter
   email: pl3onasm@gmail.com
   license: MIT, see LICENSE file in repository root folder
   description: longest palindromic subsequence
-    bottom-up dynamic programming implementation
-  time complexity: O(n^2)
-*/ 
+    bottom-up dynamic programming implementation, where the table
+    is filled in anti-diagonal wavefront order by a pool of
+    threads, one tile at a time (see ../wflib/wf.c)
+  time complexity: O(n^2), or O(n^2/p) on p processors
+*/
 
 #include "../../../lib/clib.h"
+#include "../wflib/wf.h"
+
+  // The string and the memo table, where memo(j, k) is the length
+  // of an LPS of X[j..k]; the table is stored row by row in a
+  // single contiguous block, with an extra row j = n and an extra
+  // column k = -1 of zeros for the empty substrings at the borders
+typedef struct {
+  string *X;
+  size_t *memo, cols;
+} lpsTable;
 
 //===================================================================
-// Returns the length of the longest palindromic subsequence of X
-size_t computeLps(string *X, size_t start, size_t end, 
-                  size_t **memo) {
-    
-    // base case: any single character is a palindrome
-  for (size_t i = 0; i < strLen(X); ++i)
-    memo[i][i] = 1;
-
-    // bottom-up approach: fill the memo table by increasing
-    // the length of the subsequences
-  for (size_t i = 1; i < strLen(X); ++i)
-      // i is the length of the current subsequence
-    for (size_t j = 0; j < strLen(X) - i; ++j) {
-        // k is the end index of the current subsequence X[j..k]
-      size_t k = j + i;
+// Returns the index of memo(j, k) in the table
+static inline size_t at(lpsTable *L, size_t j, size_t k) {
+  return j * L->cols + k + 1;
+}
+
+//===================================================================
+// Fills the entries memo(j, k) for j = n - 1 - r with r in [r0, r1)
+// and k in [c0, c1): memo(j, k) depends on memo(j + 1, k - 1),
+// memo(j + 1, k) and memo(j, k - 1), which lie above and to the
+// left of it when the rows are taken in reverse order
+void lpsKernel(size_t r0, size_t r1, size_t c0, size_t c1,
+               void *arg) {
+
+  lpsTable *L = arg;
+  string *X = L->X;
+  size_t *memo = L->memo;
+
+  for (size_t r = r0; r < r1; ++r) {
+    size_t j = strLen(X) - 1 - r;
+
+      // the entries with k < j stay 0, and any single character
+      // is a palindrome
+    if (c0 <= j && j < c1)
+      memo[at(L, j, j)] = 1;
+
+      // X[j..k] is a subsequence of length k - j + 1
+    for (size_t k = MAX(c0, j + 1); k < c1; ++k) {
       if (charAt(X, j) == charAt(X, k))
-        memo[j][k] = 2 + memo[j + 1][k - 1];
+        memo[at(L, j, k)] = 2 + memo[at(L, j + 1, k - 1)];
       else
-        memo[j][k] = MAX(memo[j + 1][k], memo[j][k - 1]);
+        memo[at(L, j, k)] = MAX(memo[at(L, j + 1, k)],
+                                memo[at(L, j, k - 1)]);
     }
+  }
+}
 
-  return memo[start][end];
+//===================================================================
+// Returns the length of the longest palindromic subsequence of X
+size_t computeLps(lpsTable *L, size_t start, size_t end) {
+  wfRun(strLen(L->X), strLen(L->X), WF_TILE, lpsKernel, L,
+        wfProcessors());
+  return L->memo[at(L, start, end)];
 }
 
 //===================================================================
 // Reconstructs an LPS of X
-void reconstructLps(string *X, size_t row, size_t col, 
-                    size_t **memo, size_t lps) {
+void reconstructLps(lpsTable *L, size_t row, size_t col,
+                    size_t lps) {
 
   string *lpsStr = newString(lps + 1);
-  size_t start = 0, end = lps - 1;
+  size_t start = 0, end = lps - 1, *memo = L->memo;
 
-  while (memo[row][col]) {
-    if (memo[row][col] == memo[row + 1][col]) 
+  while (memo[at(L, row, col)]) {
+    if (memo[at(L, row, col)] == memo[at(L, row + 1, col)])
       ++row;
-    else if (memo[row][col] == memo[row][col - 1]) 
+    else if (memo[at(L, row, col)] == memo[at(L, row, col - 1)])
       --col;
     else {
-      setCharAt(lpsStr, start++, charAt(X, col));
-      setCharAt(lpsStr, end--, charAt(X, col));
+      setCharAt(lpsStr, start++, charAt(L->X, col));
+      setCharAt(lpsStr, end--, charAt(L->X, col));
       ++row; --col;
     }
   }
@@ -62,19 +94,19 @@ void reconstructLps(string *X, size_t row, size_t col,
 //===================================================================
 
 int main () {
-  
-  READ_STRING(X, '\n'); 
 
-  CREATE_MATRIX(size_t, memo, strLen(X), strLen(X), 0);
+  READ_STRING(X, '\n');
+
+  lpsTable L = { X, NULL, strLen(X) + 1 };
+  L.memo = safeCalloc((strLen(X) + 1) * L.cols, sizeof(size_t));
 
-  size_t lps = computeLps(X, 0, strLen(X) - 1, memo);
+  size_t lps = computeLps(&L, 0, strLen(X) - 1);
 
   printf("LPS length: %zu\nLPS: ", lps);
-  reconstructLps(X, 0, strLen(X) - 1, memo, lps);
+  reconstructLps(&L, 0, strLen(X) - 1, lps);
 
-  FREE_MATRIX(memo, strLen(X));
+  free(L.memo);
   freeString(X);
-  
+
   return 0;
 }
-
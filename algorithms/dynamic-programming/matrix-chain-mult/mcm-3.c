@@ -10,35 +10,56 @@
     A₂ = dims[1] x dims[2], ..., Aₙ = dims[n-1] x dims[n].
     The output is the minimal cost of the matrix chain product
     A₁ * ... * Aₙ and an optimal parenthesization.
+    Both tables only hold the chains Aᵢ..Aⱼ with i ≤ j, stored row
+    by row in a single contiguous upper-triangular block, which
+    is filled from the bottom row up.
   Time complexity: O(n³)
 */
 
 #include "../../../lib/clib.h"
 
+  // The tables of the minimum costs and the optimal split points of
+  // the chains Aᵢ..Aⱼ with 1 ≤ i ≤ j ≤ n, where row i holds the 
+  // n - i + 1 entries for j = i..n
+typedef struct {
+  size_t n;
+  size_t *minCosts, *splitPoints;
+} mcmTables;
+
+//===================================================================
+// Returns the index of the entry for the chain Aᵢ..Aⱼ in the tables
+static inline size_t at(mcmTables *T, size_t i, size_t j) {
+  return (i - 1) * (2 * T->n + 2 - i) / 2 + j - i;
+}
+
 //===================================================================
 // Computes the minimum costs and optimal split points for all
-// subproblems in bottom-up fashion
-void computeMinCost (size_t *dims, size_t **minCosts, 
-                     size_t **splitPoints, size_t len) {
+// subproblems in bottom-up fashion: the rows are filled from the
+// last one up, so that the rows below row i are complete when row i
+// is filled. For a fixed split point k, the chains Aᵢ..Aⱼ with
+// j > k are all updated at once: the cost of Aᵢ..Aₖ is final by
+// then, and the costs of Aₖ₊₁..Aⱼ are read from row k + 1, so that
+// both rows are walked in order
+void computeMinCost (size_t *dims, mcmTables *T, size_t len) {
   
-    // base case: the cost of multiplying a single matrix is 0
-  for (size_t i = 0; i < len; i++)
-    minCosts[i][i] = 0;
+  for (size_t i = len - 1; i >= 1; i--) {
+    size_t *costs = T->minCosts + at(T, i, i);
+    size_t *splits = T->splitPoints + at(T, i, i);
+
+      // base case: the cost of multiplying a single matrix is 0
+    costs[0] = 0;
 
-    // fill the table in order of increasing chain length l
-  for (size_t l = 2; l <= len; l++) { 
-    for (size_t i = 1; i < len - l + 1; i++) {   
-        // chain starts at i and ends at j
-      size_t j = i + l - 1;                    
-        // try all possible split points k and choose
-        // the one that yields the minimum cost          
-      for (size_t k = i; k < j; k++) { 
-        size_t cost = minCosts[i][k] + minCosts[k + 1][j]  
-                    + dims[i-1] * dims[k] * dims[j];
+      // try all possible split points k in increasing order, so that
+      // the first one that yields the minimum cost is kept
+    for (size_t k = i; k < len - 1; k++) {
+      size_t *next = T->minCosts + at(T, k + 1, k + 1);
+      size_t left = costs[k - i], outer = dims[i-1] * dims[k];
+      for (size_t j = k + 1; j < len; j++) {
+        size_t cost = left + next[j - k - 1] + outer * dims[j];
           // update the minimum cost and split point
-        if (cost < minCosts[i][j]) { 
-          minCosts[i][j] = cost;
-          splitPoints[i][j] = k;
+        if (cost < costs[j - i]) {
+          costs[j - i] = cost;
+          splits[j - i] = k;
         }
       }
     }
@@ -48,14 +69,15 @@ void computeMinCost (size_t *dims, size_t **minCosts,
 //===================================================================
 // Prints the optimal parenthesization of the matrix chain
 // starting at i and ending at j
-void printOptimalParens (size_t **splitPoints, size_t i, size_t j) {
+void printOptimalParens (mcmTables *T, size_t i, size_t j) {
   if (i == j) {
     printf("A%zu", i);
   } else {
+    size_t k = T->splitPoints[at(T, i, j)];
     printf("(");
-    printOptimalParens(splitPoints, i, splitPoints[i][j]);
+    printOptimalParens(T, i, k);
     printf(" x ");
-    printOptimalParens(splitPoints, splitPoints[i][j] + 1, j);
+    printOptimalParens(T, k + 1, j);
     printf(")");
   }
 }
@@ -68,19 +90,23 @@ int main () {
 
     // create a table for memoization of subproblems
     // and a table for storing the optimal split points
-  CREATE_MATRIX(size_t, minCosts, len, len, SIZE_MAX);
-  CREATE_MATRIX(size_t, splitPoints, len, len, 0);
+  mcmTables T = { len - 1 };
+  size_t size = (len - 1) * len / 2;
+  T.minCosts = safeCalloc(size, sizeof(size_t));
+  T.splitPoints = safeCalloc(size, sizeof(size_t));
+  for (size_t e = 0; e < size; e++)
+    T.minCosts[e] = SIZE_MAX;
 
-  computeMinCost(dims, minCosts, splitPoints, len);
+  computeMinCost(dims, &T, len);
 
-  printf("Min cost: %zu\n\n", minCosts[1][len - 1]);
+  printf("Min cost: %zu\n\n", T.minCosts[at(&T, 1, len - 1)]);
 
   printf("An optimal parenthesization:\n");
-  printOptimalParens(splitPoints, 1, len - 1);
+  printOptimalParens(&T, 1, len - 1);
   printf("\n");
 
-  FREE_MATRIX(minCosts, len);
-  FREE_MATRIX(splitPoints, len);
+  free(T.minCosts);
+  free(T.splitPoints);
   free(dims);
 
   return 0;
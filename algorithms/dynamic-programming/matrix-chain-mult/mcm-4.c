@@ -0,0 +1,59 @@
+/* 
+  file: mcm-4.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description:
+    Matrix chain multiplication using the algorithm of Hu and 
+    Shing, which finds an optimal triangulation of a polygon 
+    instead of filling a table (see mcmlib/mcm.c)
+    The input is stored in an array holding the dimensions of
+    the matrices A₁, ..., Aₙ as follows: A₁ = dims[0] x dims[1],
+    A₂ = dims[1] x dims[2], ..., Aₙ = dims[n-1] x dims[n].
+    The output is the minimal cost of the matrix chain product
+    A₁ * ... * Aₙ and an optimal parenthesization.
+  Time complexity: O(n log n)
+*/
+
+#include "../../../lib/clib.h"
+#include "mcmlib/mcm.h"
+
+//===================================================================
+// Prints the optimal parenthesization of the matrix chain
+// starting at i and ending at j, whose split point is k
+void printOptimalParens (mcmOrder *O, size_t k, size_t i, size_t j) {
+  if (i == j) {
+    printf("A%zu", i);
+  } else {
+    printf("(");
+    printOptimalParens(O, O->left[k], i, k);
+    printf(" x ");
+    printOptimalParens(O, O->right[k], k + 1, j);
+    printf(")");
+  }
+}
+
+//===================================================================
+
+int main () {
+    // read the matrix dimensions
+  READ(size_t, dims, "%zu", len);
+  if (len < 2) {
+    fprintf(stderr, "At least one matrix is required\n");
+    free(dims);
+    return EXIT_FAILURE;
+  }
+
+  mcmOrder *O = mcmHuShing(dims, len - 1);
+
+  printf("Min cost: %zu\n\n", O->cost);
+
+  printf("An optimal parenthesization:\n");
+  printOptimalParens(O, O->root, 1, len - 1);
+  printf("\n");
+
+  mcmFreeOrder(O);
+  free(dims);
+
+  return 0;
+}
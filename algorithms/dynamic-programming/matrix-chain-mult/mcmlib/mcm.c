@@ -0,0 +1,324 @@
+/*
+  file: mcm.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: matrix chain ordering in O(n log n) time by the
+    algorithm of Hu and Shing, which finds an optimal triangulation
+    of the polygon whose vertices are weighted by the dimensions
+*/
+
+#include "mcm.h"
+
+  // The products of two costs are compared exactly
+__extension__ typedef unsigned __int128 u128;
+
+  // A candidate diagonal (an arc) between the positions a and b of
+  // the polygon, where all vertices strictly between a and b are
+  // heavier than both end points. The region of an arc is the part
+  // of the polygon below it and above the arcs below it that are
+  // kept (its border arcs); it is fanned out from its lightest end
+  // point. Removing the arc adds the weight P - a·b of its other 
+  // sides to the fan of the region above it, and saves its own fan,
+  // so that the arc is kept above a region with lightest vertex x 
+  // as long as x exceeds its supporting weight fan / (P - a·b).
+  // A border arc with a supporting weight at least that of the arc
+  // is removed whenever the arc is, and kept whenever the arc is, 
+  // so that both are merged into a group with the sums of their 
+  // numerators and denominators as its supporting weight
+typedef struct {
+  size_t a, b;            // the positions of the end points
+  size_t P;               // the total weight of the other sides
+  size_t first, last;     // the weights of the sides at a and at b
+  size_t fan;             // the cost of the fan of its region
+  size_t below;           // the cost of the regions below it
+  size_t num, den;        // the supporting weight of its group
+  size_t heap;            // a max-heap of the border arcs
+  size_t left, right;     // the children of the arc in its heap
+  size_t rank;            // the length of its rightmost heap path
+  size_t next, tail;      // the next and the last arc of its group
+  bool removed;           // whether the arc is removed
+} arc;
+
+  // The polygon of n + 1 vertices, cut open at its lightest vertex,
+  // which appears at both ends as positions 0 and n + 1; the weight
+  // of a side is the product of the weights of its end points, and
+  // arc 0 is the empty arc
+typedef struct {
+  size_t n;
+  size_t *w;              // the weight of each position
+  size_t *vertex;         // the index in dims of each position
+  size_t *pre;            // pre[t]: total weight of the sides < t
+  arc *arcs;
+  size_t nArcs;
+} polygon;
+
+//===================================================================
+// Returns true if position s is lighter than position t; equal 
+// weights are ordered by their index in dims
+static inline bool lighter(polygon *G, size_t s, size_t t) {
+  return G->w[s] < G->w[t] || (G->w[s] == G->w[t] &&
+                               G->vertex[s] < G->vertex[t]);
+}
+
+//===================================================================
+// Returns the weight of the side or arc between positions s and t
+static inline size_t sideWeight(polygon *G, size_t s, size_t t) {
+  return G->w[s] * G->w[t];
+}
+
+//===================================================================
+// Returns true if the group of arc c should be kept above a region
+// whose lightest vertex has weight x
+static inline bool keeps(arc *c, size_t x) {
+  return (u128)c->num < (u128)x * c->den;
+}
+
+//===================================================================
+// Returns true if the group of arc c has a supporting weight of at
+// least that of the group of arc d
+static inline bool heavier(arc *c, arc *d) {
+  return (u128)c->num * d->den >= (u128)d->num * c->den;
+}
+
+//===================================================================
+// Merges the leftist heaps with roots x and y, ordered by decreasing
+// supporting weight, and returns the root of the result
+static size_t merge(polygon *G, size_t x, size_t y) {
+  if (! x || ! y)
+    return x + y;
+  arc *A = G->arcs;
+  if (! heavier(A + x, A + y)) {
+    size_t tmp = x; x = y; y = tmp;
+  }
+  A[x].right = merge(G, A[x].right, y);
+  if (A[A[x].left].rank < A[A[x].right].rank) {
+    size_t tmp = A[x].left;
+    A[x].left = A[x].right;
+    A[x].right = tmp;
+  }
+  A[x].rank = A[A[x].right].rank + 1;
+  return x;
+}
+
+//===================================================================
+// Computes the region of arc h from the border arcs below it on the
+// stack of pending arcs: the border arcs with a supporting weight of
+// at least the weight of the lightest vertex of the region are 
+// removed, so that their regions join this one, after which the 
+// fan of the region and the supporting weight of h are known; the 
+// arc from position 0 to n + 1 is the whole polygon
+static void computeRegion(polygon *G, size_t h, size_t *pending,
+                          size_t *nPending) {
+
+  arc *A = G->arcs, *H = A + h;
+  size_t a = H->a, b = H->b;
+  H->P = G->pre[b] - G->pre[a];
+  H->first = sideWeight(G, a, a + 1);
+  H->last = sideWeight(G, b - 1, b);
+
+    // the arcs below h are its border arcs at first
+  while (*nPending && A[pending[*nPending - 1]].a >= a) {
+    arc *C = A + pending[--*nPending];
+    size_t w = sideWeight(G, C->a, C->b);
+    H->P += w - (G->pre[C->b] - G->pre[C->a]);
+    if (C->a == a) H->first = w;
+    if (C->b == b) H->last = w;
+    H->below += C->fan + C->below;
+    C->left = C->right = 0;
+    C->rank = 1;
+    H->heap = merge(G, H->heap, C - A);
+  }
+
+  bool root = a == 0 && b == G->n + 1;
+  size_t m = root || lighter(G, a, b) ? a : b;
+  while (H->heap && ! keeps(A + H->heap, G->w[m])) {
+    arc *C = A + H->heap;
+    H->heap = merge(G, C->left, C->right);
+    H->P += C->den;
+    if (C->a == a) H->first = C->first;
+    if (C->b == b) H->last = C->last;
+    H->below -= C->num;
+    H->heap = merge(G, H->heap, C->heap);
+    for (size_t c = C - A; c; c = A[c].next)
+      A[c].removed = true;
+  }
+
+    // the sides at the lightest vertex do not take part in the fan
+  size_t other = root ? H->first + H->last 
+                      : m == a ? H->first : H->last;
+  H->num = H->fan = G->w[m] * (H->P - other);
+  H->den = H->P - sideWeight(G, a, b);
+  H->tail = h;
+
+    // border groups that are at least as heavy join the group of h
+  while (! root && H->heap && heavier(A + H->heap, H)) {
+    arc *C = A + H->heap;
+    H->heap = merge(G, C->left, C->right);
+    H->num += C->num;
+    H->den += C->den;
+    if (C->a == a) H->first = C->first;
+    if (C->b == b) H->last = C->last;
+    H->heap = merge(G, H->heap, C->heap);
+    A[H->tail].next = C - A;
+    H->tail = C->tail;
+  }
+}
+
+//===================================================================
+// Finds all arcs in one sweep over the positions, using a stack of
+// positions with increasing weights: when position t is reached, 
+// each position that is heavier than t forms an arc with t, and so
+// does the heaviest position that is lighter than t; the arcs are 
+// found from the inside out, so that each region can be computed
+// as soon as its arc is found
+static void sweep(polygon *G) {
+  size_t *stack = safeCalloc(G->n + 2, sizeof(size_t));
+  size_t *pending = safeCalloc(G->n + 2, sizeof(size_t));
+  size_t top = 0, nPending = 0;
+
+  for (size_t t = 1; t <= G->n + 1; t++) {
+    while (lighter(G, t, stack[top])) {
+      size_t p = stack[top--];
+      if (t - p >= 2) {
+        G->arcs[++G->nArcs] = (arc) { p, t };
+        computeRegion(G, G->nArcs, pending, &nPending);
+        pending[nPending++] = G->nArcs;
+      }
+    }
+    if (t - stack[top] >= 2 && t <= G->n) {
+      G->arcs[++G->nArcs] = (arc) { stack[top], t };
+      computeRegion(G, G->nArcs, pending, &nPending);
+      pending[nPending++] = G->nArcs;
+    }
+    stack[++top] = t;
+  }
+
+    // the whole polygon comes last
+  G->arcs[++G->nArcs] = (arc) { 0, G->n + 1 };
+  computeRegion(G, G->nArcs, pending, &nPending);
+  free(stack);
+  free(pending);
+}
+
+//===================================================================
+// Adds the triangle of the positions r, s and t of the polygon: the
+// middle one of its vertices is the split point of the chain 
+// between the other two
+static void addTriangle(polygon *G, size_t r, size_t s, size_t t,
+                        size_t *lo, size_t *hi) {
+  size_t v[3] = { G->vertex[r], G->vertex[s], G->vertex[t] };
+  for (size_t i = 0; i < 2; i++)
+    for (size_t j = 0; j < 2 - i; j++)
+      if (v[j] > v[j + 1]) {
+        size_t tmp = v[j]; v[j] = v[j + 1]; v[j + 1] = tmp;
+      }
+  lo[v[1]] = v[0];
+  hi[v[1]] = v[2];
+}
+
+//===================================================================
+// Fans out the regions of all kept arcs, in the order in which they
+// were found: the border arcs of an arc are the kept arcs below it
+// that are still pending, and its region is walked from a to b, 
+// jumping over them
+static void triangulate(polygon *G, size_t *lo, size_t *hi) {
+  arc *A = G->arcs;
+  size_t *jump = safeCalloc(G->n + 2, sizeof(size_t));
+  size_t *pending = safeCalloc(G->nArcs + 1, sizeof(size_t));
+  size_t *border = safeCalloc(G->n + 2, sizeof(size_t));
+  size_t nPending = 0;
+
+  for (size_t h = 1; h <= G->nArcs; h++) {
+    arc *H = A + h;
+    if (H->removed)
+      continue;
+    while (nPending && A[pending[nPending - 1]].a >= H->a) {
+      arc *C = A + pending[--nPending];
+      jump[C->a] = C->b;
+    }
+
+    size_t len = 0;
+    for (size_t t = H->a; t < H->b; ) {
+      border[len++] = t;
+      size_t next = jump[t] ? jump[t] : t + 1;
+      jump[t] = 0;
+      t = next;
+    }
+    border[len++] = H->b;
+
+      // the sides at the lightest vertex do not form a triangle with 
+      // it; the whole polygon has its lightest vertex at both ends
+    bool root = H->a == 0 && H->b == G->n + 1;
+    size_t m = root || lighter(G, H->a, H->b) ? H->a : H->b;
+    size_t from = m == H->a ? 1 : 0;
+    size_t to = root || m == H->b ? len - 2 : len - 1;
+    for (size_t i = from; i < to; i++)
+      addTriangle(G, m, border[i], border[i + 1], lo, hi);
+    pending[nPending++] = h;
+  }
+  free(jump);
+  free(pending);
+  free(border);
+}
+
+//===================================================================
+// Returns an optimal order of the chain of n matrices
+mcmOrder *mcmHuShing(size_t *dims, size_t n) {
+  mcmOrder *O = safeCalloc(1, sizeof(mcmOrder));
+  O->n = n;
+  O->left = safeCalloc(n + 1, sizeof(size_t));
+  O->right = safeCalloc(n + 1, sizeof(size_t));
+  if (n < 2)
+    return O;
+
+    // cut the polygon open at its lightest vertex
+  size_t lightest = 0;
+  for (size_t i = 1; i <= n; i++)
+    if (dims[i] < dims[lightest])
+      lightest = i;
+  polygon G = { n };
+  G.w = safeCalloc(n + 2, sizeof(size_t));
+  G.vertex = safeCalloc(n + 2, sizeof(size_t));
+  G.pre = safeCalloc(n + 2, sizeof(size_t));
+  G.arcs = safeCalloc(n + 2, sizeof(arc));
+  for (size_t t = 0; t <= n + 1; t++) {
+    G.vertex[t] = (lightest + t) % (n + 1);
+    G.w[t] = dims[G.vertex[t]];
+    if (t) G.pre[t] = G.pre[t - 1] + sideWeight(&G, t - 1, t);
+  }
+
+  sweep(&G);
+  O->cost = G.arcs[G.nArcs].fan + G.arcs[G.nArcs].below;
+
+    // the triangle with middle vertex k spans the chain of the 
+    // matrices lo[k] + 1..hi[k]; the chain of its parent has k as
+    // an end point, and contains its own chain
+  size_t *lo = safeCalloc(n + 1, sizeof(size_t));
+  size_t *hi = safeCalloc(n + 1, sizeof(size_t));
+  triangulate(&G, lo, hi);
+  for (size_t k = 1; k < n; k++) {
+    if (lo[k] == 0 && hi[k] == n)
+      O->root = k;
+    else if (hi[k] < n && lo[hi[k]] == lo[k])
+      O->left[hi[k]] = k;
+    else
+      O->right[lo[k]] = k;
+  }
+
+  free(lo);
+  free(hi);
+  free(G.w);
+  free(G.vertex);
+  free(G.pre);
+  free(G.arcs);
+  return O;
+}
+
+//===================================================================
+// Deallocates the order
+void mcmFreeOrder(mcmOrder *O) {
+  free(O->left);
+  free(O->right);
+  free(O);
+}
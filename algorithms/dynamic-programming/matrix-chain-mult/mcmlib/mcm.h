@@ -0,0 +1,32 @@
+#ifndef MCM_H_INCLUDED
+#define MCM_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // An optimal order of the matrix chain A₁..Aₙ as a binary tree,
+  // whose nodes are the split points k = 1..n-1: the node k of a 
+  // chain Aᵢ..Aⱼ splits it into Aᵢ..Aₖ and Aₖ₊₁..Aⱼ, and its children
+  // are the nodes of these two chains, or 0 for a single matrix
+typedef struct {
+  size_t n;               // number of matrices
+  size_t cost;            // minimal number of scalar multiplications
+  size_t root;            // the split point of the whole chain
+  size_t *left, *right;   // the children of each split point
+} mcmOrder;
+
+  // Returns an optimal order of the chain of n matrices, where Aᵢ is
+  // a dims[i-1] x dims[i] matrix, using the algorithm of Hu and 
+  // Shing: the chain is a polygon with the dimensions as vertex 
+  // weights, whose optimal triangulation only uses diagonals 
+  // between vertices that are lighter than all vertices on one side
+  // of them, and fans out from the lightest vertex elsewhere; 
+  // O(n log n) time, O(n) space
+mcmOrder *mcmHuShing(size_t *dims, size_t n);
+
+  // Deallocates the order
+void mcmFreeOrder(mcmOrder *O);
+
+#endif // MCM_H_INCLUDED
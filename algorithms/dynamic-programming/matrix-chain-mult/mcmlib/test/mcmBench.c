@@ -0,0 +1,130 @@
+/*
+  Benchmark of the matrix chain ordering algorithms: the bottom-up
+    DP of mcm-3.c with full row-pointer tables as before, the same 
+    DP with upper-triangular tables in a single block as in mcm-3.c
+    now, and the algorithm of Hu and Shing
+  For each number of matrices n, random dimensions between 1 and
+    1000 are used; the DP only runs up to maxDP matrices, since it
+    takes cubic time. The minimal costs are compared, and the 
+    memory column shows the bytes of the tables
+  Usage: ./mcmBench.out [maxN] [maxDP]
+  Author: David De Potter
+*/
+
+#include "../mcm.h"
+#include <time.h>
+
+//===================================================================
+// Returns the minimal cost of the chain, using the DP of mcm-3.c
+// with full len x len tables of row pointers
+size_t computeMatrix(size_t *dims, size_t len) {
+  CREATE_MATRIX(size_t, minCosts, len, len, SIZE_MAX);
+  CREATE_MATRIX(size_t, splitPoints, len, len, 0);
+  for (size_t i = 0; i < len; i++)
+    minCosts[i][i] = 0;
+  for (size_t l = 2; l <= len; l++)
+    for (size_t i = 1; i < len - l + 1; i++) {
+      size_t j = i + l - 1;
+      for (size_t k = i; k < j; k++) {
+        size_t cost = minCosts[i][k] + minCosts[k + 1][j]
+                    + dims[i - 1] * dims[k] * dims[j];
+        if (cost < minCosts[i][j]) {
+          minCosts[i][j] = cost;
+          splitPoints[i][j] = k;
+        }
+      }
+    }
+  size_t cost = minCosts[1][len - 1];
+  FREE_MATRIX(minCosts, len);
+  FREE_MATRIX(splitPoints, len);
+  return cost;
+}
+
+//===================================================================
+// Returns the minimal cost of the chain, using the same DP with the
+// upper-triangular tables of mcm-3.c, where row i holds the entries
+// for j = i..n, and the rows are filled from the last one up
+size_t computeTriangle(size_t *dims, size_t len) {
+  size_t n = len - 1, size = n * (n + 1) / 2;
+  size_t *minCosts = safeCalloc(size, sizeof(size_t));
+  size_t *splitPoints = safeCalloc(size, sizeof(size_t));
+  #define AT(i, j) (((i) - 1) * (2 * n + 2 - (i)) / 2 + (j) - (i))
+  for (size_t e = 0; e < size; e++)
+    minCosts[e] = SIZE_MAX;
+  for (size_t i = n; i >= 1; i--) {
+    size_t *costs = minCosts + AT(i, i);
+    size_t *splits = splitPoints + AT(i, i);
+    costs[0] = 0;
+    for (size_t k = i; k < n; k++) {
+      size_t *next = minCosts + AT(k + 1, k + 1);
+      size_t left = costs[k - i], outer = dims[i - 1] * dims[k];
+      for (size_t j = k + 1; j <= n; j++) {
+        size_t cost = left + next[j - k - 1] + outer * dims[j];
+        if (cost < costs[j - i]) {
+          costs[j - i] = cost;
+          splits[j - i] = k;
+        }
+      }
+    }
+  }
+  size_t cost = minCosts[AT(1, n)];
+  #undef AT
+  free(minCosts);
+  free(splitPoints);
+  return cost;
+}
+
+//===================================================================
+// Returns the time in seconds since start
+double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+// Shows a row of the table: the name of an algorithm, its time,
+// its memory in KB, and its result, compared against ref
+void showRow(char const *name, double time, size_t bytes,
+             size_t result, size_t ref) {
+  printf("  %-10s  %9.4fs  %12zu  %16zu%s\n", name, time,
+         bytes / 1024, result, result != ref ? " (wrong!)" : "");
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxN = argc > 1 ? strtoul(argv[1], NULL, 10) : 256000;
+  size_t maxDP = argc > 2 ? strtoul(argv[2], NULL, 10) : 2000;
+  srand(42);
+
+  for (size_t n = 500; n <= maxN; n *= 2) {
+    size_t *dims = safeCalloc(n + 1, sizeof(size_t));
+    for (size_t i = 0; i <= n; i++)
+      dims[i] = rand() % 1000 + 1;
+
+    printf("n = %zu\n", n);
+    printf("  %-10s  %10s  %12s  %16s\n", "algorithm", "time",
+           "memory (KB)", "cost");
+
+    clock_t start = clock();
+    mcmOrder *O = mcmHuShing(dims, n);
+    double time = elapsed(start);
+    size_t ref = O->cost;
+    mcmFreeOrder(O);
+
+    if (n <= maxDP) {
+      start = clock();
+      size_t cost = computeMatrix(dims, n + 1);
+      showRow("matrix", elapsed(start), 2 * (n + 1) * (n + 1) *
+              sizeof(size_t), cost, ref);
+      start = clock();
+      cost = computeTriangle(dims, n + 1);
+      showRow("triangle", elapsed(start), n * (n + 1) *
+              sizeof(size_t), cost, ref);
+    }
+    showRow("Hu-Shing", time, (n + 2) * (16 * sizeof(size_t) + 
+            sizeof(bool)), ref, ref);
+    printf("\n");
+    free(dims);
+  }
+  return 0;
+}
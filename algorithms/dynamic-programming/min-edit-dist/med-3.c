@@ -107,7 +107,7 @@ void recPath(string *src, string *tgt, size_t i, size_t j,
   switch (ops[i][j]) {
     case COPY:
       recPath(src, tgt, i - 1, j - 1, ops, str, costs);
-      printf("Copy %c:\n  ", charAt(src, i - 1)), 
+      printf("Copy %c:\n  ", charAt(src, i - 1));
       showEdit(str, src, charAt(src, i - 1), i);
       break;
     case INSERT:
@@ -4,68 +4,105 @@
   email: pl3onasm@gmail.com
   license: MIT, see LICENSE file in repository root folder
   description: minimum edit distance
-    using bottom-up DP with path reconstruction
-  time complexity: O(n*m)
+    using bottom-up DP with path reconstruction, where the table 
+    is filled in anti-diagonal wavefront order by a pool of 
+    threads, one tile at a time (see ../wflib/wf.c)
+  time complexity: O(n*m), or O(n*m/p) on p processors
 */
 
 #include "../../../lib/clib.h"
+#include "../wflib/wf.h"
 typedef enum { COPY, INSERT, DELETE, REPLACE, SWAP, KILL } op;
 
-//===================================================================
-// Updates the minimum value and operation if a new minimum is found
-void checkMin(size_t **dp, op **ops, size_t i, size_t j, 
-              size_t oldCost, op newOp, size_t *costs, size_t k) {
+  // The strings, the operation costs, and the tables of costs and 
+  // operations of (|src| + 1) x (|tgt| + 1) entries, which are 
+  // stored row by row in contiguous blocks
+typedef struct {
+  string *src, *tgt;
+  size_t *costs, *dp, cols;
+  op *ops;
+} medTables;
 
-  if (dp[i][j] > oldCost + costs[newOp]) {
-    dp[i][j] = oldCost + costs[newOp];
-    ops[i][j] = newOp;
-    if (newOp == KILL) costs[6] = i - k;
-  }
+//===================================================================
+// Returns the index of entry (i, j) in the tables
+static inline size_t at(medTables *M, size_t i, size_t j) {
+  return i * M->cols + j;
 }
 
 //===================================================================
-// Bottom-up approach to compute the minimum edit distance
-size_t computeMED(string *src, string *tgt, size_t *costs, 
-                  size_t **dp, op **ops) {
-
-    // target is empty: delete all source chars
-  for (size_t i = 0; i <= strLen(src); ++i) {
-    dp[i][0] = i * costs[DELETE];
-    ops[i][0] = DELETE;
-  }
+// Updates the minimum value and operation if a new minimum is found
+void checkMin(medTables *M, size_t i, size_t j, size_t oldCost, 
+              op newOp, size_t k) {
 
-    // source is empty: insert all target chars
-  for (size_t j = 0; j <= strLen(tgt); ++j) {
-    dp[0][j] = j * costs[INSERT];
-    ops[0][j] = INSERT;
+  if (M->dp[at(M, i, j)] > oldCost + M->costs[newOp]) {
+    M->dp[at(M, i, j)] = oldCost + M->costs[newOp];
+    M->ops[at(M, i, j)] = newOp;
+    if (newOp == KILL) M->costs[6] = i - k;
   }
+}
 
-  for (size_t i = 1; i <= strLen(src); ++i) {
-    for (size_t j = 1; j <= strLen(tgt); ++j) {
+//===================================================================
+// Fills the entries (i, j) of the tables for i in (r0, r1] and j in
+// (c0, c1], given that the entries above and to the left of them 
+// are known
+void medKernel(size_t r0, size_t r1, size_t c0, size_t c1, 
+               void *arg) {
+
+  medTables *M = arg;
+  string *src = M->src, *tgt = M->tgt;
+  size_t *dp = M->dp;
+
+  for (size_t i = r0 + 1; i <= r1; ++i) {
+    for (size_t j = c0 + 1; j <= c1; ++j) {
       
       if (charAt(src, i - 1) == charAt(tgt, j - 1))
-        checkMin(dp, ops, i, j, dp[i - 1][j - 1], COPY, costs, 0);
+        checkMin(M, i, j, dp[at(M, i - 1, j - 1)], COPY, 0);
       
       if (i > 1 && j > 1 && charAt(src, i - 1) == charAt(tgt, j - 2) 
           && charAt(src, i - 2) == charAt(tgt, j - 1)) {
-        checkMin(dp, ops, i, j, dp[i - 2][j - 2], SWAP, costs, 0);
+        checkMin(M, i, j, dp[at(M, i - 2, j - 2)], SWAP, 0);
       }
 
-      checkMin(dp, ops, i, j, dp[i][j - 1], INSERT, costs, 0);
+      checkMin(M, i, j, dp[at(M, i, j - 1)], INSERT, 0);
       
-      checkMin(dp, ops, i, j, dp[i - 1][j], DELETE, costs, 0);
+      checkMin(M, i, j, dp[at(M, i - 1, j)], DELETE, 0);
 
       if (charAt(src, i - 1) != charAt(tgt, j - 1))
-        checkMin(dp, ops, i, j, dp[i - 1][j - 1], REPLACE, costs, 0);
+        checkMin(M, i, j, dp[at(M, i - 1, j - 1)], REPLACE, 0);
     }
   }
+}
+
+//===================================================================
+// Bottom-up approach to compute the minimum edit distance
+size_t computeMED(medTables *M) {
+
+  string *src = M->src, *tgt = M->tgt;
+
+    // target is empty: delete all source chars
+  for (size_t i = 0; i <= strLen(src); ++i) {
+    M->dp[at(M, i, 0)] = i * M->costs[DELETE];
+    M->ops[at(M, i, 0)] = DELETE;
+  }
+
+    // source is empty: insert all target chars
+  for (size_t j = 0; j <= strLen(tgt); ++j) {
+    M->dp[at(M, 0, j)] = j * M->costs[INSERT];
+    M->ops[at(M, 0, j)] = INSERT;
+  }
+
+    // the entry (i, j) depends on the entries (i - 1, j - 1), 
+    // (i - 2, j - 2), (i, j - 1) and (i - 1, j), which all lie 
+    // above and to the left of it
+  wfRun(strLen(src), strLen(tgt), WF_TILE, medKernel, M, 
+        wfProcessors());
   
     // check if killing last remaining chars is cheaper
   for (size_t k = 0; k < strLen(src); ++k) 
-    checkMin(dp, ops, strLen(src), strLen(tgt), 
-             dp[k][strLen(tgt)], KILL, costs, k);
+    checkMin(M, strLen(src), strLen(tgt), 
+             M->dp[at(M, k, strLen(tgt))], KILL, k);
 
-  return dp[strLen(src)][strLen(tgt)];
+  return M->dp[at(M, strLen(src), strLen(tgt))];
 }
 
 //===================================================================
@@ -83,8 +120,9 @@ void showEdit(string *str, string *src, unsigned char ch,
 //===================================================================
 // Reconstructs the optimal operation sequence to transform source 
 // into target string while showing all intermediate edit steps
-void recPath(string *src, string *tgt, size_t i, size_t j, 
-             op **ops, string *str, size_t *costs) {
+void recPath(medTables *M, size_t i, size_t j, string *str) {
+
+  string *src = M->src, *tgt = M->tgt;
 
   if (i == 0 && j == 0) {
     printf("Source:\n  ");
@@ -92,38 +130,38 @@ void recPath(string *src, string *tgt, size_t i, size_t j,
     return;
   }
 
-  switch (ops[i][j]) {
+  switch (M->ops[at(M, i, j)]) {
     case COPY:
-      recPath(src, tgt, i - 1, j - 1, ops, str, costs);
-      printf("Copy %c:\n  ", charAt(src, i - 1)), 
+      recPath(M, i - 1, j - 1, str);
+      printf("Copy %c:\n  ", charAt(src, i - 1));
       showEdit(str, src, charAt(src, i - 1), i);
       break;
     case INSERT:
-      recPath(src, tgt, i, j - 1, ops, str, costs);
+      recPath(M, i, j - 1, str);
       printf("Insert %c:\n  ", charAt(tgt, j - 1));
       showEdit(str, src, charAt(tgt, j - 1), i);
       break;
     case DELETE:
-      recPath(src, tgt, i - 1, j, ops, str, costs);
+      recPath(M, i - 1, j, str);
       printf("Delete %c:\n  ", charAt(src, i - 1));
       showEdit(str, src, '\0', i);
       break;
     case REPLACE:
-      recPath(src, tgt, i - 1, j - 1, ops, str, costs);
+      recPath(M, i - 1, j - 1, str);
       printf("Replace %c with %c:\n  ", charAt(src, i - 1), 
              charAt(tgt, j - 1));
       showEdit(str, src, charAt(tgt, j - 1), i);
       break;
     case SWAP:
-      recPath(src, tgt, i - 2, j - 2, ops, str, costs);
+      recPath(M, i - 2, j - 2, str);
       printf("Swap %c%c with %c%c:\n  ", charAt(src, i - 2), 
         charAt(src, i - 1), charAt(tgt, j - 2), charAt(tgt, j - 1));
       appendChar(str, charAt(tgt, j - 2));
       showEdit(str, src, charAt(tgt, j - 1), i);
       break;
     case KILL:
-      recPath(src, tgt, strLen(src) - costs[6], j, ops, str, costs);
-      printf("Kill %zu remaining chars:\n  ", costs[6]);
+      recPath(M, strLen(src) - M->costs[6], j, str);
+      printf("Kill %zu remaining chars:\n  ", M->costs[6]);
       showEdit(str, src, '\0', strLen(src));
       break;
   }
@@ -147,15 +185,18 @@ int main () {
   size_t costs[7]; 
   READ_ARRAY(costs, "%zu", 6);
 
-    // create memoization table
-  CREATE_MATRIX(size_t, dp, strLen(src) + 1, 
-                strLen(tgt) + 1, SIZE_MAX);
-
-    // create operations table
-  CREATE_MATRIX(op, ops, strLen(src) + 1, strLen(tgt) + 1, INSERT);
+    // create memoization and operations tables
+  medTables M = { src, tgt, costs, NULL, strLen(tgt) + 1, NULL };
+  size_t size = (strLen(src) + 1) * M.cols;
+  M.dp = safeCalloc(size, sizeof(size_t));
+  M.ops = safeCalloc(size, sizeof(op));
+  for (size_t e = 0; e < size; ++e) {
+    M.dp[e] = SIZE_MAX;
+    M.ops[e] = INSERT;
+  }
 
     // compute minimum edit distance
-  size_t med = computeMED(src, tgt, costs, dp, ops);
+  size_t med = computeMED(&M);
 
     // show edit distance and an optimal operation sequence
   printf("Minimum edit distance: %zu\n\n"
@@ -163,13 +204,13 @@ int main () {
 
   if (med) {
     string *str = newString(strLen(src) + strLen(tgt) + 1);
-    recPath(src, tgt, strLen(src), strLen(tgt), ops, str, costs);
+    recPath(&M, strLen(src), strLen(tgt), str);
     freeString(str);
   } else printf("None\n");
 
     // deallocate memory
-  FREE_MATRIX(dp, strLen(src) + 1);
-  FREE_MATRIX(ops, strLen(src) + 1);
+  free(M.dp);
+  free(M.ops);
   freeString(src);
   freeString(tgt);
 
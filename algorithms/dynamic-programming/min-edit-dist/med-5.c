@@ -0,0 +1,83 @@
+/*
+  file: med-5.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: fuzzy matching of a query against a list of
+    candidates using the Levenshtein distance (unit costs for
+    insert, delete and replace, no swap or kill), where only the
+    candidates within distance k are reported. The distances are
+    computed without the DP table, using the bit-vector or the
+    banded algorithm; only the closest candidate is aligned with
+    the query, using the bottom-up DP with path reconstruction of
+    medlib/med.c
+  input: the query, followed by the threshold k and the number of
+    candidates, and the candidates, one per line
+  time complexity: O(min(k, m/64)·n) per candidate of length n,
+    where m is the length of the query, and O(mn) for the
+    alignment
+*/
+
+#include "../../../lib/clib.h"
+#include "medlib/med.h"
+
+//===================================================================
+// Shows the candidates within distance k of the query and aligns
+// the closest one with the query
+void fuzzyMatch(string *query, string **cands, size_t n, size_t k) {
+
+  size_t *dist = safeCalloc(n, sizeof(size_t));
+  medQuery *Q = medNewQuery(query);
+  size_t count = medBatch(Q, cands, n, k, dist);
+
+  printf("Candidates within distance %zu: %zu of %zu\n\n",
+         k, count, n);
+  size_t best = n;
+  for (size_t c = 0; c < n; c++) {
+    if (dist[c] == MED_EXCEEDED)
+      continue;
+    printf("  %3zu  ", dist[c]);
+    showString(cands[c]);
+    if (best == n || dist[c] < dist[best])
+      best = c;
+  }
+
+  if (best < n) {
+    printf("\nClosest candidate at distance %zu:\n  ", dist[best]);
+    showString(cands[best]);
+    printf("\n");
+    medShowAlignment(query, cands[best]);
+  }
+
+  medFreeQuery(Q);
+  free(dist);
+}
+
+//===================================================================
+
+int main () {
+
+    // read the query, the threshold and the number of candidates
+  READ_STRING(query, '\n');
+  size_t k, n;
+  reader *R = stdinReader();
+  if (! readerScan(R, "%zu", &k) || ! readerScan(R, "%zu", &n)) {
+    fprintf(stderr, "Invalid input\n");
+    return EXIT_FAILURE;
+  }
+  readerSkipLine(R);
+
+  string **cands = safeCalloc(n, sizeof(string *));
+  for (size_t c = 0; c < n; c++) {
+    READ_STRING(cand, '\n');
+    cands[c] = cand;
+  }
+
+  fuzzyMatch(query, cands, n, k);
+
+  for (size_t c = 0; c < n; c++)
+    freeString(cands[c]);
+  free(cands);
+  freeString(query);
+  return 0;
+}
@@ -0,0 +1,311 @@
+/*
+  file: med.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: Levenshtein distance without the full DP table, 
+    using the bit-vector algorithm of Myers for whole columns, and
+    Ukkonen's banded algorithm when the distance is bounded by a 
+    small threshold, and the alignment of two strings with the full
+    DP table
+*/
+
+#include "med.h"
+
+  // The cost of a block of the bit-vector algorithm in terms of DP
+  // entries of the banded algorithm, used to choose between them
+#define BLOCK_COST 2
+
+//===================================================================
+// Prepares the query Q for the bit-vector algorithm
+medQuery *medNewQuery(string *Q) {
+  medQuery *query = safeCalloc(1, sizeof(medQuery));
+  query->Q = Q;
+  query->blocks = strLen(Q) / 64 + 1;
+  query->peq = safeCalloc(256 * query->blocks, sizeof(uint64_t));
+  query->pv = safeCalloc(query->blocks, sizeof(uint64_t));
+  query->mv = safeCalloc(query->blocks, sizeof(uint64_t));
+  for (size_t i = 0; i < strLen(Q); i++) 
+    query->peq[charAt(Q, i) * query->blocks + i / 64] |= 
+      UINT64_C(1) << (i % 64);
+  return query;
+}
+
+//===================================================================
+// Deallocates the query
+void medFreeQuery(medQuery *query) {
+  free(query->peq);
+  free(query->pv);
+  free(query->mv);
+  free(query);
+}
+
+//===================================================================
+// Advances a block of the column by one character: eq holds the 
+// matches of the block, and hin ∈ {-1, 0, 1} is the horizontal 
+// delta of the row just above the block; returns the horizontal 
+// delta of the row given by the bit in mask
+static inline int advanceBlock(uint64_t *pv, uint64_t *mv, 
+                               uint64_t eq, int hin, uint64_t mask) {
+  uint64_t Pv = *pv, Mv = *mv;
+  uint64_t hinNeg = hin < 0, hinPos = hin > 0;
+  uint64_t Xv = eq | Mv;
+  eq |= hinNeg;
+  uint64_t Xh = (((eq & Pv) + Pv) ^ Pv) | eq;
+  uint64_t Ph = Mv | ~(Xh | Pv);
+  uint64_t Mh = Pv & Xh;
+  int hout = (Ph & mask) ? 1 : (Mh & mask) ? -1 : 0;
+  Ph = (Ph << 1) | hinPos;
+  Mh = (Mh << 1) | hinNeg;
+  *pv = Mh | ~(Xv | Ph);
+  *mv = Ph & Xv;
+  return hout;
+}
+
+//===================================================================
+// Returns the Levenshtein distance between the query and T, or
+// MED_EXCEEDED if it exceeds k
+size_t medQueryDist(medQuery *query, string *T, size_t k) {
+
+  size_t m = strLen(query->Q), n = strLen(T);
+  if ((m > n ? m - n : n - m) > k)
+    return MED_EXCEEDED;
+  if (m == 0) 
+    return n;
+
+  size_t blocks = (m - 1) / 64 + 1;
+  uint64_t *pv = query->pv, *mv = query->mv;
+  uint64_t high = UINT64_C(1) << 63, last = UINT64_C(1) << (m - 1) % 64;
+  for (size_t b = 0; b < blocks; b++) {
+    pv[b] = UINT64_MAX;
+    mv[b] = 0;
+  }
+
+    // the score is the entry in the last row of the current column;
+    // the top row of the table is 0, 1, ..., n, so that the delta
+    // coming in at the top of the column is always +1
+  size_t score = m;
+  for (size_t j = 0; j < n; j++) {
+    uint64_t const *eq = query->peq + charAt(T, j) * query->blocks;
+    int h = 1;
+    for (size_t b = 0; b + 1 < blocks; b++) 
+      h = advanceBlock(pv + b, mv + b, eq[b], h, high);
+    score += advanceBlock(pv + blocks - 1, mv + blocks - 1, 
+                          eq[blocks - 1], h, last);
+
+      // the entries of the last row differ by at most 1, so that 
+      // the distance is at least score - (n - 1 - j)
+    if (score > k && score - k > n - 1 - j)
+      return MED_EXCEEDED;
+  }
+  return score;
+}
+
+//===================================================================
+// Returns the Levenshtein distance between X and Y
+size_t medLevenshtein(string *X, string *Y) {
+  if (strLen(X) > strLen(Y)) {
+    string *tmp = X; X = Y; Y = tmp;
+  }
+  medQuery *query = medNewQuery(X);
+  size_t dist = medQueryDist(query, Y, SIZE_MAX);
+  medFreeQuery(query);
+  return dist;
+}
+
+//===================================================================
+// Returns the Levenshtein distance between X and Y if it is at most
+// k, and MED_EXCEEDED otherwise
+size_t medBanded(string *X, string *Y, size_t k) {
+
+    // let X be the shorter string, so that there are fewer rows
+  if (strLen(X) > strLen(Y)) {
+    string *tmp = X; X = Y; Y = tmp;
+  }
+  size_t m = strLen(X), n = strLen(Y);
+  if (n - m > k)
+    return MED_EXCEEDED;
+  
+    // the distance is at most n, so that a wider band is useless;
+    // entries above k are capped at k + 1
+  k = MIN(k, n);
+  size_t width = 2 * k + 1, inf = k + 1;
+
+    // entry (i, j) of the table is stored in slot j - i + k + 1 of
+    // row i, where the first and last slots stay at inf as sentinels
+  size_t *prev = safeCalloc(width + 2, sizeof(size_t));
+  size_t *cur = safeCalloc(width + 2, sizeof(size_t));
+  for (size_t d = 0; d < width + 2; d++) 
+    prev[d] = cur[d] = inf;
+  for (size_t j = 0; j <= k; j++) 
+    prev[j + k + 1] = j;
+
+  for (size_t i = 1; i <= m; i++) {
+    size_t from = i > k ? i - k : 0, to = MIN(n, i + k), best = inf;
+    unsigned char xi = charAt(X, i - 1);
+
+      // entries (i - 1, j - 1), (i - 1, j) and (i, j - 1) are at
+      // the slots d, d + 1 and d - 1 of their rows; the slots of a 
+      // row that are not computed are never read by the next row
+    if (from == 0) 
+      cur[k + 1 - i] = best = MIN(i, inf);
+    for (size_t j = MAX(from, 1); j <= to; j++) {
+      size_t d = j + k + 1 - i;
+      size_t v = prev[d] + (xi != charAt(Y, j - 1));
+      v = MIN(v, prev[d + 1] + 1);
+      v = MIN(v, cur[d - 1] + 1);
+      cur[d] = MIN(v, inf);
+      best = MIN(best, cur[d]);
+    }
+    if (best > k) {
+      free(prev);
+      free(cur);
+      return MED_EXCEEDED;
+    }
+    size_t *tmp = prev; prev = cur; cur = tmp;
+  }
+
+  size_t dist = prev[n - m + k + 1];
+  free(prev);
+  free(cur);
+  return dist <= k ? dist : MED_EXCEEDED;
+}
+
+//===================================================================
+// Computes the distances between the query and the n candidates,
+// and returns the number of candidates within distance k
+size_t medBatch(medQuery *query, string **candidates, size_t n,
+                size_t k, size_t *dist) {
+
+  size_t m = strLen(query->Q), count = 0;
+  for (size_t c = 0; c < n; c++) {
+    size_t len = strLen(candidates[c]), band = MIN(k, MAX(m, len));
+    
+      // the banded algorithm computes about 2k + 1 entries per row,
+      // the bit-vector algorithm a number of blocks per column
+    if ((2 * band + 1) * MIN(m, len) < 
+        BLOCK_COST * query->blocks * len)
+      dist[c] = medBanded(query->Q, candidates[c], k);
+    else 
+      dist[c] = medQueryDist(query, candidates[c], k);
+    if (dist[c] != MED_EXCEEDED) 
+      count++;
+  }
+  return count;
+}
+
+  // The edit operations of the alignment, which uses unit costs
+typedef enum { COPY, INSERT, DELETE, REPLACE } op;
+
+//===================================================================
+// Bottom-up approach to compute the Levenshtein distance, where
+// ops records the last operation for each pair of prefixes
+static size_t computeMED(string *src, string *tgt, size_t **dp, op **ops) {
+
+  for (size_t i = 0; i <= strLen(src); ++i) {
+    dp[i][0] = i;
+    ops[i][0] = DELETE;
+  }
+
+  for (size_t j = 0; j <= strLen(tgt); ++j) {
+    dp[0][j] = j;
+    ops[0][j] = INSERT;
+  }
+
+  for (size_t i = 1; i <= strLen(src); ++i) {
+    for (size_t j = 1; j <= strLen(tgt); ++j) {
+      if (charAt(src, i - 1) == charAt(tgt, j - 1)) {
+        dp[i][j] = dp[i - 1][j - 1];
+        ops[i][j] = COPY;
+      }
+      if (dp[i][j - 1] + 1 < dp[i][j]) {
+        dp[i][j] = dp[i][j - 1] + 1;
+        ops[i][j] = INSERT;
+      }
+      if (dp[i - 1][j] + 1 < dp[i][j]) {
+        dp[i][j] = dp[i - 1][j] + 1;
+        ops[i][j] = DELETE;
+      }
+      if (dp[i - 1][j - 1] + 1 < dp[i][j]) {
+        dp[i][j] = dp[i - 1][j - 1] + 1;
+        ops[i][j] = REPLACE;
+      }
+    }
+  }
+  return dp[strLen(src)][strLen(tgt)];
+}
+
+//===================================================================
+// Shows the current state of the string being edited
+static void showEdit(string *str, string *src, unsigned char ch,
+                     size_t pos) {
+
+  if (ch) appendChar(str, ch);
+  if (strLen(str)) showSubstring(str, 0, strLen(str) - 1, '\0');
+  printf(" | ");
+  if (strLen(src)) showSubstring(src, pos, strLen(src) - 1, '\0');
+  printf("\n");
+}
+
+//===================================================================
+// Reconstructs the optimal operation sequence to transform source
+// into target string while showing all intermediate edit steps
+static void recPath(string *src, string *tgt, size_t i, size_t j,
+                    op **ops, string *str) {
+
+  if (i == 0 && j == 0) {
+    printf("Source:\n  ");
+    showString(src);
+    return;
+  }
+
+  switch (ops[i][j]) {
+    case COPY:
+      recPath(src, tgt, i - 1, j - 1, ops, str);
+      printf("Copy %c:\n  ", charAt(src, i - 1));
+      showEdit(str, src, charAt(src, i - 1), i);
+      break;
+    case INSERT:
+      recPath(src, tgt, i, j - 1, ops, str);
+      printf("Insert %c:\n  ", charAt(tgt, j - 1));
+      showEdit(str, src, charAt(tgt, j - 1), i);
+      break;
+    case DELETE:
+      recPath(src, tgt, i - 1, j, ops, str);
+      printf("Delete %c:\n  ", charAt(src, i - 1));
+      showEdit(str, src, '\0', i);
+      break;
+    case REPLACE:
+      recPath(src, tgt, i - 1, j - 1, ops, str);
+      printf("Replace %c with %c:\n  ", charAt(src, i - 1),
+             charAt(tgt, j - 1));
+      showEdit(str, src, charAt(tgt, j - 1), i);
+      break;
+  }
+
+  if (i == strLen(src) && j == strLen(tgt)) {
+    printf("Target:\n  ");
+    showString(tgt);
+  }
+}
+
+//===================================================================
+// Shows an optimal operation sequence to transform the query into
+// the given candidate
+void medShowAlignment(string *query, string *cand) {
+
+  CREATE_MATRIX(size_t, dp, strLen(query) + 1, strLen(cand) + 1, 
+                SIZE_MAX);
+  CREATE_MATRIX(op, ops, strLen(query) + 1, strLen(cand) + 1, COPY);
+
+  size_t med = computeMED(query, cand, dp, ops);
+  printf("Optimal operation sequence:\n\n");
+  if (med) {
+    string *str = newString(strLen(query) + strLen(cand) + 1);
+    recPath(query, cand, strLen(query), strLen(cand), ops, str);
+    freeString(str);
+  } else printf("None\n");
+
+  FREE_MATRIX(dp, strLen(query) + 1);
+  FREE_MATRIX(ops, strLen(query) + 1);
+}
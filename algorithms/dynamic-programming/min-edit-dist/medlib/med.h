@@ -0,0 +1,61 @@
+#ifndef MED_H_INCLUDED
+#define MED_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // The distance returned when it exceeds the given threshold
+#define MED_EXCEEDED SIZE_MAX
+
+  // A query string prepared for the bit-vector algorithm: bit i of
+  // peq[c * blocks + b] is set if Q[64b + i] = c, so that the
+  // query can be compared against any number of candidates
+typedef struct {
+  string *Q;            // the query string
+  size_t blocks;        // number of 64-bit blocks per bit vector
+  uint64_t *peq;        // 256 bit vectors of the matches
+  uint64_t *pv, *mv;    // vertical deltas +1 and -1 of a column
+} medQuery;
+
+  // Prepares the query Q; O(m + 256m/64) time and space
+medQuery *medNewQuery(string *Q);
+
+  // Deallocates the query, but not its string
+void medFreeQuery(medQuery *query);
+
+  // Returns the Levenshtein distance between the query and T, using
+  // the bit-vector algorithm of Myers in Hyyrö's formulation with 
+  // one column per character of T; returns MED_EXCEEDED as soon as 
+  // the distance is known to exceed k; O(mn/64) time. The query 
+  // holds the state of the columns, so it must not be shared by 
+  // concurrent comparisons
+size_t medQueryDist(medQuery *query, string *T, size_t k);
+
+  // Returns the Levenshtein distance between X and Y, using the 
+  // bit-vector algorithm with the shorter string as the query
+size_t medLevenshtein(string *X, string *Y);
+
+  // Returns the Levenshtein distance between X and Y if it is at 
+  // most k, and MED_EXCEEDED otherwise, using Ukkonen's algorithm: 
+  // only the diagonal band of width 2k + 1 of the DP table is 
+  // computed, row by row, until a row has no entry ≤ k left; 
+  // O(k·min(m, n)) time, O(k) space
+size_t medBanded(string *X, string *Y, size_t k);
+
+  // Computes the distances between the query and the n candidates,
+  // storing them in dist, with MED_EXCEEDED for the candidates at
+  // distance more than k; each comparison uses the banded or the 
+  // bit-vector algorithm, whichever is expected to be faster;
+  // returns the number of candidates within distance k
+size_t medBatch(medQuery *query, string **candidates, size_t n,
+                size_t k, size_t *dist);
+
+  // Shows an optimal sequence of unit-cost operations (copy, insert,
+  // delete, replace) that transforms the query into the candidate,
+  // with all intermediate strings, using the bottom-up DP with path
+  // reconstruction; O(mn) time and space
+void medShowAlignment(string *query, string *cand);
+
+#endif // MED_H_INCLUDED
@@ -0,0 +1,174 @@
+/*
+  Benchmark of the Levenshtein distance algorithms on a batch of
+    fuzzy comparisons: the bottom-up DP with only two rows, the
+    bit-vector algorithm without and with the threshold k, the
+    banded algorithm, and medBatch, which selects one of the
+    latter two for each candidate
+  For each query length m, a random query over an alphabet of 4
+    characters is compared against candidates obtained by applying
+    up to 2k random edits to it, with threshold k = 8; the total 
+    number of DP entries is about the same for each m. The numbers
+    of candidates within distance k are compared
+  Usage: ./medBench.out [queryLen]
+  Author: David De Potter
+*/
+
+#include "../med.h"
+#include <time.h>
+
+//===================================================================
+// Returns the Levenshtein distance between X and Y if it is at most
+// k, using the bottom-up DP of med-4.c with only two rows
+size_t computeMedRows(string *X, string *Y, size_t k) {
+  size_t n = strLen(Y);
+  size_t *prev = safeCalloc(n + 1, sizeof(size_t));
+  size_t *cur = safeCalloc(n + 1, sizeof(size_t));
+  for (size_t j = 0; j <= n; ++j)
+    prev[j] = j;
+  for (size_t i = 1; i <= strLen(X); ++i) {
+    cur[0] = i;
+    for (size_t j = 1; j <= n; ++j) {
+      size_t v = prev[j - 1] + (charAt(X, i - 1) != charAt(Y, j - 1));
+      v = MIN(v, prev[j] + 1);
+      cur[j] = MIN(v, cur[j - 1] + 1);
+    }
+    size_t *tmp = prev; prev = cur; cur = tmp;
+  }
+  size_t dist = prev[n];
+  free(prev);
+  free(cur);
+  return dist <= k ? dist : MED_EXCEEDED;
+}
+
+  // the query and the candidates of the current round
+medQuery *query;
+string **cands;
+size_t nCands, *dist;
+
+//===================================================================
+// Compares the query against all candidates using the DP
+size_t batchRows(size_t k) {
+  size_t count = 0;
+  for (size_t c = 0; c < nCands; c++)
+    count += computeMedRows(query->Q, cands[c], k) != MED_EXCEEDED;
+  return count;
+}
+
+//===================================================================
+// Compares the query against all candidates using the bit-vector
+// algorithm, computing the full distance
+size_t batchBits(size_t k) {
+  size_t count = 0;
+  for (size_t c = 0; c < nCands; c++)
+    count += medQueryDist(query, cands[c], SIZE_MAX) <= k;
+  return count;
+}
+
+//===================================================================
+// Compares the query against all candidates using the bit-vector
+// algorithm with early exit
+size_t batchBitsK(size_t k) {
+  size_t count = 0;
+  for (size_t c = 0; c < nCands; c++)
+    count += medQueryDist(query, cands[c], k) != MED_EXCEEDED;
+  return count;
+}
+
+//===================================================================
+// Compares the query against all candidates using the banded
+// algorithm
+size_t batchBanded(size_t k) {
+  size_t count = 0;
+  for (size_t c = 0; c < nCands; c++)
+    count += medBanded(query->Q, cands[c], k) != MED_EXCEEDED;
+  return count;
+}
+
+//===================================================================
+// Compares the query against all candidates using medBatch
+size_t batchAuto(size_t k) {
+  return medBatch(query, cands, nCands, k, dist);
+}
+
+//===================================================================
+// Returns a random string of n characters over {A, C, G, T}
+string *randomString(size_t n) {
+  string *s = newString(n + 1);
+  for (size_t i = 0; i < n; i++)
+    s->data[i] = "ACGT"[rand() % 4];
+  s->size = n;
+  return s;
+}
+
+//===================================================================
+// Returns a copy of Q with e random edits
+string *mutate(string *Q, size_t e) {
+  string *s = newString(strLen(Q) + e + 1);
+  memcpy(s->data, Q->data, strLen(Q));
+  s->size = strLen(Q);
+  while (e--) {
+    size_t p = rand() % (s->size + 1);
+    int op = rand() % 3;
+    if (op == 0 && p < s->size)
+      s->data[p] = "ACGT"[rand() % 4];
+    else if (op == 1 && p < s->size) {
+      memmove(s->data + p, s->data + p + 1, s->size - p - 1);
+      s->size--;
+    } else {
+      memmove(s->data + p + 1, s->data + p, s->size - p);
+      s->data[p] = "ACGT"[rand() % 4];
+      s->size++;
+    }
+  }
+  return s;
+}
+
+//===================================================================
+// Runs a batch, shows its time, and checks its number of matches 
+// against ref (if not SIZE_MAX); returns the count
+size_t bench(size_t (*batch)(size_t), size_t k, size_t ref) {
+  clock_t start = clock();
+  size_t count = batch(k);
+  printf("  %9.4fs", (double)(clock() - start) / CLOCKS_PER_SEC);
+  if (ref != SIZE_MAX && count != ref)
+    printf(" (wrong!)");
+  return count;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxLen = argc > 1 ? strtoul(argv[1], NULL, 10) : 4096;
+  srand(42);
+
+  printf("%6s  %8s  %10s  %10s  %10s  %10s  %10s  %8s\n", "m",
+         "cands", "two rows", "bits", "bits k", "banded", "batch",
+         "matches");
+
+  for (size_t m = 16; m <= maxLen; m *= 2) {
+    size_t k = 8;
+    nCands = (1 << 26) / (m * m) + 1;
+    string *Q = randomString(m);
+    query = medNewQuery(Q);
+    cands = safeCalloc(nCands, sizeof(string *));
+    dist = safeCalloc(nCands, sizeof(size_t));
+    for (size_t c = 0; c < nCands; c++)
+      cands[c] = mutate(Q, rand() % (2 * k + 1));
+
+    printf("%6zu  %8zu", m, nCands);
+    size_t count = bench(batchRows, k, SIZE_MAX);
+    bench(batchBits, k, count);
+    bench(batchBitsK, k, count);
+    bench(batchBanded, k, count);
+    bench(batchAuto, k, count);
+    printf("  %8zu\n", count);
+
+    for (size_t c = 0; c < nCands; c++)
+      freeString(cands[c]);
+    free(cands);
+    free(dist);
+    medFreeQuery(query);
+    freeString(Q);
+  }
+  return 0;
+}
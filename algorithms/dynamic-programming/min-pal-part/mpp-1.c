@@ -10,36 +10,29 @@
 */ 
 
 #include "../../../lib/clib.h"
+#include "../palib/pal.h"
 
 //===================================================================
-// Precomputes a function returning a boolean value indicating
-// whether a substring of the input string is a palindrome
-bool **computePalindromes(string *S) {
-
-  CREATE_MATRIX(bool, pal, strLen(S), strLen(S), false);
-
-  for (size_t i = strLen(S); i--; )
-    for (size_t j = i; j < strLen(S); j++) 
-      if (i == j) pal[i][j] = true;
-      else if (charAt(S, i) == charAt(S, j)) 
-        pal[i][j] = j - i == 1 ? true : pal[i + 1][j - 1];
-      
-  return pal;
+// Precomputes the radii of all palindromes of the input string,
+// from which palIsPalindrome tells whether a substring is a
+// palindrome in O(1) time, using O(n) instead of O(n^2) space
+size_t *computePalindromes(string *S) {
+  return palRadii(S);
 }
 
 //===================================================================
 // Computes the minimal number of cuts required to partition a string
 // into palindromes, using a naive recursive approach
-size_t partition(string *S, size_t i, bool **isPalindrome) {
+size_t partition(string *S, size_t i, size_t *radii) {
   
-  if (isPalindrome[0][i]) 
+  if (palIsPalindrome(radii, 0, i)) 
     return 0;
 
   size_t minCuts = i;
 
   for (size_t j = 0; j < i; j++)
-    if (isPalindrome[j + 1][i]) 
-      minCuts = MIN(minCuts, 1 + partition(S, j, isPalindrome));
+    if (palIsPalindrome(radii, j + 1, i)) 
+      minCuts = MIN(minCuts, 1 + partition(S, j, radii));
 
   return minCuts;
 }
@@ -51,13 +44,13 @@ int main() {
 
   READ_STRING(S, '\n');
 
-  bool **isPalindrome = computePalindromes(S);
+  size_t *radii = computePalindromes(S);
 
-  size_t cuts = partition(S, strLen(S) - 1, isPalindrome);
+  size_t cuts = partition(S, strLen(S) - 1, radii);
 
   printf("Min cuts: %zu\n", cuts);
 
-  FREE_MATRIX(isPalindrome, strLen(S));
+  free(radii);
   freeString(S);
 
   return 0;
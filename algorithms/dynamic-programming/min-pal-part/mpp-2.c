@@ -9,6 +9,7 @@
 */ 
 
 #include "../../../lib/clib.h"
+#include "../palib/pal.h"
 
 //===================================================================
 // Reconstructs an optimal palindromic partitioning of a given string
@@ -23,38 +24,30 @@ void showCuts(string *S, size_t *cutPoints, size_t k) {
 }
 
 //===================================================================
-// Precomputes a function returning a boolean value indicating
-// whether a substring of the input string is a palindrome
-bool **computePalindromes(string *S) {
-
-  CREATE_MATRIX(bool, pal, strLen(S), strLen(S), false);
-
-  for (size_t i = strLen(S); i--; )
-    for (size_t j = i; j < strLen(S); j++) 
-      if (i == j) pal[i][j] = true;
-      else if (charAt(S, i) == charAt(S, j)) 
-        pal[i][j] = j - i == 1 ? true : pal[i + 1][j - 1];
-      
-  return pal;
+// Precomputes the radii of all palindromes of the input string,
+// from which palIsPalindrome tells whether a substring is a
+// palindrome in O(1) time, using O(n) instead of O(n^2) space
+size_t *computePalindromes(string *S) {
+  return palRadii(S);
 }
 
 //===================================================================
 // Computes the minimal number of cuts required to partition a 
 // string into palindromes, using top-down DP with memoization
 size_t partition(string *S, size_t i, size_t *dp, 
-                 size_t *cutPoints, bool **isPalindrome) {
+                 size_t *cutPoints, size_t *radii) {
 
   if (dp[i] != SIZE_MAX) 
     return dp[i];
   
-  if (isPalindrome[0][i]) {
+  if (palIsPalindrome(radii, 0, i)) {
     cutPoints[i] = i;
     return dp[i] = 0;
   }
 
   for (size_t j = 0; j < i; j++) {
-    if (isPalindrome[j + 1][i] && 
-        partition(S, j, dp, cutPoints, isPalindrome) + 1 < dp[i]) {
+    if (palIsPalindrome(radii, j + 1, i) && 
+        partition(S, j, dp, cutPoints, radii) + 1 < dp[i]) {
       dp[i] = 1 + dp[j];
       cutPoints[i] = j;
     }
@@ -72,16 +65,16 @@ int main() {
   CREATE_ARRAY(size_t, dp, strLen(S), SIZE_MAX);
   CREATE_ARRAY(size_t, cutPoints, strLen(S), 0);
   
-  bool **isPalindrome = computePalindromes(S);
+  size_t *radii = computePalindromes(S);
 
-  partition(S, strLen(S) - 1, dp, cutPoints, isPalindrome);
+  partition(S, strLen(S) - 1, dp, cutPoints, radii);
 
   printf("Min cuts: %zu\n", dp[strLen(S) - 1]);
   printf("An optimal partitioning:\n  ");
   showCuts(S, cutPoints, strLen(S) - 1);
   printf("\n");
 
-  FREE_MATRIX(isPalindrome, strLen(S));
+  free(radii);
   freeString(S);
   free(dp);
   free(cutPoints);
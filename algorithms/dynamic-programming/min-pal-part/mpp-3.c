@@ -9,6 +9,7 @@
 */ 
 
 #include "../../../lib/clib.h"
+#include "../palib/pal.h"
 
 //===================================================================
 // Reconstructs an optimal palindromic partitioning of a given string
@@ -23,19 +24,11 @@ void showCuts(string *S, size_t *cutPoints, size_t k) {
 }
 
 //===================================================================
-// Precomputes a function returning a boolean value indicating
-// whether a substring of the input string is a palindrome
-bool **computePalindromes(string *S) {
-
-  CREATE_MATRIX(bool, pal, strLen(S), strLen(S), false);
-
-  for (size_t i = strLen(S); i--; )
-    for (size_t j = i; j < strLen(S); j++) 
-      if (i == j) pal[i][j] = true;
-      else if (charAt(S, i) == charAt(S, j)) 
-        pal[i][j] = j - i == 1 ? true : pal[i + 1][j - 1];
-      
-  return pal;
+// Precomputes the radii of all palindromes of the input string,
+// from which palIsPalindrome tells whether a substring is a
+// palindrome in O(1) time, using O(n) instead of O(n^2) space
+size_t *computePalindromes(string *S) {
+  return palRadii(S);
 }
 
 //===================================================================
@@ -43,21 +36,22 @@ bool **computePalindromes(string *S) {
 // into palindromes, using bottom-up DP
 size_t partition(string *S, size_t *dp, size_t *cutPoints) {
 
-  bool **isPalindrome = computePalindromes(S);
+  size_t *radii = computePalindromes(S);
 
   for (size_t i = 0; i < strLen(S); i++) 
-    if (isPalindrome[0][i]) {
+    if (palIsPalindrome(radii, 0, i)) {
       cutPoints[i] = i;
       dp[i] = 0;
     } else {
       for (size_t j = 0; j < i; j++) 
-        if (isPalindrome[j + 1][i] && dp[j] + 1 < dp[i]) {
+        if (palIsPalindrome(radii, j + 1, i) && 
+            dp[j] + 1 < dp[i]) {
           dp[i] = dp[j] + 1;
           cutPoints[i] = j;
         }
     }
 
-  FREE_MATRIX(isPalindrome, strLen(S));
+  free(radii);
   return dp[strLen(S) - 1];
 }
 
@@ -0,0 +1,62 @@
+/*
+  file: mpp-4.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: minimal palindromic partitioning
+    using the palindromic tree (eertree), where the palindromic
+    suffixes of each prefix are grouped into O(log n) series
+    instead of being tried one by one (see ../palib/pal.c)
+  time complexity: O(n log n)
+*/
+
+#include "../../../lib/clib.h"
+#include "../palib/pal.h"
+
+//===================================================================
+// Shows an optimal palindromic partitioning of a given string, where
+// prev[i] is the length of the prefix before the last palindrome of
+// the prefix of length i; the cuts are collected first, since there
+// may be as many as there are characters
+void showCuts(string *S, size_t *prev) {
+
+  size_t n = strLen(S), nParts = 0;
+  size_t *starts = safeCalloc(n + 1, sizeof(size_t));
+  for (size_t i = n; i > 0; i = prev[i])
+    starts[nParts++] = prev[i];
+
+  for (size_t p = nParts; p--; ) {
+    size_t end = p ? starts[p - 1] : n;
+    if (p + 1 < nParts)
+      printf("| ");
+    showSubstring(S, starts[p], end - 1, ' ');
+  }
+  free(starts);
+}
+
+//===================================================================
+
+int main() {
+
+  READ_STRING(S, '\n');
+
+  if (strLen(S) == 0) {
+    fprintf(stderr, "The string is empty\n");
+    freeString(S);
+    return EXIT_FAILURE;
+  }
+
+  CREATE_ARRAY(size_t, prev, strLen(S) + 1, 0);
+
+  size_t parts = palMinPartition(S, prev);
+
+  printf("Min cuts: %zu\n", parts - 1);
+  printf("An optimal partitioning:\n  ");
+  showCuts(S, prev);
+  printf("\n");
+
+  freeString(S);
+  free(prev);
+
+  return 0;
+}
@@ -6,34 +6,56 @@
   description: optimal binary search tree problem,
     bottom-up dynamic programming approach with Knuth's
     optimization to reduce time complexity to O(n^2)
+    The tables only hold the ranges of keys i..j with i ≤ j, stored
+    row by row in single contiguous upper-triangular blocks, which
+    are filled from the bottom row up
   time complexity: O(n^2)
 */
 
 #include "../../../lib/clib.h"
 #include <float.h>
 
+  // The tables of the costs, the roots and the probability sums of 
+  // the optimal subtrees for the keys i..j with 0 ≤ i ≤ j < n, where
+  // row i holds the n - i entries for j = i..n-1
+typedef struct {
+  size_t n;
+  double *costs, *sums;
+  size_t *roots;
+} obstTables;
+
+//===================================================================
+// Returns the index of the entry for the keys i..j in the tables
+static inline size_t at(obstTables *T, size_t i, size_t j) {
+  return i * (2 * T->n + 1 - i) / 2 + j - i;
+}
+
 //===================================================================
 // Computes the expected search cost of an optimal binary search tree
 // and stores the optimal roots of the subtrees
 // Knuth's optimization reduces time complexity from O(n^3) to O(n^2)
-void computeOBST (size_t nProbs, double *probs, double **costs, 
-                  size_t **roots, double **sums) {
-
-  for (size_t i = 0; i < nProbs; ++i) {
-    costs[i][i] = probs[i];
-    roots[i][i] = i;
-  }
-
-  for (size_t l = 2; l <= nProbs; ++l) {
-    for (size_t i = 0; i <= nProbs - l; ++i) {
-      size_t j = i + l - 1;
-      for (size_t r = roots[i][j - 1]; r <= roots[i + 1][j]; ++r) {
-        double leftCost = r == i ? 0 : costs[i][r - 1];
-        double rightCost = r == j ? 0 : costs[r + 1][j];
-        double minCost = leftCost + rightCost + sums[i][j];
-        if (minCost < costs[i][j]) {
-          costs[i][j] = minCost;
-          roots[i][j] = r;
+// The rows are filled from the last one up, so that row i + 1 is
+// complete when row i is filled, and both rows are walked in order
+void computeOBST (size_t nProbs, double *probs, obstTables *T) {
+
+  for (size_t i = nProbs; i-- > 0; ) {
+    double *costs = T->costs + at(T, i, i);
+    double *sums = T->sums + at(T, i, i);
+    size_t *roots = T->roots + at(T, i, i);
+      // the roots of the keys i + 1..j, which bound those of i..j
+    size_t *below = T->roots + at(T, i + 1, i + 1);
+
+    costs[0] = probs[i];
+    roots[0] = i;
+
+    for (size_t j = i + 1; j < nProbs; ++j) {
+      for (size_t r = roots[j - i - 1]; r <= below[j - i - 1]; ++r) {
+        double leftCost = r == i ? 0 : costs[r - 1 - i];
+        double rightCost = r == j ? 0 : T->costs[at(T, r + 1, j)];
+        double minCost = leftCost + rightCost + sums[j - i];
+        if (minCost < costs[j - i]) {
+          costs[j - i] = minCost;
+          roots[j - i] = r;
         }
       }
     }
@@ -44,29 +66,31 @@ void computeOBST (size_t nProbs, double *probs, double **costs,
 // Reconstructs the optimal binary search tree structure from the
 // roots of the subtrees
 void constructOBST (size_t i, size_t j, size_t level,
-                    size_t **roots) {
+                    obstTables *T) {
 
   if (j == i - 1) {
     return;
   } else {
-    constructOBST(i, roots[i][j] - 1, level + 1, roots);
+    size_t root = T->roots[at(T, i, j)];
+    constructOBST(i, root - 1, level + 1, T);
     for (size_t k = 0; k < level; ++k)
       printf("-");
     printf(level ? "| K%zu (%zu)\n" : "K%zu (%zu)\n", 
-           roots[i][j], level);
-    constructOBST(roots[i][j] + 1, j, level + 1, roots);
+           root, level);
+    constructOBST(root + 1, j, level + 1, T);
   }
 }
 
 //===================================================================
 // Precomputes the sums of the probabilities of the keys over each
 // possible range of keys
-void computeSums (size_t nProbs, double *probs, double **sums) {
+void computeSums (size_t nProbs, double *probs, obstTables *T) {
 
   for (size_t i = 0; i < nProbs; ++i) {
-    sums[i][i] = probs[i];
+    double *sums = T->sums + at(T, i, i);
+    sums[0] = probs[i];
     for (size_t j = i + 1; j < nProbs; ++j) 
-      sums[i][j] = sums[i][j - 1] + probs[j];
+      sums[j - i] = sums[j - i - 1] + probs[j];
   }
 }
 
@@ -76,24 +100,29 @@ int main () {
   
   READ(double, probs, "%lf", nProbs);
 
-  CREATE_MATRIX(double, costs, nProbs + 1, nProbs, DBL_MAX);
+  obstTables T = { nProbs };
+  size_t size = nProbs * (nProbs + 1) / 2;
+
+  T.costs = safeCalloc(size, sizeof(double));
+  for (size_t e = 0; e < size; ++e)
+    T.costs[e] = DBL_MAX;
 
-  CREATE_MATRIX(size_t, roots, nProbs, nProbs, 0);
+  T.roots = safeCalloc(size, sizeof(size_t));
 
-  CREATE_MATRIX(double, sums, nProbs + 1, nProbs, 0);
+  T.sums = safeCalloc(size, sizeof(double));
 
-  computeSums(nProbs, probs, sums);
+  computeSums(nProbs, probs, &T);
 
-  computeOBST(nProbs, probs, costs, roots, sums);
+  computeOBST(nProbs, probs, &T);
   
   printf("OBST cost: %.2lf\n\n"
-         "OBST structure:\n\n", costs[0][nProbs - 1]);
+         "OBST structure:\n\n", T.costs[at(&T, 0, nProbs - 1)]);
 
-  constructOBST(0, nProbs - 1, 0, roots);
+  constructOBST(0, nProbs - 1, 0, &T);
 
-  FREE_MATRIX(sums, nProbs + 1);
-  FREE_MATRIX(costs, nProbs + 1);
-  FREE_MATRIX(roots, nProbs);
+  free(T.sums);
+  free(T.costs);
+  free(T.roots);
   free(probs);
 
   return 0;
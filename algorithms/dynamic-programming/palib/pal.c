@@ -0,0 +1,202 @@
+/*
+  file: pal.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: palindromes of a string without a table of all
+    substrings: Manacher's algorithm for the radii around all
+    centres, and the palindromic tree (eertree) for the distinct
+    palindromes, used for a minimal palindromic partitioning
+*/
+
+#include "pal.h"
+
+//===================================================================
+// Returns the radii of all palindromes of S, where the centres are
+// the positions of the string S interleaved with separators, e.g.
+// |a|b|a| for aba: a palindrome of this string has separators at
+// both ends, and its radius equals the length of the palindrome of
+// S that it covers. The radius of a centre c inside the rightmost
+// palindrome found so far is at least that of its mirror image,
+// up to the right end of that palindrome, so that each comparison
+// that succeeds moves the right end; O(n) time
+size_t *palRadii(string *S) {
+
+  size_t n = strLen(S), m = 2 * n + 1;
+  size_t *rad = safeCalloc(m, sizeof(size_t));
+  unsigned char *s = S->data;
+
+    // the rightmost palindrome ends before right, around centre
+  for (size_t c = 0, centre = 0, right = 0; c < m; c++) {
+    size_t r = c < right ? MIN(right - c, rad[2 * centre - c]) : 0;
+      // c - r - 1 and c + r + 1 have the same parity: separators
+      // always match, characters are compared
+    while (r < c && c + r + 1 < m &&
+           ((c - r - 1) % 2 == 0 || s[(c - r - 1) / 2] ==
+                                    s[(c + r + 1) / 2]))
+      r++;
+    rad[c] = r;
+    if (c + r > right) {
+      centre = c;
+      right = c + r;
+    }
+  }
+  return rad;
+}
+
+//===================================================================
+// Returns the length of a longest palindromic substring of S, and
+// sets start to its first index
+size_t palLongest(string *S, size_t *start) {
+
+  size_t *rad = palRadii(S), best = 0;
+  *start = 0;
+    // the leftmost centre is kept on ties, which has the leftmost
+    // start for a given length
+  for (size_t c = 0; c <= 2 * strLen(S); c++)
+    if (rad[c] > best) {
+      best = rad[c];
+      *start = (c - best) / 2;
+    }
+  free(rad);
+  return best;
+}
+
+//===================================================================
+// Creates an empty palindromic tree with its two roots
+palTree *palNewTree(size_t n) {
+  palTree *T = safeCalloc(1, sizeof(palTree));
+  T->cap = n + 2;
+  T->nodes = safeCalloc(T->cap, sizeof(palNode));
+  T->textCap = MAX(n, 1);
+  T->text = safeCalloc(T->textCap, sizeof(unsigned char));
+  T->nNodes = 2;
+    // both roots link to the imaginary one, and their diff differs
+    // from that of any other node
+  T->nodes[0] = (palNode) { 0, 1, 0, 0, 0, 0, 0 };
+  T->nodes[1] = (palNode) { SIZE_MAX, 1, 0, 1, 0, 0, 0 };
+  return T;
+}
+
+//===================================================================
+// Deallocates the tree
+void palFreeTree(palTree *T) {
+  free(T->nodes);
+  free(T->text);
+  free(T);
+}
+
+//===================================================================
+// Returns the first node on the suffix chain starting at v whose
+// palindrome can be extended on both sides by the character at
+// position i of the text; the imaginary root always can
+static size_t extensible(palTree *T, size_t v, size_t i) {
+  unsigned char c = T->text[i];
+  for (;;) {
+    size_t len = T->nodes[v].len;
+    if (len == SIZE_MAX || (len < i && T->text[i - len - 1] == c))
+      return v;
+    v = T->nodes[v].link;
+  }
+}
+
+//===================================================================
+// Returns the child of v along an edge labelled c, or 0 if there
+// is none; node 0 is a root, and never a child
+static size_t childOf(palTree *T, size_t v, unsigned char c) {
+  for (size_t u = T->nodes[v].child; u; u = T->nodes[u].sibling)
+    if (T->nodes[u].ch == c)
+      return u;
+  return 0;
+}
+
+//===================================================================
+// Appends c to the text of the tree: the new longest palindromic
+// suffix is c·P·c for the longest palindromic suffix P of the old
+// text that is preceded by c, and it is the only palindrome of the
+// new text that may not have occurred before
+size_t palAppend(palTree *T, unsigned char c) {
+
+  if (T->len == T->textCap) {
+    T->textCap *= 2;
+    T->text = safeRealloc(T->text, T->textCap);
+  }
+  size_t i = T->len++;
+  T->text[i] = c;
+
+  size_t v = extensible(T, T->last, i), u = childOf(T, v, c);
+  if (u)
+    return T->last = u;
+
+  if (T->nNodes == T->cap) {
+    T->cap *= 2;
+    T->nodes = safeRealloc(T->nodes, T->cap * sizeof(palNode));
+  }
+  u = T->nNodes++;
+  palNode *node = T->nodes + u;
+    // the length of the imaginary root is -1, so that its children
+    // get length 1 (the addition wraps around)
+  node->len = T->nodes[v].len + 2;
+  node->ch = c;
+    // the longest palindromic suffix of c·P·c is c·Q·c for the
+    // longest proper palindromic suffix Q of P preceded by c, which
+    // exists as a node already, or the empty string if P is -1
+  node->link = node->len == 1 ? 0
+             : childOf(T, extensible(T, T->nodes[v].link, i), c);
+  palNode *link = T->nodes + node->link;
+  node->diff = node->len - link->len;
+  node->series = node->diff == link->diff ? link->series : node->link;
+  node->child = 0;
+  node->sibling = T->nodes[v].child;
+  T->nodes[v].child = u;
+  return T->last = u;
+}
+
+//===================================================================
+// Computes a minimal palindromic partitioning of S, where parts[i]
+// is the minimal number of palindromes for the prefix of length i.
+// The palindromic suffixes of a prefix have O(log n) distinct
+// diffs, and those with the same diff form a series u₁, ..., uₖ
+// with lengths in arithmetic progression. For node v at the head
+// of a series, best[v] is the prefix length p before one of its
+// members that minimizes (parts[p], p); apart from the shortest
+// member, these prefixes are those of the series of link(v), which
+// was last visited diff(v) positions ago, so that best[v] follows
+// from best[link(v)] and one new candidate
+size_t palMinPartition(string *S, size_t *prev) {
+
+  size_t n = strLen(S);
+  palTree *T = palNewTree(n);
+  size_t *parts = safeCalloc(n + 1, sizeof(size_t));
+  size_t *best = safeCalloc(n + 2, sizeof(size_t));
+  prev[0] = 0;
+
+  for (size_t i = 1; i <= n; i++) {
+    palAppend(T, charAt(S, i - 1));
+    parts[i] = SIZE_MAX;
+    for (size_t v = T->last; T->nodes[v].len > 0;
+         v = T->nodes[v].series) {
+      palNode *node = T->nodes + v;
+        // the prefix before the shortest member of the series
+      size_t p = i - T->nodes[node->series].len - node->diff;
+      best[v] = p;
+      if (node->diff == T->nodes[node->link].diff) {
+        size_t q = best[node->link];
+        if (parts[q] < parts[p] || (parts[q] == parts[p] && q < p))
+          best[v] = q;
+      }
+      p = best[v];
+      if (parts[p] + 1 < parts[i] ||
+          (parts[p] + 1 == parts[i] && p < prev[i])) {
+        parts[i] = parts[p] + 1;
+        prev[i] = p;
+      }
+    }
+  }
+
+  size_t count = parts[n];
+  palFreeTree(T);
+  free(parts);
+  free(best);
+  return count;
+}
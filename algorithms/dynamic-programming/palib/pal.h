@@ -0,0 +1,80 @@
+#ifndef PAL_H_INCLUDED
+#define PAL_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "../../../lib/clib.h"
+
+//::::::::::::::::::::::::::: MANACHER ::::::::::::::::::::::::::://
+
+  // Returns the radii of all palindromes of S, found by Manacher's
+  // algorithm in O(n) time: there are 2n + 1 centres, where centre
+  // 2k + 1 lies on the character S[k] and centre 2k between the
+  // characters S[k - 1] and S[k], and rad[c] is the length of the
+  // longest palindrome around centre c
+size_t *palRadii(string *S);
+
+  // Returns true if S[i..j] is a palindrome, given the radii of S;
+  // this takes O(1) time, as the centre of S[i..j] is i + j + 1
+static inline bool palIsPalindrome(size_t *rad, size_t i, size_t j) {
+  return rad[i + j + 1] >= j - i + 1;
+}
+
+  // Returns the length of a longest palindromic substring of S,
+  // and sets start to its first index; on ties, the leftmost one
+  // is chosen; O(n) time
+size_t palLongest(string *S, size_t *start);
+
+//::::::::::::::::::::::::: PALINDROMIC TREE :::::::::::::::::::::::://
+
+  // A node of the palindromic tree (eertree), which stands for one
+  // distinct palindromic substring. Node 0 is the empty string, and
+  // node 1 an imaginary string of length -1, so that adding a
+  // character on both sides of it gives a single character
+typedef struct {
+  size_t len;             // length of the palindrome (SIZE_MAX: -1)
+  size_t link;            // node of its longest palindromic suffix
+  size_t diff;            // len minus the length of link
+  size_t series;          // the first suffix whose diff differs
+  size_t child, sibling;  // first child, and next child of parent
+  unsigned char ch;       // the character added by the parent edge
+} palNode;
+
+  // The palindromic tree of a text that grows one character at a
+  // time, which holds at most n + 2 nodes for a text of length n
+typedef struct {
+  palNode *nodes;
+  size_t nNodes, cap;     // number of nodes, and capacity
+  unsigned char *text;    // the text so far
+  size_t len, textCap;    // its length, and capacity
+  size_t last;            // node of the longest palindromic suffix
+} palTree;
+
+  // Creates an empty palindromic tree for a text of about n
+  // characters; the tree grows if the text gets longer
+palTree *palNewTree(size_t n);
+
+  // Deallocates the tree
+void palFreeTree(palTree *T);
+
+  // Appends c to the text of the tree in amortized O(σ) time, where
+  // σ is the alphabet size, and returns the node of the longest
+  // palindromic suffix of the new text
+size_t palAppend(palTree *T, unsigned char c);
+
+  // Returns the number of distinct non-empty palindromic substrings
+  // of the text of the tree
+static inline size_t palCount(palTree *T) {
+  return T->nNodes - 2;
+}
+
+  // Returns the minimal number of palindromes that S can be split
+  // into, where prev[i] is set to the length of the prefix before
+  // the last palindrome of an optimal split of the prefix of length
+  // i; prev must hold n + 1 entries. On ties, the last palindrome
+  // is the longest one. The palindromic suffixes of each prefix are
+  // handled in O(log n) series of the tree, which gives O(n log n)
+  // time and O(n) space
+size_t palMinPartition(string *S, size_t *prev);
+
+#endif // PAL_H_INCLUDED
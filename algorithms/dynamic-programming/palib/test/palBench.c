@@ -0,0 +1,131 @@
+/*
+  Benchmark of the minimal palindromic partitioning: the bottom-up
+    DP of mpp-3.c with the full table of palindromes as before, the
+    same DP with the radii of Manacher's algorithm as it is now, and
+    the series of the palindromic tree as in mpp-4.c; the time to
+    find a longest palindromic substring is shown as well
+  For each length n, a random string over {a, b} is used, which has
+    many palindromes; the DPs only run up to maxDP characters, since
+    they take quadratic time. The numbers of cuts are compared, and
+    the memory column shows the bytes of the tables
+  Usage: ./palBench.out [maxN] [maxDP]
+  Author: David De Potter
+*/
+
+#include "../pal.h"
+#include <time.h>
+
+//===================================================================
+// Returns the minimal number of cuts, using the DP of mpp-3.c with
+// the full table of palindromes
+size_t partitionTable(string *S) {
+  size_t n = strLen(S);
+  CREATE_MATRIX(bool, pal, n, n, false);
+  for (size_t i = n; i--; )
+    for (size_t j = i; j < n; j++)
+      if (i == j) pal[i][j] = true;
+      else if (charAt(S, i) == charAt(S, j))
+        pal[i][j] = j - i == 1 ? true : pal[i + 1][j - 1];
+
+  CREATE_ARRAY(size_t, dp, n, SIZE_MAX);
+  for (size_t i = 0; i < n; i++)
+    if (pal[0][i])
+      dp[i] = 0;
+    else
+      for (size_t j = 0; j < i; j++)
+        if (pal[j + 1][i] && dp[j] + 1 < dp[i])
+          dp[i] = dp[j] + 1;
+
+  size_t cuts = dp[n - 1];
+  FREE_MATRIX(pal, n);
+  free(dp);
+  return cuts;
+}
+
+//===================================================================
+// Returns the minimal number of cuts, using the same DP with the
+// radii of all palindromes
+size_t partitionRadii(string *S) {
+  size_t n = strLen(S), *rad = palRadii(S);
+  CREATE_ARRAY(size_t, dp, n, SIZE_MAX);
+  for (size_t i = 0; i < n; i++)
+    if (palIsPalindrome(rad, 0, i))
+      dp[i] = 0;
+    else
+      for (size_t j = 0; j < i; j++)
+        if (palIsPalindrome(rad, j + 1, i) && dp[j] + 1 < dp[i])
+          dp[i] = dp[j] + 1;
+
+  size_t cuts = dp[n - 1];
+  free(rad);
+  free(dp);
+  return cuts;
+}
+
+//===================================================================
+// Returns the minimal number of cuts, using the palindromic tree
+size_t partitionTree(string *S) {
+  size_t *prev = safeCalloc(strLen(S) + 1, sizeof(size_t));
+  size_t cuts = palMinPartition(S, prev) - 1;
+  free(prev);
+  return cuts;
+}
+
+//===================================================================
+// Returns the time in seconds since start
+double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+// Shows a row of the table: the name of an algorithm, its time,
+// its memory in KB, and its result, compared against ref
+void showRow(char const *name, double time, size_t bytes,
+             size_t result, size_t ref) {
+  printf("  %-10s  %9.4fs  %12zu  %10zu%s\n", name, time,
+         bytes / 1024, result, result != ref ? " (wrong!)" : "");
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxN = argc > 1 ? strtoul(argv[1], NULL, 10) : 1 << 20;
+  size_t maxDP = argc > 2 ? strtoul(argv[2], NULL, 10) : 8000;
+  srand(42);
+
+  for (size_t n = 1000; n <= maxN; n *= 2) {
+    string *S = newString(n + 1);
+    for (size_t i = 0; i < n; i++)
+      S->data[i] = "ab"[rand() % 2];
+    S->size = n;
+
+    printf("n = %zu\n", n);
+    printf("  %-10s  %10s  %12s  %10s\n", "algorithm", "time",
+           "memory (KB)", "result");
+
+    clock_t start = clock();
+    size_t ref = partitionTree(S);
+    double time = elapsed(start);
+
+    if (n <= maxDP) {
+      start = clock();
+      size_t cuts = partitionTable(S);
+      showRow("table", elapsed(start), n * (n + 16), cuts, ref);
+      start = clock();
+      cuts = partitionRadii(S);
+      showRow("radii", elapsed(start), (3 * n + 1) * sizeof(size_t),
+              cuts, ref);
+    }
+    showRow("eertree", time, (n + 2) * (sizeof(palNode) +
+            3 * sizeof(size_t)) + n, ref, ref);
+
+      // the longest palindromic substring, which is only shown
+    start = clock();
+    size_t first, len = palLongest(S, &first);
+    showRow("longest", elapsed(start), (2 * n + 1) * sizeof(size_t),
+            len, len);
+    printf("\n");
+    freeString(S);
+  }
+  return 0;
+}
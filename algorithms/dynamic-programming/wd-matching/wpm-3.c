@@ -4,40 +4,65 @@
   email: pl3onasm@gmail.com
   license: MIT, see LICENSE file in repository root folder
   description: wildcard pattern matching
-    using a bottom-up DP approach
-  time complexity: O(n*m)
+    using a bottom-up DP approach, where the table is filled in 
+    anti-diagonal wavefront order by a pool of threads, one tile
+    at a time (see ../wflib/wf.c)
+  time complexity: O(n*m), or O(n*m/p) on p processors
   space complexity: O(n*m)
 */
 
 #include "../../../lib/clib.h"
+#include "../wflib/wf.h"
+
+  // The source and pattern strings, and the (|src| + 1) x 
+  // (|ptn| + 1) table, which is stored row by row in a single 
+  // contiguous block
+typedef struct {
+  string *src, *ptn;
+  bool *dp;
+  size_t cols;
+} wpmTable;
+
+//===================================================================
+// Fills the entries (i, j) of the table for i in (r0, r1] and j in 
+// (c0, c1], given that the entries above and to the left of them 
+// are known
+void wpmKernel(size_t r0, size_t r1, size_t c0, size_t c1, 
+               void *arg) {
+
+  wpmTable *W = arg;
+  for (size_t i = r0 + 1; i <= r1; ++i) {
+    bool *row = W->dp + i * W->cols, *up = row - W->cols;
+    for (size_t j = c0 + 1; j <= c1; ++j) {
+      if (charAt(W->src, i - 1) == charAt(W->ptn, j - 1) 
+          || charAt(W->ptn, j - 1) == '?')
+        row[j] = up[j - 1];
+      else if (charAt(W->ptn, j - 1) == '*')
+        row[j] = row[j - 1] || up[j];
+    }
+  }
+}
 
 //===================================================================
 // Bottom-up DP approach to determine if a source string matches
 // a pattern string with wildcards
-bool matchPattern (string *src, string *ptn, bool **dp) {
+bool matchPattern (wpmTable *W) {
     
     // base case: source is empty and pattern is empty;
     // match is true
-  dp[0][0] = true;
+  W->dp[0] = true;
 
     // base case: source is empty but pattern is not;
     // check if the remaining pattern chars are all '*'
-  for (size_t i = 1; i <= strLen(ptn); ++i) 
-    if (charAt(ptn, i - 1) == '*') 
-      dp[0][i] = dp[0][i - 1];
+  for (size_t i = 1; i <= strLen(W->ptn); ++i) 
+    if (charAt(W->ptn, i - 1) == '*') 
+      W->dp[i] = W->dp[i - 1];
 
     // fill the rest of the table using the recursive formula
-  for (size_t i = 1; i <= strLen(src); ++i) {
-    for (size_t j = 1; j <= strLen(ptn); ++j) {
-      if (charAt(src, i - 1) == charAt(ptn, j - 1) 
-          || charAt(ptn, j - 1) == '?')
-        dp[i][j] = dp[i - 1][j - 1];
-      else if (charAt(ptn, j - 1) == '*')
-        dp[i][j] = dp[i][j - 1] || dp[i - 1][j];
-    }
-  }
+  wfRun(strLen(W->src), strLen(W->ptn), WF_TILE, wpmKernel, W, 
+        wfProcessors());
 
-  return dp[strLen(src)][strLen(ptn)];
+  return W->dp[strLen(W->src) * W->cols + strLen(W->ptn)];
 }
 
 //===================================================================
@@ -49,13 +74,14 @@ int main () {
   READ_STRING(ptn, '\n');
 
     // allocate memoization table
-  CREATE_MATRIX(bool, dp, strLen(src) + 1, strLen(ptn) + 1, false);
+  wpmTable W = { src, ptn, NULL, strLen(ptn) + 1 };
+  W.dp = safeCalloc((strLen(src) + 1) * W.cols, sizeof(bool));
 
     // check if source matches pattern
   printf("Match: %s\n", 
-          matchPattern(src, ptn, dp) ? "true" : "false");
+          matchPattern(&W) ? "true" : "false");
 
-  FREE_MATRIX(dp, strLen(src) + 1);
+  free(W.dp);
   freeString(src);
   freeString(ptn);
 
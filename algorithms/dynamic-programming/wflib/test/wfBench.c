@@ -0,0 +1,198 @@
+/*
+  Benchmark of the wavefront executor on the DPs of lcs-3.c,
+    med-4.c (Levenshtein costs), lps-3.c and wpm-3.c for two
+    random strings of n characters
+  Only the score in the corner of the table is computed, so that a
+    tile only keeps its last row and column: the tiles of a tile
+    row store their last row in one array, and those of a tile
+    column their last column, which takes O(n²/tile) space instead
+    of O(n²) for the whole table
+  Each DP is run row by row on one thread, and with the wavefront
+    executor on 1 up to maxThreads threads; the speedup is relative
+    to the executor on a single thread, and the scores are compared
+  Usage: ./wfBench.out [n] [maxThreads]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include "../wf.h"
+#include <stdint.h>
+#include <time.h>
+
+  // The input of a DP over an (m + 1) x (n + 1) table, and the last
+  // rows and columns of its tiles
+typedef struct {
+  unsigned char *x, *y;     // the strings of the rows and columns
+  size_t m, n, tile;        // size of the table and the tiles
+  size_t stars;             // length of the prefix of *'s of y
+  uint32_t **lastRow;       // per tile row: its last row
+  uint32_t **lastCol;       // per tile column: its last column
+} problem;
+
+  // the entries in row 0 and column 0, and the recurrences for the
+  // other entries (i, j) in terms of the entries diagonally above,
+  // above and to the left of it
+#define LCS_BASE(P, i, j) 0
+#define LCS_CELL(P, i, j, diag, up, left) \
+  ((P)->x[(i) - 1] == (P)->y[(j) - 1] ? (diag) + 1 : MAX(up, left))
+
+#define MED_BASE(P, i, j) ((i) + (j))
+#define MED_CELL(P, i, j, diag, up, left) \
+  MIN((diag) + ((P)->x[(i) - 1] != (P)->y[(j) - 1]), \
+      MIN(up, left) + 1)
+
+  // the rows are taken in reverse order: entry (i, j) of the table
+  // is the LPS length of x[n - i..j - 1]
+#define LPS_BASE(P, i, j) 0
+#define LPS_CELL(P, i, j, diag, up, left) \
+  ((P)->n - (i) > (j) - 1 ? 0 : (P)->n - (i) == (j) - 1 ? 1 : \
+   (P)->x[(P)->n - (i)] == (P)->x[(j) - 1] ? (diag) + 2 : \
+   MAX(up, left))
+
+#define WPM_BASE(P, i, j) ((i) == 0 && (j) <= (P)->stars)
+#define WPM_CELL(P, i, j, diag, up, left) \
+  ((P)->x[(i) - 1] == (P)->y[(j) - 1] || (P)->y[(j) - 1] == '?' ? \
+   (diag) : (P)->y[(j) - 1] == '*' ? (up) || (left) : 0)
+
+  // Defines the functions that compute the score of a DP: name##Rows
+  // fills the table row by row, keeping only the previous row, and
+  // name##Tile is the kernel of the wavefront executor, which reads
+  // the last row of the tile above and the last column of the tile
+  // to the left; the first entry of a last row is written by the
+  // tile to the left, so that no entry is written twice
+#define DEFINE_DP(name, BASE, CELL) \
+uint32_t name##Rows(problem *P) { \
+  uint32_t *prev = safeCalloc(P->n + 1, sizeof(uint32_t)); \
+  uint32_t *cur = safeCalloc(P->n + 1, sizeof(uint32_t)); \
+  for (size_t j = 0; j <= P->n; j++) \
+    prev[j] = BASE(P, 0, j); \
+  for (size_t i = 1; i <= P->m; i++) { \
+    cur[0] = BASE(P, i, 0); \
+    for (size_t j = 1; j <= P->n; j++) \
+      cur[j] = CELL(P, i, j, prev[j - 1], prev[j], cur[j - 1]); \
+    uint32_t *tmp = prev; prev = cur; cur = tmp; \
+  } \
+  uint32_t score = prev[P->n]; \
+  free(prev); \
+  free(cur); \
+  return score; \
+} \
+\
+void name##Tile(size_t r0, size_t r1, size_t c0, size_t c1, \
+                void *arg) { \
+  problem *P = arg; \
+  size_t R = r0 / P->tile, C = c0 / P->tile, w = c1 - c0; \
+  uint32_t rows[2][w + 1], *prev = rows[0], *cur = rows[1]; \
+  for (size_t k = 0; k <= w; k++) \
+    prev[k] = R ? P->lastRow[R - 1][c0 + k] : BASE(P, 0, c0 + k); \
+  for (size_t i = r0 + 1; i <= r1; i++) { \
+    cur[0] = C ? P->lastCol[C - 1][i] : BASE(P, i, 0); \
+    for (size_t k = 1, j = c0 + 1; k <= w; k++, j++) \
+      cur[k] = CELL(P, i, j, prev[k - 1], prev[k], cur[k - 1]); \
+    P->lastCol[C][i] = cur[w]; \
+    uint32_t *tmp = prev; prev = cur; cur = tmp; \
+  } \
+  memcpy(P->lastRow[R] + c0 + (C > 0), prev + (C > 0), \
+         (w + (C == 0)) * sizeof(uint32_t)); \
+}
+
+DEFINE_DP(lcs, LCS_BASE, LCS_CELL)
+DEFINE_DP(med, MED_BASE, MED_CELL)
+DEFINE_DP(lps, LPS_BASE, LPS_CELL)
+DEFINE_DP(wpm, WPM_BASE, WPM_CELL)
+
+//===================================================================
+// Returns the time in seconds since start, measured on the wall
+// clock, since the threads share the processor time
+double elapsed(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) +
+         (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+//===================================================================
+// Runs a DP row by row, and with the wavefront executor on 1 up to
+// maxThreads threads, and shows the times and speedups
+void bench(char const *name, problem *P, uint32_t (*rows)(problem *),
+           wfKernel tile, size_t maxThreads) {
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  uint32_t score = rows(P);
+  printf("%6s  %8s  %9.4fs  %8s  %10u\n", name, "rows",
+         elapsed(&start), "", score);
+
+  size_t tileRows = (P->m - 1) / P->tile + 1;
+  double single = 0;
+  for (size_t t = 1; t <= maxThreads; t++) {
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    wfRun(P->m, P->n, P->tile, tile, P, t);
+    double time = elapsed(&start);
+    if (t == 1)
+      single = time;
+    uint32_t wfScore = P->lastRow[tileRows - 1][P->n];
+    printf("%6s  %8zu  %9.4fs  %8.2f  %10u%s\n", name, t, time,
+           single / time, wfScore, wfScore != score ? " (wrong!)"
+                                                     : "");
+  }
+}
+
+//===================================================================
+// Returns a random string of n characters over {A, C, G, T}
+unsigned char *randomString(size_t n) {
+  unsigned char *s = safeCalloc(n + 1, sizeof(unsigned char));
+  for (size_t i = 0; i < n; i++)
+    s[i] = "ACGT"[rand() % 4];
+  return s;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 50000;
+  size_t maxThreads = argc > 2 ? strtoul(argv[2], NULL, 10)
+                               : wfProcessors();
+  srand(42);
+  n = MAX(n, 1);
+
+  problem P = { randomString(n), randomString(n), n, n, WF_TILE };
+    // the table is square, so that there are as many tile rows as 
+    // tile columns
+  size_t tileRows = (n - 1) / P.tile + 1;
+  P.lastRow = safeCalloc(tileRows, sizeof(uint32_t *));
+  P.lastCol = safeCalloc(tileRows, sizeof(uint32_t *));
+  for (size_t t = 0; t < tileRows; t++) {
+    P.lastRow[t] = safeCalloc(n + 1, sizeof(uint32_t));
+    P.lastCol[t] = safeCalloc(n + 1, sizeof(uint32_t));
+  }
+
+  printf("n = %zu, tiles of %zu x %zu\n\n", n, P.tile, P.tile);
+  printf("%6s  %8s  %10s  %8s  %10s\n", "dp", "threads", "time",
+         "speedup", "score");
+  bench("lcs", &P, lcsRows, lcsTile, maxThreads);
+  bench("med", &P, medRows, medTile, maxThreads);
+  bench("lps", &P, lpsRows, lpsTile, maxThreads);
+
+    // a pattern with a wildcard for about every 20th character of
+    // the source, with a leading *
+  unsigned char *ptn = P.y;
+  memcpy(ptn, P.x, n);
+  for (size_t i = 0; i < n; i++)
+    if (rand() % 20 == 0)
+      ptn[i] = rand() % 2 ? '*' : '?';
+  ptn[0] = '*';
+  while (P.stars < n && ptn[P.stars] == '*')
+    P.stars++;
+  bench("wpm", &P, wpmRows, wpmTile, maxThreads);
+
+  for (size_t t = 0; t < tileRows; t++) {
+    free(P.lastRow[t]);
+    free(P.lastCol[t]);
+  }
+  free(P.lastRow);
+  free(P.lastCol);
+  free(P.x);
+  free(P.y);
+  return 0;
+}
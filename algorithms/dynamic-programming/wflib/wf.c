@@ -0,0 +1,139 @@
+/*
+  file: wf.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: anti-diagonal wavefront executor for 2D DP tables,
+    which runs the tiles of the table on a pool of threads as soon
+    as their dependencies are done
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include "wf.h"
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+  // The state shared by the threads of the pool. The tiles are 
+  // numbered row by row; a tile is pushed on the ready queue once 
+  // its number of pending dependencies drops to 0, so that each 
+  // tile enters the queue exactly once
+typedef struct {
+  wfKernel kernel;
+  void *arg;
+  size_t rows, cols, tile;        // size of the table and the tiles
+  size_t tileRows, tileCols;      // number of tiles per column/row
+  uint8_t *pending;               // unfinished dependencies per tile
+  size_t *queue;                  // the ready tiles, in FIFO order
+  size_t head, tail;              // the ready part of the queue
+  size_t done;                    // number of finished tiles
+  pthread_mutex_t lock;
+  pthread_cond_t ready;           // signals new tiles or the end
+} wavefront;
+
+//===================================================================
+// Runs the kernel on tile t
+static void runTile(wavefront *W, size_t t) {
+  size_t r0 = t / W->tileCols * W->tile;
+  size_t c0 = t % W->tileCols * W->tile;
+  W->kernel(r0, MIN(W->rows, r0 + W->tile), 
+            c0, MIN(W->cols, c0 + W->tile), W->arg);
+}
+
+//===================================================================
+// Marks tile t as done, and pushes the tiles to the right of it and 
+// below it on the queue if they have no pending dependencies left;
+// the lock must be held
+static void finishTile(wavefront *W, size_t t) {
+  size_t total = W->tileRows * W->tileCols;
+  bool wake = ++W->done == total;
+  if (t % W->tileCols + 1 < W->tileCols && ! --W->pending[t + 1]) {
+    W->queue[W->tail++] = t + 1;
+    wake = true;
+  }
+  if (t / W->tileCols + 1 < W->tileRows && 
+      ! --W->pending[t + W->tileCols]) {
+    W->queue[W->tail++] = t + W->tileCols;
+    wake = true;
+  }
+  if (wake) 
+    pthread_cond_broadcast(&W->ready);
+}
+
+//===================================================================
+// Takes ready tiles from the queue and runs them, until all tiles
+// are done
+static void *worker(void *arg) {
+  wavefront *W = arg;
+  size_t total = W->tileRows * W->tileCols;
+
+  pthread_mutex_lock(&W->lock);
+  while (true) {
+    while (W->head == W->tail && W->done < total)
+      pthread_cond_wait(&W->ready, &W->lock);
+    if (W->head == W->tail) 
+      break;
+    size_t t = W->queue[W->head++];
+    pthread_mutex_unlock(&W->lock);
+    runTile(W, t);
+    pthread_mutex_lock(&W->lock);
+    finishTile(W, t);
+  }
+  pthread_mutex_unlock(&W->lock);
+  return NULL;
+}
+
+//===================================================================
+// Computes a DP table of rows x cols entries in wavefront order
+void wfRun(size_t rows, size_t cols, size_t tile, wfKernel kernel,
+           void *arg, size_t nThreads) {
+
+  if (rows == 0 || cols == 0)
+    return;
+  tile = MAX(tile, 1);
+  wavefront W = { kernel, arg, rows, cols, tile, 
+                  (rows - 1) / tile + 1, (cols - 1) / tile + 1 };
+  size_t total = W.tileRows * W.tileCols;
+
+    // a single thread can simply run the tiles row by row
+  nThreads = MAX(1, MIN(nThreads, MIN(W.tileRows, W.tileCols)));
+  if (nThreads == 1) {
+    for (size_t t = 0; t < total; t++) 
+      runTile(&W, t);
+    return;
+  }
+
+    // a tile depends on the tile above it and the tile to the left
+    // of it, which in turn depend on the tile diagonally above it
+  W.pending = safeCalloc(total, sizeof(uint8_t));
+  W.queue = safeCalloc(total, sizeof(size_t));
+  for (size_t t = 0; t < total; t++) 
+    W.pending[t] = (t % W.tileCols > 0) + (t / W.tileCols > 0);
+  W.queue[W.tail++] = 0;
+  pthread_mutex_init(&W.lock, NULL);
+  pthread_cond_init(&W.ready, NULL);
+
+    // the calling thread is one of the workers of the pool
+  pthread_t *threads = safeCalloc(nThreads - 1, sizeof(pthread_t));
+  for (size_t i = 0; i < nThreads - 1; i++) 
+    if (pthread_create(threads + i, NULL, worker, &W) != 0) {
+      fprintf(stderr, "Error: could not create thread\n");
+      exit(EXIT_FAILURE);
+    }
+  worker(&W);
+  for (size_t i = 0; i < nThreads - 1; i++) 
+    pthread_join(threads[i], NULL);
+
+  pthread_mutex_destroy(&W.lock);
+  pthread_cond_destroy(&W.ready);
+  free(threads);
+  free(W.pending);
+  free(W.queue);
+}
+
+//===================================================================
+// Returns the number of processors that are online
+size_t wfProcessors(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? n : 1;
+}
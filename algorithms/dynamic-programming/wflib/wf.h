@@ -0,0 +1,29 @@
+#ifndef WF_H_INCLUDED
+#define WF_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "../../../lib/clib.h"
+
+  // The default number of rows and columns of a tile
+#define WF_TILE 256
+
+  // Computes the entries in rows [r0, r1) and columns [c0, c1) of a
+  // DP table, given that all entries above and to the left of this 
+  // tile have been computed
+typedef void (*wfKernel)(size_t r0, size_t r1, size_t c0, size_t c1,
+                         void *arg);
+
+  // Computes a DP table of rows x cols entries, where each entry 
+  // only depends on entries above and to the left of it, by running 
+  // the kernel on tiles of tile x tile entries in anti-diagonal 
+  // wavefront order: a tile becomes ready as soon as the tiles above
+  // and to the left of it are done, and the ready tiles are run 
+  // concurrently by a pool of nThreads threads
+void wfRun(size_t rows, size_t cols, size_t tile, wfKernel kernel,
+           void *arg, size_t nThreads);
+
+  // Returns the number of processors that are online
+size_t wfProcessors(void);
+
+#endif // WF_H_INCLUDED
@@ -1,9 +1,9 @@
-/* 
+/*
   file: fft.c
   author: David De Potter
   email: pl3onasm@gmail.com
   license: MIT, see LICENSE file in repository root folder
-  description: FFT implementation 
+  description: FFT implementation
 */
 
 #include "../../../lib/clib.h"
@@ -19,94 +19,197 @@ static size_t getPow2(size_t n) {
 }
 
 //===================================================================
-// Returns the fast fourier transform of an array of complex numbers
-// given the length of the array and the nth root of unity. This is
-// an implementation of the Cooley-Tukey algorithm
-static cdbl *_fft(cdbl *arr, size_t len, cdbl ωn) {
-  
-  if (len == 1) 
-    return arr;
-
-  cdbl ω = 1;
-  cdbl *evenXs = safeCalloc(len/2, sizeof(cdbl)); 
-  cdbl *oddXs = safeCalloc(len/2, sizeof(cdbl));
-
-    // DIVIDE the array into even and odd parts of length len/2
-  for (size_t i = 0; i < len/2; ++i) {
-    evenXs[i] = arr[2 * i];
-    oddXs[i] = arr[2 * i + 1];
-  }
-  
-    // CONQUER: compute FFT of even and odd parts
-  cdbl *evenYs = _fft(evenXs, len/2, ωn * ωn);
-  cdbl *oddYs = _fft(oddXs, len/2, ωn * ωn);
-  
-    // COMBINE: compute FFT of the original array
-  cdbl *y = safeCalloc(len, sizeof(cdbl));
-  for (size_t i = 0; i < len/2; ++i) {
-    y[i] = evenYs[i] + ω * oddYs[i];
-    y[i + len/2] = evenYs[i] - ω * oddYs[i];
-    ω *= ωn;
-  }
+// Returns the product of two complex numbers; written out, so that
+// the compiler does not call the slow library routine that handles
+// infinities and NaNs
+static inline cdbl cmul(cdbl a, cdbl b) {
+  return (creal(a) * creal(b) - cimag(a) * cimag(b)) +
+         (creal(a) * cimag(b) + cimag(a) * creal(b)) * I;
+}
+
+//===================================================================
+// Creates a plan for transforms of length n
+fftPlan *fftPlanNew(size_t n) {
+
+  fftPlan *plan = safeCalloc(1, sizeof(fftPlan));
+  plan->n = n = getPow2(n);
+  plan->rev = safeCalloc(n, sizeof(size_t));
+  plan->roots = safeCalloc(n, sizeof(cdbl));
+
+    // rev[i] is i with its log2(n) bits reversed
+  for (size_t i = 1; i < n; ++i)
+    plan->rev[i] = (plan->rev[i >> 1] >> 1) | ((i & 1) ? n >> 1 : 0);
+
+    // each root is computed directly, instead of as a running
+    // product, so that rounding errors do not accumulate
+  for (size_t len = 2; len <= n; len <<= 1)
+    for (size_t j = 0; j < len / 2; ++j)
+      plan->roots[len / 2 + j] = cexp(2 * PI * I * j / len);
+
+  return plan;
+}
+
+//===================================================================
+// Deallocates a plan
+void fftPlanFree(fftPlan *plan) {
+  if (! plan)
+    return;
+  free(plan->rev);
+  free(plan->roots);
+  free(plan);
+}
 
-  free(evenXs); free(oddXs); 
-  if (len > 2) {
-    free(evenYs); 
-    free(oddYs);
+//===================================================================
+// Computes the forward fast fourier transform of the array in and
+// stores the result in out. This is an iterative, in-place version
+// of the Cooley-Tukey algorithm: the input is put in bit-reversed
+// order, after which the butterflies are computed bottom-up, one
+// stage at a time, for subproblems of length 2, 4, ..., n
+void fftExecute(fftPlan *plan, cdbl *in, cdbl *out) {
+
+  size_t n = plan->n;
+
+    // put the input in bit-reversed order
+  if (in == out) {
+    for (size_t i = 0; i < n; ++i)
+      if (i < plan->rev[i]) {
+        cdbl tmp = out[i];
+        out[i] = out[plan->rev[i]];
+        out[plan->rev[i]] = tmp;
+      }
+  } else
+    for (size_t i = 0; i < n; ++i)
+      out[plan->rev[i]] = in[i];
+
+    // COMBINE the transforms of the two halves of each subproblem
+  for (size_t len = 2; len <= n; len <<= 1) {
+    size_t half = len / 2;
+    cdbl *ω = plan->roots + half;
+    for (size_t i = 0; i < n; i += len)
+      for (size_t j = 0; j < half; ++j) {
+        cdbl u = out[i + j];
+        cdbl v = cmul(ω[j], out[i + j + half]);
+        out[i + j] = u + v;
+        out[i + j + half] = u - v;
+      }
   }
-  return y;
 }
 
 //===================================================================
-// Returns the (forward) fast fourier transform of an input array of 
-// complex numbers
+// Computes the backward fast fourier transform of the array in and
+// stores the result in out, using the identity
+// ifft(x) = conj(fft(conj(x))) / n
+void ifftExecute(fftPlan *plan, cdbl *in, cdbl *out) {
+
+  size_t n = plan->n;
+  for (size_t i = 0; i < n; ++i)
+    out[i] = conj(in[i]);
+  fftExecute(plan, out, out);
+  for (size_t i = 0; i < n; ++i)
+    out[i] = conj(out[i]) / n;
+}
+
+//===================================================================
+// Returns the (forward) fast fourier transform of an input array of
+// complex numbers, zero-padded to the next power of 2
 cdbl *fft(cdbl *arr, size_t arrLen) {
-  
-  cdbl ω = cexp(2 * PI * I / arrLen);
-  cdbl *res = _fft(arr, arrLen, ω);
+
+  fftPlan *plan = fftPlanNew(arrLen);
+  cdbl *res = safeCalloc(plan->n, sizeof(cdbl));
+    // the plan's length may exceed arrLen, so the transform is
+    // computed in place on a zero-padded copy of the input
+  memcpy(res, arr, arrLen * sizeof(cdbl));
+  fftExecute(plan, res, res);
+  fftPlanFree(plan);
   return res;
 }
 
 //===================================================================
 // Returns the inverse (backward) fast fourier transform of an input
-// array of complex numbers 
+// array of complex numbers, zero-padded to the next power of 2
 cdbl *ifft(cdbl *arr, size_t arrLen) {
-  
-  cdbl ω = cexp(-2 * PI * I / arrLen);
-  cdbl *inv = _fft(arr, arrLen, ω);
-  for (size_t i = 0; i < arrLen; ++i) 
-    inv[i] /= arrLen;
+
+  fftPlan *plan = fftPlanNew(arrLen);
+  cdbl *inv = safeCalloc(plan->n, sizeof(cdbl));
+    // the plan's length may exceed arrLen, so the transform is
+    // computed in place on a zero-padded copy of the input
+  memcpy(inv, arr, arrLen * sizeof(cdbl));
+  ifftExecute(plan, inv, inv);
+  fftPlanFree(plan);
   return inv;
 }
 
 //===================================================================
 // Returns the convolution of two input arrays representing complex
-// coefficients of polynomials 
+// coefficients of polynomials
 cdbl *convolve(cdbl *x, cdbl *y, size_t xLen, size_t yLen) {
-  
-  size_t len = getPow2(MAX(xLen, yLen) * 2);
 
-  cdbl *x2 = safeCalloc(len, sizeof(cdbl));
-  cdbl *y2 = safeCalloc(len, sizeof(cdbl));
+  fftPlan *plan = fftPlanNew(MAX(xLen, yLen) * 2);
+  size_t len = plan->n;
+
+  cdbl *fftX = safeCalloc(len, sizeof(cdbl));
+  cdbl *fftY = safeCalloc(len, sizeof(cdbl));
 
-    // copy x and y into x2 and y2 
-  memcpy(x2, x, xLen * sizeof(cdbl));
-  memcpy(y2, y, yLen * sizeof(cdbl));
+    // copy x and y into the zero-padded arrays fftX and fftY
+  memcpy(fftX, x, xLen * sizeof(cdbl));
+  memcpy(fftY, y, yLen * sizeof(cdbl));
 
-    // compute FFT of x2 and y2
-  cdbl *fftX = fft(x2, len);
-  cdbl *fftY = fft(y2, len);
+    // compute FFT of both arrays in place
+  fftExecute(plan, fftX, fftX);
+  fftExecute(plan, fftY, fftY);
 
     // compute product of fftX and fftY
-  cdbl *fftXY = safeCalloc(len, sizeof(cdbl));
-  for (size_t i = 0; i < len; ++i) 
-    fftXY[i] = fftX[i] * fftY[i];
+  for (size_t i = 0; i < len; ++i)
+    fftX[i] = cmul(fftX[i], fftY[i]);
 
-    // compute inverse FFT of fftXY
-  cdbl *conv = ifft(fftXY, len);
+    // compute inverse FFT of the product
+  ifftExecute(plan, fftX, fftX);
 
-  free(x2); free(y2);
-  free(fftX); free(fftY); free(fftXY);
+  free(fftY);
+  fftPlanFree(plan);
+  return fftX;
+}
+
+//===================================================================
+// Returns the convolution of two input arrays representing real
+// coefficients of polynomials. Both arrays are packed into a single
+// complex array z = x + iy, so that one forward transform suffices:
+// with Z = fft(z) and k' = (n - k) mod n, we have
+//   X[k] = (Z[k] + conj(Z[k'])) / 2
+//   Y[k] = (Z[k] - conj(Z[k'])) / 2i
+// so that the transform of the convolution is given by
+//   X[k] * Y[k] = (Z[k]² - conj(Z[k'])²) / 4i
+double *convolveReal(double *x, double *y, size_t xLen,
+                     size_t yLen) {
+
+  size_t resLen = xLen + yLen - 1;
+  fftPlan *plan = fftPlanNew(resLen);
+  size_t n = plan->n;
+
+  cdbl *z = safeCalloc(n, sizeof(cdbl));
+  for (size_t i = 0; i < xLen; ++i)
+    z[i] = x[i];
+  for (size_t i = 0; i < yLen; ++i)
+    z[i] += y[i] * I;
+  fftExecute(plan, z, z);
+
+    // compute the product transform in place, pairing k with k'
+  for (size_t k = 0; k <= n / 2; ++k) {
+    size_t k2 = (n - k) & (n - 1);
+    cdbl a = cmul(z[k], z[k]), b = cmul(z[k2], z[k2]);
+      // conj(w)² = conj(w²), and dividing by 4i maps 
+      // re + i·im to (im - i·re) / 4
+    cdbl dk = a - conj(b), dk2 = b - conj(a);
+    z[k] = (cimag(dk) - creal(dk) * I) / 4;
+    z[k2] = (cimag(dk2) - creal(dk2) * I) / 4;
+  }
+  ifftExecute(plan, z, z);
+
+  double *res = safeCalloc(resLen, sizeof(double));
+  for (size_t i = 0; i < resLen; ++i)
+    res[i] = creal(z[i]);
 
-  return conv;
+  free(z);
+  fftPlanFree(plan);
+  return res;
 }
@@ -5,18 +5,55 @@
 #include <complex.h>
 typedef complex double cdbl;
 
+  // a plan holds the precomputed tables for transforms of
+  // a fixed length n, which is a power of 2, and can be
+  // reused for any number of transforms of that length
+typedef struct {
+  size_t n;         // length of the transform
+  size_t *rev;      // bit-reversal permutation of 0..n-1
+  cdbl *roots;      // twiddle factors: the roots of unity
+                    // e^(2πij/len) for the stage of length len
+                    // are stored at roots[len/2 + j], j < len/2
+} fftPlan;
+
+
+  // creates a plan for transforms of length n; n is
+  // rounded up to the next power of 2
+fftPlan *fftPlanNew(size_t n);
+
+  // deallocates a plan
+void fftPlanFree(fftPlan *plan);
+
+  // computes the forward fast fourier transform of the array in
+  // of length plan->n, and stores the result in out, which may
+  // be the same array as in
+void fftExecute(fftPlan *plan, cdbl *in, cdbl *out);
+
+  // computes the backward fast fourier transform of the array in
+  // of length plan->n, and stores the result in out, which may
+  // be the same array as in
+void ifftExecute(fftPlan *plan, cdbl *in, cdbl *out);
 
   // returns the forward fast fourier transform
-  // of an array of complex numbers
+  // of an array of complex numbers; the input is zero-padded
+  // to the next power of 2, which is the length of the result
 cdbl *fft(cdbl *arr, size_t arrLen);
 
   // returns the backward fast fourier transform
-  // of an array of complex numbers
+  // of an array of complex numbers; the input is zero-padded
+  // to the next power of 2, which is the length of the result
 cdbl *ifft(cdbl *arr, size_t arrLen);
 
   // returns the convolution of two input arrays
   // representing complex coefficients of polynomials
 cdbl *convolve(cdbl *x, cdbl *y, size_t xLen, size_t yLen);
 
+  // returns the convolution of two input arrays representing
+  // real coefficients of polynomials, which has length
+  // xLen + yLen - 1; both inputs are packed into a single
+  // complex transform
+double *convolveReal(double *x, double *y, size_t xLen,
+                     size_t yLen);
+
 
 #endif // FFT_H_INCLUDED
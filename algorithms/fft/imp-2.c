@@ -0,0 +1,29 @@
+/* 
+  file: imp-2.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: exact multiplication of two natural numbers, using 
+    the number-theoretic transform (NTT) for large operands
+  time complexity: O(n log n)
+*/
+
+#include "natlib/nat.h"
+#include "../../lib/clib.h"
+
+//===================================================================
+
+int main() {
+  
+  Nat *x = readNat();
+  Nat *y = readNat();
+  
+  Nat *prod = mulNat(x, y);
+  
+  showNat(prod);
+
+  freeNat(x);
+  freeNat(y);
+  freeNat(prod);
+  return 0;
+}
@@ -15,13 +15,13 @@
 
 //===================================================================
 // Converts a natural number a = dₙ₋₁dₙ₋₂...d₁d₀ to an array of 
-// complex numbers in reverse order so that its digits 
-// {d₀, d₁, ..., dₙ₋₁} can be interpreted as the complex coefficients 
+// real numbers in reverse order so that its digits 
+// {d₀, d₁, ..., dₙ₋₁} can be interpreted as the coefficients 
 // of a polynomial of the form 
 // P(x) = d₀ + d₁*x + d₂*x^2 + ... + dₙ₋₁*x^(n-1)
-cdbl *natToComplex(Nat *n) {
+double *natToCoeffs(Nat *n) {
   
-  cdbl *cN = safeCalloc(n->size, sizeof(cdbl));
+  double *cN = safeCalloc(n->size, sizeof(double));
   for (size_t i = 0; i < n->size; ++i) 
     cN[i] = n->digits[n->size - i - 1] - '0';
 
@@ -29,15 +29,17 @@ cdbl *natToComplex(Nat *n) {
 }
 
 //===================================================================
-// Converts an array of complex coefficients of a polynomial
-// P(x) = d₀ + d₁*x + d₂*x^2 + ... + dₙ₋₁*x^(n-1) to a natural number
-// a = dₙ₋₁dₙ₋₂...d₁d₀ by evaluating the polynomial at x = 10
-Nat *complexToNat(cdbl *coeffs, size_t len) {
+// Converts an array of coefficients of a polynomial
+// P(x) = d₀ + d₁*x + d₂*x^2 + ... + dₘ₋₁*x^(m-1) to a natural number
+// a = dₙ₋₁dₙ₋₂...d₁d₀ of at most n = m + 1 digits by evaluating 
+// the polynomial at x = 10
+Nat *coeffsToNat(double *coeffs, size_t m) {
   
+  size_t len = m + 1;
   Nat *n = newNat(len);
   int carry = 0;
   for (size_t i = 0; i < len; ++i) {
-    int coeff = round(creal(coeffs[i]));
+    int coeff = i < m ? round(coeffs[i]) : 0;
     n->digits[len - i - 1] = (coeff + carry) % 10 + '0';
     carry = (coeff + carry) / 10;
     n->size++;
@@ -53,15 +55,16 @@ Nat *complexToNat(cdbl *coeffs, size_t len) {
 // Returns the product of two natural numbers x and y using the FFT
 Nat *multiply(Nat *x, Nat *y) {
 
-    // make complex double arrays of the numbers x and y
-  cdbl *cX = natToComplex(x);
-  cdbl *cY = natToComplex(y);
+    // make double arrays of the digits of x and y
+  double *cX = natToCoeffs(x);
+  double *cY = natToCoeffs(y);
 
-    // compute the convolution of the two arrays
-  cdbl *conv = convolve(cX, cY, x->size, y->size);
+    // compute the convolution of the two arrays; since the
+    // coefficients are real, a single complex FFT suffices
+  double *conv = convolveReal(cX, cY, x->size, y->size);
 
     // convert the result back to a natural number
-  Nat *prod = complexToNat(conv, x->size + y->size);
+  Nat *prod = coeffsToNat(conv, x->size + y->size - 1);
 
     // free memory
   free(cX); free(cY); free(conv);
@@ -44,6 +44,17 @@ Nat *zero();
   // Converts a non-negative integer to a natural number
 Nat *intToNat(int x);
 
+  // Returns the exact product of two natural numbers x and y
+  // The algorithm is selected by the size of the smaller operand:
+  // long multiplication, Karatsuba, or a number-theoretic
+  // transform (NTT) modulo three primes
+Nat *mulNat(Nat *x, Nat *y);
+
+  // Return the product of x and y using one specific algorithm
+Nat *mulNatLong(Nat *x, Nat *y);
+Nat *mulNatKaratsuba(Nat *x, Nat *y);
+Nat *mulNatNTT(Nat *x, Nat *y);
+
   // Returns the first non-zero digit of n
 static inline int firstDigit(Nat *n) {
   return n->digits[n->start] - '0';
@@ -0,0 +1,442 @@
+/*
+  file: natmul.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: exact multiplication of natural numbers
+    The digits are packed into limbs of 9 decimal digits (base 10⁹),
+    which are multiplied with the long multiplication algorithm for
+    small operands, Karatsuba's algorithm for medium sized ones, and
+    a number-theoretic transform (NTT) for large ones. The NTT works
+    modulo three primes, and the exact product is reconstructed with
+    the Chinese remainder theorem, so there are no rounding errors.
+*/
+
+#include "../../../lib/clib.h"
+#include "nat.h"
+#include <stdint.h>
+
+#define BASE 1000000000u        // limb base 10⁹
+#define BASE_DIGITS 9           // decimal digits per limb
+#define LONG_CUTOFF 40          // limbs below which long
+                                // multiplication is used
+#define NTT_CUTOFF 2000         // limbs above which the NTT
+                                // is used
+#define NTT_MAX_LEN (1u << 23)  // max NTT length for all primes
+
+//===================================================================
+// Converts the digits of n to an array of limbs, least significant
+// limb first, and sets len to the number of limbs
+static uint32_t *natToLimbs(Nat *n, size_t *len) {
+  *len = (n->size + BASE_DIGITS - 1) / BASE_DIGITS;
+  uint32_t *limbs = safeCalloc(MAX(*len, 1), sizeof(uint32_t));
+  char *digits = n->digits + n->start;
+
+  for (size_t i = 0; i < *len; ++i) {
+      // the limb covers the digits [from, to) of n
+    size_t to = n->size - i * BASE_DIGITS;
+    size_t from = to > BASE_DIGITS ? to - BASE_DIGITS : 0;
+    uint32_t limb = 0;
+    for (size_t j = from; j < to; ++j)
+      limb = limb * 10 + (digits[j] - '0');
+    limbs[i] = limb;
+  }
+  return limbs;
+}
+
+//===================================================================
+// Converts an array of limbs, least significant limb first,
+// to a natural number
+static Nat *limbsToNat(uint32_t *limbs, size_t len) {
+  while (len && ! limbs[len - 1])
+    len--;
+  if (! len)
+    return zero();
+
+    // the top limb is written without leading zeros
+  char top[BASE_DIGITS + 1];
+  int topLen = sprintf(top, "%u", limbs[len - 1]);
+  Nat *n = newNat(topLen + (len - 1) * BASE_DIGITS + 1);
+  memcpy(n->digits, top, topLen);
+  n->size = topLen;
+
+  for (size_t i = len - 1; i-- > 0; ) {
+    uint32_t limb = limbs[i];
+    for (int j = BASE_DIGITS - 1; j >= 0; --j) {
+      n->digits[n->size + j] = limb % 10 + '0';
+      limb /= 10;
+    }
+    n->size += BASE_DIGITS;
+  }
+  return n;
+}
+
+//===================================================================
+// Adds b to a in place, where a has aLen limbs and b has bLen ≤ aLen
+// limbs; the sum is assumed to fit in aLen limbs
+static void addLimbs(uint32_t *a, size_t aLen,
+                     uint32_t const *b, size_t bLen) {
+  uint32_t carry = 0;
+  for (size_t i = 0; i < aLen && (i < bLen || carry); ++i) {
+    uint32_t sum = a[i] + (i < bLen ? b[i] : 0) + carry;
+    carry = sum >= BASE;
+    a[i] = carry ? sum - BASE : sum;
+  }
+}
+
+//===================================================================
+// Subtracts b from a in place, where a has aLen limbs and b has
+// bLen ≤ aLen limbs; requires a ≥ b
+static void subLimbs(uint32_t *a, size_t aLen,
+                     uint32_t const *b, size_t bLen) {
+  uint32_t borrow = 0;
+  for (size_t i = 0; i < aLen && (i < bLen || borrow); ++i) {
+    uint32_t sub = (i < bLen ? b[i] : 0) + borrow;
+    borrow = a[i] < sub;
+    a[i] = borrow ? a[i] + BASE - sub : a[i] - sub;
+  }
+}
+
+//===================================================================
+// Computes the product of x (xLen limbs) and y (yLen limbs) with the
+// long multiplication algorithm, and stores it in z, which should
+// have xLen + yLen limbs set to zero
+static void mulLong(uint32_t const *x, size_t xLen,
+                    uint32_t const *y, size_t yLen, uint32_t *z) {
+  for (size_t i = 0; i < xLen; ++i) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < yLen; ++j) {
+      uint64_t cur = z[i + j] + (uint64_t)x[i] * y[j] + carry;
+      z[i + j] = cur % BASE;
+      carry = cur / BASE;
+    }
+    z[i + yLen] = carry;
+  }
+}
+
+//===================================================================
+// Computes the product of x and y, which both have n limbs, with
+// Karatsuba's algorithm, and stores it in z, which has 2n limbs
+static void karatsuba(uint32_t const *x, uint32_t const *y,
+                      size_t n, uint32_t *z) {
+
+  memset(z, 0, 2 * n * sizeof(uint32_t));
+  if (n < LONG_CUTOFF) {
+    mulLong(x, n, y, n, z);
+    return;
+  }
+
+    // DIVIDE: x = x1 * B^h + x0 and y = y1 * B^h + y0,
+    // where the high parts have k ≥ h limbs
+  size_t h = n / 2, k = n - h;
+  uint32_t const *x0 = x, *x1 = x + h;
+  uint32_t const *y0 = y, *y1 = y + h;
+
+    // CONQUER: z0 = x0 * y0, z2 = x1 * y1 and
+    // z1 = (x0 + x1) * (y0 + y1)
+  uint32_t *sx = safeCalloc(k + 1, sizeof(uint32_t));
+  uint32_t *sy = safeCalloc(k + 1, sizeof(uint32_t));
+  uint32_t *z1 = safeCalloc(2 * (k + 1), sizeof(uint32_t));
+  memcpy(sx, x1, k * sizeof(uint32_t));
+  memcpy(sy, y1, k * sizeof(uint32_t));
+  addLimbs(sx, k + 1, x0, h);
+  addLimbs(sy, k + 1, y0, h);
+
+  karatsuba(x0, y0, h, z);
+  karatsuba(x1, y1, k, z + 2 * h);
+  karatsuba(sx, sy, k + 1, z1);
+
+    // COMBINE: z = z2 * B^2h + (z1 - z0 - z2) * B^h + z0
+  subLimbs(z1, 2 * (k + 1), z, 2 * h);
+  subLimbs(z1, 2 * (k + 1), z + 2 * h, 2 * k);
+  addLimbs(z + h, 2 * n - h, z1, MIN(2 * (k + 1), 2 * n - h));
+
+  free(sx); free(sy); free(z1);
+}
+
+//===================================================================
+// Computes the product of x (xLen limbs) and y (yLen limbs) with
+// Karatsuba's algorithm, and stores it in z, which has xLen + yLen
+// limbs; if the operands differ in length, the longer one is cut
+// into pieces of the length of the shorter one
+static void mulKaratsuba(uint32_t const *x, size_t xLen,
+                         uint32_t const *y, size_t yLen,
+                         uint32_t *z) {
+  if (xLen < yLen) {
+    SWAP(x, y);
+    SWAP(xLen, yLen);
+  }
+  memset(z, 0, (xLen + yLen) * sizeof(uint32_t));
+  if (yLen < LONG_CUTOFF) {
+    mulLong(x, xLen, y, yLen, z);
+    return;
+  }
+
+  uint32_t *piece = safeCalloc(yLen, sizeof(uint32_t));
+  uint32_t *prod = safeCalloc(2 * yLen, sizeof(uint32_t));
+  for (size_t i = 0; i < xLen; i += yLen) {
+    size_t len = MIN(yLen, xLen - i);
+    memset(piece, 0, yLen * sizeof(uint32_t));
+    memcpy(piece, x + i, len * sizeof(uint32_t));
+    karatsuba(piece, y, yLen, prod);
+    addLimbs(z + i, xLen + yLen - i, prod, len + yLen);
+  }
+  free(piece); free(prod);
+}
+
+//:::::::::::::::::::::: NUMBER-THEORETIC TRANSFORM ::::::::::::::::://
+
+  // The NTT is computed modulo three primes of the form c·2^k + 1,
+  // which all have 3 as a primitive root and allow transforms up to
+  // length 2^23. A coefficient of the product is at most
+  // 2^23 · (10⁹)² < p₁·p₂·p₃ ≈ 7.9 · 10²⁵, so it is determined
+  // exactly by its three residues.
+  // The arithmetic uses Montgomery multiplication with R = 2^32.
+
+typedef struct {
+  uint32_t p;       // prime modulus
+  uint32_t pInv;    // -p⁻¹ mod 2^32
+  uint32_t r2;      // R² mod p
+} modulus;
+
+//===================================================================
+// Initializes the Montgomery constants for a prime p < 2^31
+static modulus newModulus(uint32_t p) {
+  modulus m = { p, 0, 0 };
+  uint32_t inv = p;               // Newton iteration for p⁻¹ mod 2^32
+  for (int i = 0; i < 5; ++i)
+    inv *= 2 - p * inv;
+  m.pInv = -inv;
+  uint64_t r = (1ULL << 32) % p;
+  m.r2 = r * r % p;
+  return m;
+}
+
+//===================================================================
+// Returns t·R⁻¹ mod p, for t < p·2^32
+static inline uint32_t reduce(modulus const *m, uint64_t t) {
+  uint32_t q = (uint32_t)t * m->pInv;
+  uint32_t res = (t + (uint64_t)q * m->p) >> 32;
+  return res >= m->p ? res - m->p : res;
+}
+
+//===================================================================
+// Returns the Montgomery product a·b·R⁻¹ mod p
+static inline uint32_t mulMod(modulus const *m, uint32_t a,
+                              uint32_t b) {
+  return reduce(m, (uint64_t)a * b);
+}
+
+//===================================================================
+// Converts a < p to Montgomery form a·R mod p
+static inline uint32_t toMont(modulus const *m, uint32_t a) {
+  return mulMod(m, a, m->r2);
+}
+
+//===================================================================
+// Returns a^e mod p for a in Montgomery form, also in Montgomery form
+static uint32_t powMod(modulus const *m, uint32_t a, uint64_t e) {
+  uint32_t res = toMont(m, 1);
+  while (e) {
+    if (e & 1)
+      res = mulMod(m, res, a);
+    a = mulMod(m, a, a);
+    e >>= 1;
+  }
+  return res;
+}
+
+//===================================================================
+// Computes the forward NTT of a, of length n (a power of 2), in place;
+// the elements of a and the roots are in Montgomery form. The roots
+// of unity for the stage of length len are at roots[len/2 + j]
+static void ntt(modulus const *m, uint32_t *a, size_t n,
+                uint32_t const *roots) {
+  uint32_t p = m->p;
+
+    // put a in bit-reversed order
+  for (size_t i = 1, j = 0; i < n; ++i) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      uint32_t tmp = a[i];
+      a[i] = a[j];
+      a[j] = tmp;
+    }
+  }
+
+    // butterflies, one stage at a time
+  for (size_t len = 2; len <= n; len <<= 1) {
+    size_t half = len / 2;
+    uint32_t const *w = roots + half;
+    for (size_t i = 0; i < n; i += len)
+      for (size_t j = 0; j < half; ++j) {
+        uint32_t u = a[i + j];
+        uint32_t v = mulMod(m, a[i + j + half], w[j]);
+        a[i + j] = u + v >= p ? u + v - p : u + v;
+        a[i + j + half] = u >= v ? u - v : u + p - v;
+      }
+  }
+}
+
+//===================================================================
+// Computes the cyclic convolution of x and y modulo m->p with an NTT
+// of length n, and stores the result (in normal form) in res
+static void nttConvolve(modulus const *m, uint32_t const *x,
+                        size_t xLen, uint32_t const *y, size_t yLen,
+                        size_t n, uint32_t *res) {
+
+    // roots[len/2 + j] = ω_len^j, with ω_len = 3^((p-1)/len)
+  uint32_t *roots = safeCalloc(n, sizeof(uint32_t));
+  for (size_t len = 2; len <= n; len <<= 1) {
+    uint32_t ω = powMod(m, toMont(m, 3), (m->p - 1) / len);
+    roots[len / 2] = toMont(m, 1);
+    for (size_t j = 1; j < len / 2; ++j)
+      roots[len / 2 + j] = mulMod(m, roots[len / 2 + j - 1], ω);
+  }
+
+  uint32_t *a = safeCalloc(n, sizeof(uint32_t));
+  for (size_t i = 0; i < xLen; ++i)
+    a[i] = toMont(m, x[i] % m->p);
+  ntt(m, a, n, roots);
+
+    // a square needs only one forward transform
+  uint32_t *b = a;
+  if (x != y || xLen != yLen) {
+    b = safeCalloc(n, sizeof(uint32_t));
+    for (size_t i = 0; i < yLen; ++i)
+      b[i] = toMont(m, y[i] % m->p);
+    ntt(m, b, n, roots);
+  }
+
+  for (size_t i = 0; i < n; ++i)
+    a[i] = mulMod(m, a[i], b[i]);
+
+    // the inverse transform is the forward transform followed by
+    // reversing a[1..n-1] and dividing by n
+  ntt(m, a, n, roots);
+  uint32_t nInv = powMod(m, toMont(m, n % m->p), m->p - 2);
+  res[0] = reduce(m, mulMod(m, a[0], nInv));
+  for (size_t i = 1; i < n; ++i)
+    res[i] = reduce(m, mulMod(m, a[n - i], nInv));
+
+  if (b != a)
+    free(b);
+  free(a);
+  free(roots);
+}
+
+//===================================================================
+// Returns a⁻¹ mod p, for a prime p
+static uint32_t invMod(uint32_t a, uint32_t p) {
+  modulus m = newModulus(p);
+  return reduce(&m, powMod(&m, toMont(&m, a % p), p - 2));
+}
+
+//===================================================================
+// Computes the product of x (xLen limbs) and y (yLen limbs) with the
+// NTT, and stores it in z, which has xLen + yLen limbs
+static void mulNTT(uint32_t const *x, size_t xLen,
+                   uint32_t const *y, size_t yLen, uint32_t *z) {
+
+  static const uint32_t P[3] = { 998244353, 167772161, 469762049 };
+  size_t n = 1;
+  while (n < xLen + yLen - 1)
+    n <<= 1;
+  if (n > NTT_MAX_LEN) {
+      // too long for the primes: fall back to Karatsuba
+    mulKaratsuba(x, xLen, y, yLen, z);
+    return;
+  }
+
+  uint32_t *r[3];
+  for (int k = 0; k < 3; ++k) {
+    modulus m = newModulus(P[k]);
+    r[k] = safeCalloc(n, sizeof(uint32_t));
+    nttConvolve(&m, x, xLen, y, yLen, n, r[k]);
+  }
+
+    // CRT with Garner's algorithm: each coefficient is written as
+    // c = r₁ + p₁·t with t = t₂ + p₂·t₃ < p₂·p₃, which fits in 64
+    // bits; p₁·t is split as p₁·(tHi·B + tLo) to propagate carries
+    // in base B without overflow
+  uint64_t inv12 = invMod(P[0], P[1]);
+  uint64_t inv123 = invMod((uint64_t)P[0] * P[1] % P[2], P[2]);
+  uint64_t carry = 0;
+  for (size_t i = 0; i < xLen + yLen; ++i) {
+    uint64_t t = 0;
+    uint64_t r1 = 0;
+    if (i < n) {
+      r1 = r[0][i];
+      uint64_t t2 = (r[1][i] + P[1] - r1 % P[1]) % P[1]
+                    * inv12 % P[1];
+      uint64_t s = (r1 + P[0] * t2) % P[2];
+      uint64_t t3 = (r[2][i] + P[2] - s) % P[2] * inv123 % P[2];
+      t = t2 + (uint64_t)P[1] * t3;
+    }
+    uint64_t cur = r1 + P[0] * (t % BASE) + carry;
+    z[i] = cur % BASE;
+    carry = cur / BASE + P[0] * (t / BASE);
+  }
+
+  for (int k = 0; k < 3; ++k)
+    free(r[k]);
+}
+
+//===================================================================
+// Multiplies x and y with the given limb multiplication function
+static Nat *mulWith(Nat *x, Nat *y,
+                    void (*mul)(uint32_t const *, size_t,
+                                uint32_t const *, size_t,
+                                uint32_t *)) {
+  if (isZero(x) || isZero(y))
+    return zero();
+
+  size_t xLen, yLen;
+  uint32_t *xl = natToLimbs(x, &xLen);
+  uint32_t *yl = x == y ? xl : natToLimbs(y, &yLen);
+  if (x == y)
+    yLen = xLen;
+
+  uint32_t *z = safeCalloc(xLen + yLen, sizeof(uint32_t));
+  mul(xl, xLen, yl, yLen, z);
+  Nat *prod = limbsToNat(z, xLen + yLen);
+
+  if (yl != xl)
+    free(yl);
+  free(xl); free(z);
+  return prod;
+}
+
+//===================================================================
+// Returns the product of x and y, using long multiplication
+Nat *mulNatLong(Nat *x, Nat *y) {
+  return mulWith(x, y, mulLong);
+}
+
+//===================================================================
+// Returns the product of x and y, using Karatsuba's algorithm
+Nat *mulNatKaratsuba(Nat *x, Nat *y) {
+  return mulWith(x, y, mulKaratsuba);
+}
+
+//===================================================================
+// Returns the product of x and y, using the NTT
+Nat *mulNatNTT(Nat *x, Nat *y) {
+  return mulWith(x, y, mulNTT);
+}
+
+//===================================================================
+// Returns the product of x and y, selecting the algorithm
+// by the size of the smaller operand
+Nat *mulNat(Nat *x, Nat *y) {
+  size_t limbs = (MIN(x->size, y->size) + BASE_DIGITS - 1)
+                 / BASE_DIGITS;
+  if (limbs < LONG_CUTOFF)
+    return mulNatLong(x, y);
+  if (limbs < NTT_CUTOFF)
+    return mulNatKaratsuba(x, y);
+  return mulNatNTT(x, y);
+}
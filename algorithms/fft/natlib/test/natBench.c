@@ -0,0 +1,80 @@
+/*
+  Benchmark of the multiplication algorithms for natural numbers:
+    long multiplication, Karatsuba, the NTT, and mulNat, which
+    selects one of them by the size of the operands
+  For each size, two random numbers with the given number of
+    digits are multiplied with each algorithm, as long as it
+    finishes in reasonable time, and the products are compared
+  Usage: ./natBench.out [maxDigits]
+  Author: David De Potter
+*/
+
+#include "../nat.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// returns a random natural number with the given number of digits
+Nat *randomNat(size_t digits) {
+  Nat *n = newNat(digits + 1);
+  n->digits[0] = '1' + rand() % 9;
+  for (size_t i = 1; i < digits; i++)
+    n->digits[i] = '0' + rand() % 10;
+  n->size = digits;
+  return n;
+}
+
+//===================================================================
+// returns true if the two numbers are equal
+bool equalNat(Nat *a, Nat *b) {
+  return a->size == b->size &&
+         memcmp(a->digits + a->start, b->digits + b->start,
+                a->size) == 0;
+}
+
+//===================================================================
+// multiplies x and y with the given function if enabled, shows the
+// time, and checks the product against ref (if not NULL);
+// returns the product
+Nat *bench(Nat *(*mul)(Nat *, Nat *), Nat *x, Nat *y, bool enabled,
+           Nat *ref) {
+  if (! enabled) {
+    printf("  %10s", "-");
+    return NULL;
+  }
+  clock_t start = clock();
+  Nat *prod = mul(x, y);
+  printf("  %9.4fs", (double)(clock() - start) / CLOCKS_PER_SEC);
+  if (ref && ! equalNat(prod, ref))
+    printf(" (wrong!)");
+  return prod;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxDigits = argc > 1 ? strtoul(argv[1], NULL, 10)
+                              : 10000000;
+  srand(42);
+
+  printf("%10s  %10s  %10s  %10s  %10s\n", "digits", "long",
+         "karatsuba", "ntt", "mulNat");
+
+  for (size_t d = 100; d <= maxDigits; d *= 10) {
+    Nat *x = randomNat(d);
+    Nat *y = randomNat(d);
+    printf("%10zu", d);
+
+    Nat *p1 = bench(mulNatLong, x, y, d <= 100000, NULL);
+    Nat *p2 = bench(mulNatKaratsuba, x, y, d <= 1000000, p1);
+    Nat *p3 = bench(mulNatNTT, x, y, true, p1 ? p1 : p2);
+    Nat *p4 = bench(mulNat, x, y, true, p3);
+    printf("\n");
+
+    if (p1) freeNat(p1);
+    if (p2) freeNat(p2);
+    freeNat(p3); freeNat(p4);
+    freeNat(x); freeNat(y);
+  }
+  return 0;
+}
@@ -0,0 +1,161 @@
+/* 
+  file: dijkstra-4.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: Dijkstra's shortest paths algorithm
+  time complexity: O(E log V) using a binary heap
+    The search runs on a frozen CSR view of the graph, in 
+    which vertices are numbered 0..n-1 and the adjacency 
+    lists are stored in contiguous arrays. The state of the 
+    vertices is kept in a dense array of items, each of which
+    carries its own index slot in the heap.
+  note: make sure to use VERTEX_TYPE2 in the vertex.h file
+    by defining it from the command line using
+      $ gcc -D VERTEX_TYPE2 ...
+*/
+
+#include "../../../datastructures/heaps/bpqueues/bpqueue.h"
+#include "../../../datastructures/graphs/graph/csr.h"
+#include "../../../lib/clib.h"
+#include <float.h>
+
+//===================================================================
+// Copies the key (priority) of a node in the priority queue
+void *copyKey (void const *key) {
+  double *copy = safeCalloc(1, sizeof(double));
+  *copy = *(double *)key;
+  return copy;
+}
+
+//===================================================================
+// Comparison function for the priority queue
+int compareKeys(void const *k1, void const *k2) {
+  double d1 = *(double *)k1;
+  double d2 = *(double *)k2;
+  if (d1 < d2) return -1;
+  if (d1 > d2) return 1;
+  return 0;
+}
+
+//===================================================================
+// State of a vertex during the search
+typedef struct {
+  double dist;        // distance from the source vertex
+  size_t parent;      // id of the parent vertex
+  size_t pqIdx;       // index slot in the priority queue
+} item;
+
+//===================================================================
+// Returns the index slot of an item in the priority queue
+size_t *itemSlot(void const *data) {
+  item *it = (item *)data;
+  return &it->pqIdx;
+}
+
+//===================================================================
+// Generates and initializes the min priority queue
+// All items are added to the priority queue with infinite
+// distance from the source node and likewise infinite priority
+// The distance and priority of the source node is set to 0
+bpqueue *initPQ(csrGraph *C, item *items, size_t src) {
+
+  bpqueue *pq = bpqNewSlot(csrNVertices(C), MIN, compareKeys, 
+                           copyKey, free, itemSlot, NULL);
+  
+  for (size_t v = 0; v < csrNVertices(C); v++) {
+    items[v].dist = v == src ? 0 : DBL_MAX;
+    items[v].parent = SIZE_MAX;
+    bpqPush(pq, &items[v], &items[v].dist);
+  }
+  return pq;
+}
+
+//===================================================================
+// Computes the shortest paths from vertex src to all other nodes
+// The results are copied back to the vertices of the graph
+void dijkstra(csrGraph *C, size_t src) {
+    
+  item *items = safeCalloc(csrNVertices(C), sizeof(item));
+  bpqueue *pq = initPQ(C, items, src);
+  
+  while (! bpqIsEmpty(pq)) {
+    item *u = bpqPop(pq);
+    size_t uid = u - items;
+      
+      // try to relax all the edges from u to its neighbors
+    for (size_t i = C->offsets[uid]; i < C->offsets[uid + 1]; i++) {
+      item *v = &items[C->targets[i]];
+      if (bpqContains(pq, v) && v->dist > u->dist + C->weights[i]) {
+        v->dist = u->dist + C->weights[i];
+        v->parent = uid;
+          // update neighbor's priority in the pq
+        bpqUpdateKey(pq, v, &v->dist);
+      }
+    }
+  } 
+  bpqFree(pq);
+
+  for (size_t v = 0; v < csrNVertices(C); v++) {
+    vertex *x = csrVertex(C, v);
+    x->dist = items[v].dist;
+    x->parent = items[v].parent == SIZE_MAX ? 
+                NULL : csrVertex(C, items[v].parent);
+  }
+  free(items);
+}
+
+//===================================================================
+// Shows the results of the shortest paths computation from src
+// displaying the parent and the distance from the source vertex for
+// each vertex in the graph; by following the parent pointers, the
+// shortest path from the source vertex to any other vertex can be
+// reconstructed
+void showDistances(graph *G, vertex *src) {
+  printf("\nShortest paths\n"
+         "Source: %s\n"
+         "---------------------------------\n"
+         "Vertex: Parent, Distance from src\n"
+         "---------------------------------\n",
+         src->label);
+         
+  for (vertex *v = firstV(G); v; v = nextV(G)) {
+    printf("  %s: %s, ", v->label, 
+           v->parent ? v->parent->label : "NIL");
+    if (v->dist == DBL_MAX)
+      printf("%s\n", "INF");
+    else
+      printf("%.2lf\n", v->dist);
+  }
+  printf("---------------------------------\n\n");
+}
+
+//===================================================================
+
+int main () {
+    
+    // read the label of the source vertex
+  char srcL[50];
+  assert(scanf("%s", srcL) == 1);    
+
+  graph *G = newGraph(50, WEIGHTED); 
+  readGraph(G);              
+  showGraph(G);
+
+  vertex *src = getVertex(G, srcL);
+
+  if (! src) {
+    fprintf(stderr, "Source node %s not found.\n", srcL);
+    freeGraph(G);
+    exit(EXIT_FAILURE);
+  }
+
+  csrGraph *C = graphFreeze(G);
+  dijkstra(C, csrId(C, src));
+  csrFree(C);              
+  showDistances(G, src);                 
+
+  freeGraph(G);
+  return 0;
+}
+
@@ -0,0 +1,118 @@
+/* 
+  file: bfs-2.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: breadth-first search on a frozen CSR view 
+    of the graph: vertices are numbered 0..n-1 and their
+    adjacency lists are stored in contiguous arrays, so that
+    the search only walks over flat arrays of vertex ids.
+    The queue is a plain array, since each vertex is 
+    enqueued at most once.
+  note: make sure to use VERTEX_TYPE2 in the vertex.h file
+    by defining it from the command line using
+    $ gcc -D VERTEX_TYPE2 ...
+*/
+
+#include "../../../datastructures/graphs/graph/csr.h"
+#include "../../../lib/clib.h"
+#include <assert.h>
+
+//===================================================================
+// prints the path from the source to the destination
+void printPath(vertex *src, vertex *d) {
+  if (src == d) 
+    printf("%s", src->label);
+  else if (! d->parent) 
+    printf("no path from %s to %s.", src->label, d->label);
+  else {
+    printPath(src, d->parent);
+    printf(", %s", d->label);
+  }
+}
+
+//===================================================================
+// Prints the result of the search
+void printResult(graph *G, vertex *src, vertex *d) {
+    if (! d->parent) 
+      printf("\nDistance from %s to %s: INF.\n", 
+              src->label, d->label);
+    else 
+      printf("\nDistance from %s to %s: %g\n", 
+              src->label, d->label, d->dist);
+    printf("Path: ");
+    printPath(src, d);
+    printf("\n");
+}
+
+//===================================================================
+// Builds a breadth-first search tree from the source node
+// The results are copied back to the vertices of the graph
+void bfs(csrGraph *C, size_t src) {
+  
+  size_t n = csrNVertices(C);
+  CREATE_ARRAY(size_t, parent, n, SIZE_MAX);
+  CREATE_ARRAY(size_t, dist, n, 0);
+  CREATE_ARRAY(size_t, queue, n, 0);
+  CREATE_ARRAY(bool, visited, n, false);
+  
+  size_t head = 0, tail = 0;
+  queue[tail++] = src;
+  visited[src] = true;
+
+  while (head < tail) {
+    size_t u = queue[head++];
+
+      // for each neighbor, if it has not been visited, 
+      // set its parent and its distance from the source
+    for (size_t i = C->offsets[u]; i < C->offsets[u + 1]; i++) {
+      size_t v = C->targets[i];
+      if (! visited[v]) {
+        visited[v] = true;
+        parent[v] = u;
+        dist[v] = dist[u] + 1;
+        queue[tail++] = v;
+      }
+    }
+  }
+
+  for (size_t v = 0; v < n; v++) {
+    vertex *x = csrVertex(C, v);
+    x->parent = parent[v] == SIZE_MAX ? 
+                NULL : csrVertex(C, parent[v]);
+    x->dist = dist[v];
+  }
+  free(parent); free(dist); free(queue); free(visited);
+}
+
+//===================================================================
+ 
+int main () {
+    // source and destination nodes
+  char s[50], d[50];              
+  assert(scanf("%s %s", s, d) == 2);
+  
+  graph *G = newGraph(50, UNWEIGHTED);
+  
+  readGraph(G);
+  showGraph(G);
+
+  vertex *src = getVertex(G, s);
+  vertex *dest = getVertex(G, d);
+
+  if (! src || ! dest) {
+    fprintf(stderr, "Error: source or destination " 
+                    "vertex not found.\n");
+    freeGraph(G);
+    exit(EXIT_FAILURE);
+  }
+
+  csrGraph *C = graphFreeze(G);
+  bfs(C, csrId(C, src));
+  csrFree(C);
+  
+  printResult(G, src, dest);
+
+  freeGraph(G);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+/* 
+  file: dfs-2.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: depth-first search on a frozen CSR view of the
+    graph, in which vertices are numbered 0..n-1 and their 
+    adjacency lists are stored in contiguous arrays.
+    The search is iterative: an explicit stack of vertex ids
+    replaces the recursion, and each vertex keeps a cursor to
+    the next edge to explore, so that deep graphs cannot 
+    overflow the call stack.
+  input: directed graph 
+  output: discovery and finish times for each node and
+          the edge types (tree, back, forward, cross)
+  note: make sure to use VERTEX_TYPE1 in the vertex.h file
+        and EDGE_TYPE1 in the edge.h file by defining them
+        from the command line when compiling:
+        $ gcc -D VERTEX_TYPE1 -D EDGE_TYPE1 ...
+*/
+
+#include "../../../datastructures/graphs/graph/csr.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// Prints the discovery and finish times of the nodes in the graph
+// and the type of each edge
+void printResults(csrGraph *C, eType *types) {
+
+  printf("\n\nVERTEX DISCOVERY AND FINISH TIMES\n"
+         "---------------------------------\n"
+         "Label: discovery time, finish time\n\n");
+
+  for (size_t u = 0; u < csrNVertices(C); u++) {
+    vertex *v = csrVertex(C, u);
+    printf("   %s: %zu, %zu\n", v->label, v->dTime, v->fTime);
+  }
+
+  printf("\n\nEDGE CLASSIFICATION\n"
+         "-------------------\n"
+         "Source -> Destination: edge type\n\n");
+
+  for (size_t u = 0; u < csrNVertices(C); u++) 
+    for (size_t i = C->offsets[u]; i < C->offsets[u + 1]; i++) 
+      printf("   %s -> %s:  %c\n", csrVertex(C, u)->label, 
+             csrVertex(C, C->targets[i])->label, types[i]);
+  printf("\n");
+}
+
+//===================================================================
+// Visits the node src and its descendants, marking the edges on 
+// the way as tree, back, forward or cross edges
+void dfsVisit(csrGraph *C, size_t src, size_t *time, eType *types,
+              size_t *stack, size_t *cursor) {
+  
+  size_t top = 0;
+  stack[top++] = src;
+  vertex *s = csrVertex(C, src);
+  s->dTime = ++*time;
+  s->color = GRAY;            // src is discovered: turns gray
+
+  while (top > 0) {
+    size_t u = stack[top - 1];
+    vertex *x = csrVertex(C, u);
+
+    if (cursor[u] == C->offsets[u + 1]) {
+      x->fTime = ++*time;
+      x->color = BLACK;       // u is finished: turns black
+      top--;
+      continue;
+    }
+    
+      // explore the next edge of u
+    size_t i = cursor[u]++;
+    vertex *y = csrVertex(C, C->targets[i]);
+
+    if (y->color == WHITE) {  // if v is undiscovered
+      types[i] = TREE;        // then u->v is a tree edge
+      y->parent = x;
+      y->dTime = ++*time;
+      y->color = GRAY;
+      stack[top++] = C->targets[i];
+    } 
+
+    else if (y->color == GRAY)
+      types[i] = BACK;        // v is an ancestor of u 
+                              // in the same dfs tree
+    else if (y->dTime > x->dTime)  
+      types[i] = FORWARD;     // v is a descendant of u 
+                              // in the same dfs tree
+    else 
+      types[i] = CROSS;       // rest of the cases; 
+                              // v can be in another dfs tree
+  }
+}
+
+//===================================================================
+// Builds a depth-first search forest for the frozen graph
+// The vertices are visited in the order of their ids, which
+// is the order of their labels, so that the traversal is 
+// the same for each run
+void dfs(csrGraph *C, eType *types) {
+  size_t time = 0, n = csrNVertices(C);
+  CREATE_ARRAY(size_t, stack, n, 0);
+  CREATE_ARRAY(size_t, cursor, n, 0);
+  for (size_t u = 0; u < n; u++)
+    cursor[u] = C->offsets[u];
+  
+    // Discover all white nodes in the graph
+  for (size_t u = 0; u < n; u++) 
+    if (csrVertex(C, u)->color == WHITE)      
+      dfsVisit(C, u, &time, types, stack, cursor);
+
+  free(stack);
+  free(cursor);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  
+  graph *G = newGraph(50, UNWEIGHTED);
+
+  readGraph(G);    
+  showGraph(G);
+
+  csrGraph *C = graphFreeze(G);
+  CREATE_ARRAY(eType, types, csrNEdges(C), 0);
+
+  dfs(C, types); 
+
+  printResults(C, types);
+  free(types);
+  csrFree(C);
+  freeGraph(G);
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+  file: tps-2.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: topological sort of a directed acyclic 
+               graph using depth-first search on a frozen 
+               CSR view of the graph; the search is iterative,
+               using an explicit stack of vertex ids and a
+               cursor per vertex to the next edge to explore
+  complexity: Θ(V + E)
+  note: make sure to use VERTEX_TYPE3 in the vertex.h file
+        by defining it from the command line when compiling:
+        $ gcc -D VERTEX_TYPE3 ...
+*/
+
+#include "../../../datastructures/graphs/graph/csr.h"
+#include "../../../lib/clib.h"
+
+//===================================================================
+// Visits the node src and its descendants in depth-first order;
+// finished vertices are stored at the back of the sorted array, 
+// which is thus filled from right to left
+void dfsVisit(csrGraph *C, size_t src, size_t *sorted, size_t *pos,
+              size_t *stack, size_t *cursor) {
+  size_t top = 0;
+  stack[top++] = src;
+  csrVertex(C, src)->visited = true;
+
+  while (top > 0) {
+    size_t u = stack[top - 1];
+    if (cursor[u] == C->offsets[u + 1]) {
+      sorted[--*pos] = u;         // u is finished
+      top--;
+      continue;
+    }
+    size_t v = C->targets[cursor[u]++];
+    if (! csrVertex(C, v)->visited) {  // undiscovered?
+      csrVertex(C, v)->visited = true;
+      stack[top++] = v;
+    }
+  }
+}
+
+//===================================================================
+// Sorts the vertices in the frozen graph in topological order
+// and returns an array of their ids; the vertices are visited in
+// the order of their labels, so the result is the same each run
+size_t *topSort(csrGraph *C) {
+  size_t n = csrNVertices(C), pos = n;
+  CREATE_ARRAY(size_t, sorted, n, 0);
+  CREATE_ARRAY(size_t, stack, n, 0);
+  CREATE_ARRAY(size_t, cursor, n, 0);
+  for (size_t u = 0; u < n; u++)
+    cursor[u] = C->offsets[u];
+  
+    // visit all undiscovered vertices
+  for (size_t u = 0; u < n; u++) 
+    if (! csrVertex(C, u)->visited)
+      dfsVisit(C, u, sorted, &pos, stack, cursor);
+
+  free(stack);
+  free(cursor);
+  return sorted;
+}
+
+//===================================================================
+// Shows the topological sort
+void showTopSort(csrGraph *C, size_t *sorted) {
+  printf("TOPOLOGICAL SORT\n"
+         "----------------\n");
+  for (size_t i = 0; i < csrNVertices(C); i++)
+    printf("%s\n", csrVertex(C, sorted[i])->label);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  
+  graph *G = newGraph(40, UNWEIGHTED);
+  readGraph(G);  
+
+  csrGraph *C = graphFreeze(G);
+  size_t *sorted = topSort(C);     
+
+  showTopSort(C, sorted);
+
+  free(sorted);
+  csrFree(C);
+  freeGraph(G);
+  return 0;
+}
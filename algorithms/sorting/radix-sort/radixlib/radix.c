@@ -0,0 +1,255 @@
+/*
+  file: radix.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: parallel LSD radix sort for arrays of 32-bit and
+    64-bit integers and floating-point numbers, with or without a
+    payload per key
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include "radix.h"
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if INT_MAX != 2147483647
+#error "radixSortInt assumes 32-bit ints"
+#endif
+
+  // A thread only pays off if it gets at least this many keys
+#define PER_THREAD 65536
+
+  // The state shared by the threads of a sort. Each thread owns a
+  // chunk of the positions, and counts the digits of the keys in
+  // its chunk, so that the threads know where to write their keys
+  // in each pass without synchronizing on the buckets
+typedef struct {
+  void *keys, *vals;          // the input, and its payloads
+  void *tmpKeys, *tmpVals;    // the other half of the ping-pong
+  size_t n, bits, buckets;    // number of keys, and of buckets
+  size_t passes, nThreads;    // number of digits, and of threads
+  size_t *counts;             // per thread and pass: digit counts
+  size_t *base;               // per pass: first position per digit
+  size_t *off;                // per thread: next position per digit
+  bool *skip;                 // per pass: all keys have one digit
+  pthread_barrier_t barrier;
+} radixJob;
+
+  // The work of a single thread: the positions [lo, hi)
+typedef struct {
+  pthread_t thread;
+  radixJob *J;
+  size_t id, lo, hi;
+} radixTask;
+
+//===================================================================
+// Returns the digit counts of thread t for pass p
+static inline size_t *countsOf(radixJob *J, size_t t, size_t p) {
+  return J->counts + (t * J->passes + p) * J->buckets;
+}
+
+//===================================================================
+// Determines for each pass whether it can be skipped, and where
+// the keys with each digit start; as long as no pass has been made,
+// the counts of the threads cover all keys for all passes, and the
+// total count of each digit stays the same in later passes
+static void planPasses(radixJob *J) {
+  for (size_t p = 0; p < J->passes; p++) {
+    size_t *base = J->base + p * J->buckets, start = 0;
+    J->skip[p] = false;
+    for (size_t b = 0; b < J->buckets; b++) {
+      size_t total = 0;
+      for (size_t t = 0; t < J->nThreads; t++)
+        total += countsOf(J, t, p)[b];
+      J->skip[p] |= total == J->n;
+      base[b] = start;
+      start += total;
+    }
+  }
+}
+
+//===================================================================
+// Sets off[b] to the first position where thread t writes a key
+// with digit b in pass p: after the keys with smaller digits, and
+// after the keys with digit b of the threads before it, which keeps
+// the sort stable
+static void offsets(radixJob *J, size_t t, size_t p, size_t *off) {
+  size_t *base = J->base + p * J->buckets;
+  for (size_t b = 0; b < J->buckets; b++) {
+    off[b] = base[b];
+    for (size_t u = 0; u < t; u++)
+      off[b] += countsOf(J, u, p)[b];
+  }
+}
+
+//===================================================================
+// Maps the keys to unsigned integers in the same order: the sign
+// bit of a signed integer is flipped, and a floating-point number
+// has its sign bit set if it is positive, or all bits flipped if
+// it is negative, as the rest of its bits is its magnitude
+static inline uint32_t orderU32(uint32_t x) {
+  return x;
+}
+
+static inline uint64_t orderU64(uint64_t x) {
+  return x;
+}
+
+static inline uint32_t orderInt(int x) {
+  return (uint32_t) x ^ UINT32_C(0x80000000);
+}
+
+static inline uint32_t orderFloat(float x) {
+  uint32_t u;
+  memcpy(&u, &x, sizeof(u));
+  return u >> 31 ? ~u : u | UINT32_C(0x80000000);
+}
+
+static inline uint64_t orderDouble(double x) {
+  uint64_t u;
+  memcpy(&u, &x, sizeof(u));
+  return u >> 63 ? ~u : u | UINT64_C(0x8000000000000000);
+}
+
+  // Defines the work of a thread for keys of type keyType, which
+  // are mapped to the unsigned type uType by ORDER: its keys are
+  // counted for all passes at once, after which thread 0 plans the
+  // passes. In each pass that is not skipped, the thread scatters
+  // its chunk to the other buffer; the keys in its chunk are only
+  // counted again for the later passes, since they change with
+  // every pass. If the keys end up in the buffer, each thread
+  // copies its chunk back
+#define DEFINE_RADIX(name, keyType, valType, uType, ORDER) \
+static void *name##Work(void *arg) { \
+  radixTask *T = arg; \
+  radixJob *J = T->J; \
+  size_t lo = T->lo, hi = T->hi, bits = J->bits; \
+  size_t buckets = J->buckets, passes = J->passes; \
+  uType mask = buckets - 1; \
+  keyType *src = J->keys, *dst = J->tmpKeys; \
+  valType *srcVals = J->vals, *dstVals = J->tmpVals; \
+\
+  size_t *counts = countsOf(J, T->id, 0); \
+  for (size_t i = lo; i < hi; i++) { \
+    uType u = ORDER(src[i]); \
+    for (size_t p = 0; p < passes; p++) \
+      counts[p * buckets + ((u >> (p * bits)) & mask)]++; \
+  } \
+  pthread_barrier_wait(&J->barrier); \
+  if (T->id == 0) \
+    planPasses(J); \
+  pthread_barrier_wait(&J->barrier); \
+\
+  size_t *off = J->off + T->id * buckets; \
+  bool first = true; \
+  for (size_t p = 0; p < passes; p++) { \
+    if (J->skip[p]) \
+      continue; \
+    size_t shift = p * bits; \
+    if (! first) { \
+      counts = countsOf(J, T->id, p); \
+      memset(counts, 0, buckets * sizeof(size_t)); \
+      for (size_t i = lo; i < hi; i++) \
+        counts[(ORDER(src[i]) >> shift) & mask]++; \
+      pthread_barrier_wait(&J->barrier); \
+    } \
+    offsets(J, T->id, p, off); \
+    if (srcVals) \
+      for (size_t i = lo; i < hi; i++) { \
+        size_t pos = off[(ORDER(src[i]) >> shift) & mask]++; \
+        dst[pos] = src[i]; \
+        dstVals[pos] = srcVals[i]; \
+      } \
+    else \
+      for (size_t i = lo; i < hi; i++) \
+        dst[off[(ORDER(src[i]) >> shift) & mask]++] = src[i]; \
+    pthread_barrier_wait(&J->barrier); \
+    keyType *tmp = src; src = dst; dst = tmp; \
+    valType *tmpVals = srcVals; srcVals = dstVals; dstVals = tmpVals; \
+    first = false; \
+  } \
+\
+  if (src != J->keys) { \
+    memcpy(dst + lo, src + lo, (hi - lo) * sizeof(keyType)); \
+    if (srcVals) \
+      memcpy(dstVals + lo, srcVals + lo, (hi - lo) * sizeof(valType)); \
+  } \
+  return NULL; \
+} \
+\
+void name(keyType *keys, valType *vals, size_t n, unsigned bits, \
+          size_t nThreads) { \
+  radixJob J = { keys, vals }; \
+  radixRun(&J, n, bits, nThreads, sizeof(keyType), sizeof(valType), \
+           name##Work); \
+}
+
+//===================================================================
+// Sorts the keys of the job with the given work per thread, where
+// the first thread is the caller itself
+static void radixRun(radixJob *J, size_t n, unsigned bits,
+                     size_t nThreads, size_t keySize, size_t valSize,
+                     void *(*work)(void *)) {
+
+  if (bits < 1 || bits > 16) {
+    fprintf(stderr, "Error: digits must have 1 to 16 bits\n");
+    exit(EXIT_FAILURE);
+  }
+  if (n < 2)
+    return;
+
+  J->n = n;
+  J->bits = bits;
+  J->buckets = (size_t) 1 << bits;
+  J->passes = (8 * keySize + bits - 1) / bits;
+  J->nThreads = MAX(1, MIN(nThreads, n / PER_THREAD));
+  J->tmpKeys = safeMalloc(n * keySize);
+  J->tmpVals = J->vals ? safeMalloc(n * valSize) : NULL;
+  J->counts = safeCalloc(J->nThreads * J->passes * J->buckets,
+                         sizeof(size_t));
+  J->base = safeCalloc(J->passes * J->buckets, sizeof(size_t));
+  J->off = safeCalloc(J->nThreads * J->buckets, sizeof(size_t));
+  J->skip = safeCalloc(J->passes, sizeof(bool));
+  pthread_barrier_init(&J->barrier, NULL, J->nThreads);
+
+  radixTask *tasks = safeCalloc(J->nThreads, sizeof(radixTask));
+  size_t perTask = (n + J->nThreads - 1) / J->nThreads;
+  for (size_t t = 0; t < J->nThreads; t++) {
+    radixTask *T = tasks + t;
+    T->J = J;
+    T->id = t;
+    T->lo = MIN(n, t * perTask);
+    T->hi = MIN(n, T->lo + perTask);
+    if (t > 0 && pthread_create(&T->thread, NULL, work, T) != 0) {
+      fprintf(stderr, "Error: could not create thread\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+  work(tasks);
+  for (size_t t = 1; t < J->nThreads; t++)
+    pthread_join(tasks[t].thread, NULL);
+
+  pthread_barrier_destroy(&J->barrier);
+  free(tasks);
+  free(J->tmpKeys);
+  free(J->tmpVals);
+  free(J->counts);
+  free(J->base);
+  free(J->off);
+  free(J->skip);
+}
+
+DEFINE_RADIX(radixSortU32, uint32_t, uint32_t, uint32_t, orderU32)
+DEFINE_RADIX(radixSortU64, uint64_t, uint64_t, uint64_t, orderU64)
+DEFINE_RADIX(radixSortInt, int, uint32_t, uint32_t, orderInt)
+DEFINE_RADIX(radixSortFloat, float, uint32_t, uint32_t, orderFloat)
+DEFINE_RADIX(radixSortDouble, double, uint64_t, uint64_t, orderDouble)
+
+//===================================================================
+// Returns the number of processors that are online
+size_t radixProcessors(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? n : 1;
+}
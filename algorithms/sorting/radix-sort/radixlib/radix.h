@@ -0,0 +1,38 @@
+#ifndef RADIX_H_INCLUDED
+#define RADIX_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // The default number of bits per digit: 8 bits give 256 buckets,
+  // whose counters and write positions stay in the L1 cache, while
+  // 11 bits need fewer passes (3 instead of 4 for 32-bit keys, and
+  // 6 instead of 8 for 64-bit keys) at the cost of 2048 buckets
+#define RADIX_BITS 8
+
+  // Each function sorts the n keys in ascending order by LSD radix
+  // sort with digits of bits bits (1 to 16), using nThreads threads.
+  // The sort is stable, and vals, if not NULL, holds a payload for
+  // each key that is moved along with it. Signed integers and
+  // floating-point numbers are sorted by their value, where -0.0
+  // comes before 0.0, and NaNs end up at either end depending on
+  // their sign bit. Passes in which all keys have the same digit
+  // are skipped. O(d(n + 2^bits·nThreads)) time, where d is the
+  // number of digits, and O(n) extra space
+void radixSortU32(uint32_t *keys, uint32_t *vals, size_t n,
+                  unsigned bits, size_t nThreads);
+void radixSortU64(uint64_t *keys, uint64_t *vals, size_t n,
+                  unsigned bits, size_t nThreads);
+void radixSortInt(int *keys, uint32_t *vals, size_t n,
+                  unsigned bits, size_t nThreads);
+void radixSortFloat(float *keys, uint32_t *vals, size_t n,
+                    unsigned bits, size_t nThreads);
+void radixSortDouble(double *keys, uint64_t *vals, size_t n,
+                     unsigned bits, size_t nThreads);
+
+  // Returns the number of processors that are online
+size_t radixProcessors(void);
+
+#endif // RADIX_H_INCLUDED
@@ -0,0 +1,179 @@
+/*
+  Benchmark of the parallel LSD radix sort against the quicksort of
+    quicksort.c and the merge sort of mergesort.c on random ints,
+    for n = 10^6 up to maxN in powers of 10
+  The radix sort is run with 8-bit and 11-bit digits on 1 up to
+    maxThreads threads, and with 8-bit digits on maxThreads threads
+    for 64-bit keys with a payload, for floats and for doubles. The
+    comparison sorts only run up to maxCmp keys, and all results
+    are checked for being sorted. The times are measured on the wall
+    clock, since the threads share the processor time
+  Usage: ./radixBench.out [maxN] [maxThreads] [maxCmp]
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include "../radix.h"
+#include <time.h>
+
+//===================================================================
+// Partitions arr[left:right] around its last element as in
+// quicksort.c, and returns the sorted position of the pivot
+size_t partition(int *arr, size_t left, size_t right) {
+  size_t pivotIdx = right - 1, i = left;
+  for (size_t j = left; j < right - 1; j++)
+    if (arr[j] < arr[pivotIdx])
+      SWAP(arr[i++], arr[j]);
+  SWAP(arr[i], arr[pivotIdx]);
+  return i;
+}
+
+//===================================================================
+// Sorts arr[left:right] as in quicksort.c
+void quickSort(int *arr, size_t left, size_t right) {
+  if (left + 1 < right) {
+    size_t pivotIdx = partition(arr, left, right);
+    quickSort(arr, left, pivotIdx);
+    quickSort(arr, pivotIdx + 1, right);
+  }
+}
+
+//===================================================================
+// Merges the sorted arr[left:mid] and arr[mid:right] as in
+// mergesort.c
+void merge(int *arr, size_t left, size_t mid, size_t right) {
+  int *sorted = safeMalloc((right - left) * sizeof(int));
+  size_t l = left, r = mid, s = 0;
+  while (l < mid && r < right) {
+    if (arr[l] < arr[r]) sorted[s++] = arr[l++];
+    else sorted[s++] = arr[r++];
+  }
+  while (l < mid) sorted[s++] = arr[l++];
+  while (r < right) sorted[s++] = arr[r++];
+  for (size_t i = left; i < right; i++)
+    arr[i] = sorted[i - left];
+  free(sorted);
+}
+
+//===================================================================
+// Sorts arr[left:right] as in mergesort.c
+void mergeSort(int *arr, size_t left, size_t right) {
+  if (left + 1 < right) {
+    size_t mid = left + (right - left) / 2;
+    mergeSort(arr, left, mid);
+    mergeSort(arr, mid, right);
+    merge(arr, left, mid, right);
+  }
+}
+
+//===================================================================
+// Returns the time in seconds since start, measured on the wall
+// clock
+double elapsed(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) +
+         (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+  // Defines a function that returns true if the first n entries of
+  // an array of the given type are in ascending order
+#define DEFINE_SORTED(name, type) \
+bool name(type *arr, size_t n) { \
+  for (size_t i = 1; i < n; i++) \
+    if (arr[i] < arr[i - 1]) \
+      return false; \
+  return true; \
+}
+
+DEFINE_SORTED(sortedInt, int)
+DEFINE_SORTED(sortedU64, uint64_t)
+DEFINE_SORTED(sortedDouble, double)
+DEFINE_SORTED(sortedFloat, float)
+
+//===================================================================
+// Shows a row of the table: the name of a sort, its number of
+// threads (0 for none), its time, and whether it sorted correctly
+void showRow(char const *name, size_t threads, double time,
+             bool ok) {
+  char t[24] = "";
+  if (threads)
+    snprintf(t, sizeof(t), "%zu", threads);
+  printf("  %-12s  %7s  %9.4fs%s\n", name, t, time,
+         ok ? "" : " (wrong!)");
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxN = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000000;
+  size_t maxThreads = argc > 2 ? strtoul(argv[2], NULL, 10)
+                               : radixProcessors();
+  size_t maxCmp = argc > 3 ? strtoul(argv[3], NULL, 10) : 100000000;
+  srand(42);
+
+  for (size_t n = 1000000; n <= maxN; n *= 10) {
+    int *input = safeMalloc(n * sizeof(int));
+    int *arr = safeMalloc(n * sizeof(int));
+    for (size_t i = 0; i < n; i++)
+      input[i] = (int)((unsigned) rand() << 16 ^ rand());
+
+    printf("n = %zu\n", n);
+    printf("  %-12s  %7s  %10s\n", "sort", "threads", "time");
+    struct timespec start;
+
+    if (n <= maxCmp) {
+      memcpy(arr, input, n * sizeof(int));
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      quickSort(arr, 0, n);
+      showRow("quicksort", 0, elapsed(&start), sortedInt(arr, n));
+      memcpy(arr, input, n * sizeof(int));
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      mergeSort(arr, 0, n);
+      showRow("mergesort", 0, elapsed(&start), sortedInt(arr, n));
+    }
+
+    for (unsigned bits = 8; bits <= 11; bits += 3)
+      for (size_t t = 1; t <= maxThreads; t++) {
+        memcpy(arr, input, n * sizeof(int));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        radixSortInt(arr, NULL, n, bits, t);
+        showRow(bits == 8 ? "radix 8" : "radix 11", t,
+                elapsed(&start), sortedInt(arr, n));
+      }
+    free(arr);
+
+      // 64-bit keys with their indices as payload
+    uint64_t *keys = safeMalloc(n * sizeof(uint64_t));
+    uint64_t *vals = safeMalloc(n * sizeof(uint64_t));
+    for (size_t i = 0; i < n; i++) {
+      keys[i] = (uint64_t) input[i] << 32 ^ (unsigned) rand();
+      vals[i] = i;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    radixSortU64(keys, vals, n, 8, maxThreads);
+    showRow("u64 + value", maxThreads, elapsed(&start),
+            sortedU64(keys, n));
+    free(vals);
+
+    double *dbls = (double *) keys;
+    for (size_t i = 0; i < n; i++)
+      dbls[i] = input[i] / 1000.0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    radixSortDouble(dbls, NULL, n, 8, maxThreads);
+    showRow("double", maxThreads, elapsed(&start),
+            sortedDouble(dbls, n));
+
+    float *flts = (float *) keys;
+    for (size_t i = 0; i < n; i++)
+      flts[i] = input[i] / 1000.0f;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    radixSortFloat(flts, NULL, n, 8, maxThreads);
+    showRow("float", maxThreads, elapsed(&start), sortedFloat(flts, n));
+    printf("\n");
+
+    free(keys);
+    free(input);
+  }
+  return 0;
+}
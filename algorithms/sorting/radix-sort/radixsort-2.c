@@ -0,0 +1,144 @@
+/*
+  file: radixsort-2.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: reads dates from stdin and sorts them in ascending
+    order using radix sort. Instead of sorting the dates through
+    pointers one field at a time, as in radixsort.c, each date is
+    turned into a single 64-bit key, which is sorted along with the
+    index of the date by the parallel LSD radix sort in radixlib;
+    the digits of the key that are the same for all dates are
+    skipped. If the fields span too wide a range to be combined 
+    into one 64-bit key, the dates are sorted one field at a time
+  time complexity: Θ(d(n+k)) where d is the number of 8-bit digits
+    of the keys that are not skipped, n is the number of dates and
+    k = 256 is the number of values of a digit
+*/
+
+#include "../../../lib/clib.h"
+#include "radixlib/radix.h"
+#include <limits.h>
+
+//===================================================================
+// Sorts the dates in ascending order using radix sort, where 
+// order[f] is the column of the f-th least significant field; 
+// returns the indices of the dates in sorted order. If the product
+// of the ranges of the three fields fits in 64 bits, each date is 
+// turned into a single key, in which each field is a digit in base
+// max - min + 1 of that field; otherwise, the dates are sorted one
+// field at a time, from the least to the most significant one, 
+// which is correct since the sort is stable
+uint64_t *radixSort (int *dates, size_t len, int *order) {
+
+  uint64_t *keys = safeCalloc(MAX(len, 1), sizeof(uint64_t));
+  uint64_t *idx = safeCalloc(MAX(len, 1), sizeof(uint64_t));
+  for (size_t i = 0; i < len; i++)
+    idx[i] = i;
+
+    // the minimum and the range of each field; the ranges are 
+    // computed in 64 bits, where they cannot overflow
+  int min[3];
+  uint64_t range[3], product = 1;
+  bool fits = true;
+  for (int field = 0; field < 3; field++) {
+    int col = order[field], lo = INT_MAX, hi = INT_MIN;
+    for (size_t i = 0; i < len; i++) {
+      lo = MIN(lo, dates[3 * i + col]);
+      hi = MAX(hi, dates[3 * i + col]);
+    }
+    min[field] = lo;
+    range[field] = len ? (uint64_t) ((int64_t) hi - lo) + 1 : 1;
+    if (product > UINT64_MAX / range[field])
+      fits = false;
+    else
+      product *= range[field];
+  }
+
+  if (fits) {
+      // from the most to the least significant field, each field 
+      // is appended to the keys as a digit in base range[field]
+    for (int field = 3; field--; ) 
+      for (size_t i = 0; i < len; i++)
+        keys[i] = keys[i] * range[field] + (uint64_t) 
+                  ((int64_t) dates[3 * i + order[field]] - min[field]);
+    radixSortU64(keys, idx, len, RADIX_BITS, radixProcessors());
+  } else 
+      // the keys of each pass are the offsets of one field of the
+      // dates in the current order
+    for (int field = 0; field < 3; field++) {
+      for (size_t i = 0; i < len; i++)
+        keys[i] = (uint64_t) ((int64_t) dates[3 * idx[i] + 
+                              order[field]] - min[field]);
+      radixSortU64(keys, idx, len, RADIX_BITS, radixProcessors());
+    }
+
+  free(keys);
+  return idx;
+}
+
+//===================================================================
+// Reads all dates from stdin, three fields per date
+int *readDates(size_t *len) {
+  size_t cap = 100;
+  int *dates = safeCalloc(3 * cap, sizeof(int));
+
+  while (scanf("%d-%d-%d\n", &dates[3 * *len],
+               &dates[3 * *len + 1], &dates[3 * *len + 2]) == 3) {
+    if (++*len == cap) {
+      cap *= 2;
+      dates = safeRealloc(dates, 3 * cap * sizeof(int));
+    }
+  }
+  return dates;
+}
+
+//===================================================================
+// Prints the dates in the input format, in the order of idx
+void printDates(int *dates, uint64_t *idx, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    int *date = dates + 3 * idx[i];
+    printf("%02d-%02d-%02d\n", date[0], date[1], date[2]);
+  }
+}
+
+//===================================================================
+// Reads the format in which the dates are given and determines
+// the order in which the fields should be sorted so that the
+// dates are sorted in ascending order
+void readOrder(int *order) {
+  char ch;
+  enum {DAY, MONTH, YEAR};
+
+  for (int field = 0; field < 3; field++) {
+    assert(scanf("%c", &ch) == 1);
+    switch (ch) {
+      case 'D': order[DAY] = field;
+        break;
+      case 'M': order[MONTH] = field;
+        break;
+      case 'Y': order[YEAR] = field;
+        break;
+      default: fprintf(stderr, "Invalid date format\n");
+        exit(EXIT_FAILURE);
+    }
+  }
+}
+
+//===================================================================
+
+int main () {
+
+  int order[3];
+  readOrder(order);
+
+  size_t len = 0;
+  int *dates = readDates(&len);
+
+  uint64_t *idx = radixSort(dates, len, order);
+  printDates(dates, idx, len);
+
+  free(idx);
+  free(dates);
+  return 0;
+}
@@ -0,0 +1,85 @@
+/* 
+  file: aca.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: multi-pattern string matching using the 
+    Aho-Corasick algorithm
+  input: the number of patterns k, followed by k patterns, one per 
+    line, and the text, which runs until the end of the input
+  time complexity: O(M) to build the automaton, where M is the 
+    total length of the patterns, and O(n + z) for matching, where 
+    z is the number of matches
+  assumption: length of the alphabet is 256 (ASCII)
+*/
+
+#include "../../../lib/clib.h"
+#include "aclib/ac.h"
+
+  // the shifts found for a pattern
+typedef struct {
+  size_t *shifts;
+  size_t len, cap;
+} shiftList;
+
+//===================================================================
+// Appends the shift of a match of pattern p to its list
+void addShift(size_t p, size_t shift, void *arg) {
+  shiftList *list = (shiftList *) arg + p;
+  if (list->len == list->cap) {
+    list->cap = list->cap ? 2 * list->cap : 8;
+    list->shifts = safeRealloc(list->shifts, 
+                               list->cap * sizeof(size_t));
+  }
+  list->shifts[list->len++] = shift;
+}
+
+//===================================================================
+// Finds all matches of all patterns in text in a single pass and
+// prints the valid shifts of each pattern
+void matcher(string *text, string **patterns, size_t k) {
+  
+  acAutomaton *A = acNew(patterns, k);
+  shiftList *lists = safeCalloc(k, sizeof(shiftList));
+  acMatch(A, text, addShift, lists);
+
+  for (size_t p = 0; p < k; p++) {
+    printf("Pattern: ");
+    showString(patterns[p]);
+    printf("Shifts: ");
+    for (size_t i = 0; i < lists[p].len; i++) 
+      printf(i ? ", %zu" : "%zu", lists[p].shifts[i]);
+    printf(lists[p].len ? "\n" : "None.\n");
+    free(lists[p].shifts);
+  }
+  free(lists);
+  acFree(A);
+}
+
+//===================================================================
+
+int main () {
+
+  size_t k; 
+  reader *R = stdinReader();
+  if (! readerScan(R, "%zu", &k)) {
+    fprintf(stderr, "Invalid input\n");
+    return EXIT_FAILURE;
+  }
+  readerSkipLine(R);
+
+  string **patterns = safeCalloc(k, sizeof(string *));
+  for (size_t p = 0; p < k; p++) {
+    READ_STRING(pattern, '\n');
+    patterns[p] = pattern;
+  }
+  READ_STRING(text, EOF);
+
+  matcher(text, patterns, k);
+
+  for (size_t p = 0; p < k; p++) 
+    freeString(patterns[p]);
+  free(patterns);
+  freeString(text);
+  return 0;
+}
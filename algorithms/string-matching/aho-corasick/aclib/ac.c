@@ -0,0 +1,274 @@
+/*
+  file: ac.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: Aho-Corasick automaton for matching a set of patterns
+    in a single pass over the text, stored as a double array
+*/
+
+#include "ac.h"
+
+  // A node of the trie of the patterns, which is only used while
+  // building the automaton; the children of a node form a list
+typedef struct {
+  uint32_t child;       // first child, or 0 if none
+  uint32_t sibling;     // next sibling, or 0 if none
+  uint32_t state;       // state of the node in the automaton
+  int32_t out;          // first pattern ending in the node, or -1
+  unsigned char c;      // character on the edge to the node
+} trieNode;
+
+//===================================================================
+// Builds the trie of the patterns and returns its nodes, with the
+// root at index 0; the number of nodes is stored in *nNodes
+static trieNode *buildTrie(acAutomaton *A, string **patterns,
+                           size_t k, size_t *nNodes) {
+
+  size_t cap = 1, n = 1;
+  for (size_t p = 0; p < k; p++)
+    cap += strLen(patterns[p]);
+  trieNode *trie = safeCalloc(cap, sizeof(trieNode));
+  trie[0].out = -1;
+
+  for (size_t p = 0; p < k; p++) {
+    uint32_t u = 0;
+    for (size_t i = 0; i < strLen(patterns[p]); i++) {
+      unsigned char c = charAt(patterns[p], i);
+      uint32_t v = trie[u].child;
+      while (v && trie[v].c != c)
+        v = trie[v].sibling;
+      if (! v) {
+          // add a new child in front of the list
+        v = n++;
+        trie[v].c = c;
+        trie[v].out = -1;
+        trie[v].sibling = trie[u].child;
+        trie[u].child = v;
+      }
+      u = v;
+    }
+      // chain the duplicates of a pattern, keeping the first one
+      // in front, so that they are reported in input order; the
+      // empty pattern is not added to the root
+    A->patNext[p] = -1;
+    if (u == 0)
+      continue;
+    if (trie[u].out < 0)
+      trie[u].out = p;
+    else {
+      int32_t q = trie[u].out;
+      while (A->patNext[q] >= 0)
+        q = A->patNext[q];
+      A->patNext[q] = p;
+    }
+  }
+  *nNodes = n;
+  return trie;
+}
+
+  // The free slots of the double array are kept in a doubly linked 
+  // list in increasing order, so that finding a base for a node 
+  // skips all slots that are already in use
+typedef struct {
+  acAutomaton *A;       // the automaton under construction
+  uint32_t *next;       // next free slot, or AC_EMPTY if none
+  uint32_t *prev;       // previous free slot, or AC_EMPTY if none
+  uint32_t head, tail;  // first and last free slot
+} builder;
+
+//===================================================================
+// Grows the double array so that it has at least size slots, and
+// appends the new slots to the free list
+static void growArrays(builder *B, size_t size) {
+  acAutomaton *A = B->A;
+  if (size <= A->size)
+    return;
+  size_t cap = MAX(size, 2 * A->size);
+  A->base = safeRealloc(A->base, cap * sizeof(uint32_t));
+  A->check = safeRealloc(A->check, cap * sizeof(uint32_t));
+  A->fail = safeRealloc(A->fail, cap * sizeof(uint32_t));
+  A->dict = safeRealloc(A->dict, cap * sizeof(uint32_t));
+  A->out = safeRealloc(A->out, cap * sizeof(int32_t));
+  B->next = safeRealloc(B->next, cap * sizeof(uint32_t));
+  B->prev = safeRealloc(B->prev, cap * sizeof(uint32_t));
+  for (size_t i = A->size; i < cap; i++) {
+    A->base[i] = A->fail[i] = A->dict[i] = 0;
+    A->check[i] = AC_EMPTY;
+    A->out[i] = -1;
+    B->prev[i] = B->tail;
+    B->next[i] = AC_EMPTY;
+    if (B->tail == AC_EMPTY) 
+      B->head = i;
+    else 
+      B->next[B->tail] = i;
+    B->tail = i;
+  }
+  A->size = cap;
+}
+
+//===================================================================
+// Marks slot t as used by a child of state s
+static void useSlot(builder *B, uint32_t t, uint32_t s) {
+  B->A->check[t] = s;
+  if (B->prev[t] == AC_EMPTY) 
+    B->head = B->next[t];
+  else 
+    B->next[B->prev[t]] = B->next[t];
+  if (B->next[t] == AC_EMPTY) 
+    B->tail = B->prev[t];
+  else 
+    B->prev[B->next[t]] = B->prev[t];
+}
+
+//===================================================================
+// Returns the goto transition from state s on character c, or 0 if
+// there is none
+static inline uint32_t goTo(acAutomaton *A, uint32_t s,
+                            unsigned char c) {
+  uint32_t t = A->base[s] + c;
+  return t < A->size && A->check[t] == s ? t : 0;
+}
+
+//===================================================================
+// Finds a base b ≥ 1 for which the slots b + c are free for all 
+// children c of trie node u, by trying to put the first child in 
+// each free slot in turn
+static uint32_t findBase(builder *B, trieNode *trie, uint32_t u) {
+
+  acAutomaton *A = B->A;
+  unsigned char c0 = trie[trie[u].child].c;
+
+  for (uint32_t slot = B->head; ; slot = B->next[slot]) {
+      // make sure all slots b + c exist, and that the free list 
+      // does not run out
+    if (slot + 257 > A->size || B->next[slot] == AC_EMPTY)
+      growArrays(B, slot + 257);
+    if (slot <= c0)
+      continue;
+    uint32_t b = slot - c0, v = trie[u].child;
+    while (v && A->check[b + trie[v].c] == AC_EMPTY)
+      v = trie[v].sibling;
+    if (! v)
+      return b;
+  }
+}
+
+//===================================================================
+// Builds the automaton for the given k patterns
+acAutomaton *acNew(string **patterns, size_t k) {
+
+  acAutomaton *A = safeCalloc(1, sizeof(acAutomaton));
+  A->nPatterns = k;
+  A->patLen = safeCalloc(k + 1, sizeof(size_t));
+  A->patNext = safeCalloc(k + 1, sizeof(int32_t));
+  for (size_t p = 0; p < k; p++)
+    A->patLen[p] = strLen(patterns[p]);
+
+  size_t nNodes;
+  trieNode *trie = buildTrie(A, patterns, k, &nNodes);
+  builder B = { A, NULL, NULL, AC_EMPTY, AC_EMPTY };
+  growArrays(&B, 512);
+  useSlot(&B, 0, 0);
+  A->out[0] = trie[0].out;
+
+    // assign states to the trie nodes in breadth-first order, and
+    // compute the failure links along the way: the failure link of
+    // a child only depends on states at smaller depths, whose
+    // children already have their states
+  uint32_t *queue = safeCalloc(nNodes, sizeof(uint32_t));
+  size_t head = 0, tail = 0;
+  queue[tail++] = 0;
+  while (head < tail) {
+    uint32_t u = queue[head++], s = trie[u].state;
+    if (! trie[u].child)
+      continue;
+
+      // place all children of u in the double array
+    uint32_t b = findBase(&B, trie, u);
+    A->base[s] = b;
+    for (uint32_t v = trie[u].child; v; v = trie[v].sibling) {
+      uint32_t t = b + trie[v].c;
+      useSlot(&B, t, s);
+      A->out[t] = trie[v].out;
+      trie[v].state = t;
+      queue[tail++] = v;
+    }
+
+      // compute the failure and dictionary links of the children
+    for (uint32_t v = trie[u].child; v; v = trie[v].sibling) {
+      uint32_t t = trie[v].state, f = 0;
+      if (s != 0) {
+        for (f = A->fail[s]; f && ! goTo(A, f, trie[v].c); )
+          f = A->fail[f];
+        f = goTo(A, f, trie[v].c);
+      }
+      A->fail[t] = f;
+      A->dict[t] = A->out[f] >= 0 ? f : A->dict[f];
+    }
+  }
+  A->nStates = nNodes;
+
+    // the root transitions, where a missing one leads back to it
+  for (size_t c = 0; c < 256; c++)
+    A->root[c] = goTo(A, 0, c);
+
+  free(B.next);
+  free(B.prev);
+  free(queue);
+  free(trie);
+  return A;
+}
+
+//===================================================================
+// Deallocates the automaton
+void acFree(acAutomaton *A) {
+  free(A->base);
+  free(A->check);
+  free(A->fail);
+  free(A->dict);
+  free(A->out);
+  free(A->patLen);
+  free(A->patNext);
+  free(A);
+}
+
+//===================================================================
+// Reports all patterns recognized in state s, where i is the
+// index of the last character of the match; returns their number
+static size_t reportAll(acAutomaton *A, uint32_t s, size_t i,
+                        acReport report, void *arg) {
+  size_t count = 0;
+  if (A->out[s] < 0)
+    s = A->dict[s];
+  for ( ; s; s = A->dict[s])
+    for (int32_t p = A->out[s]; p >= 0; p = A->patNext[p]) {
+      if (report)
+        report(p, i + 1 - A->patLen[p], arg);
+      count++;
+    }
+  return count;
+}
+
+//===================================================================
+// Reports all matches of all patterns in text in a single pass
+size_t acMatch(acAutomaton *A, string *text, acReport report,
+               void *arg) {
+
+  uint32_t *base = A->base, *check = A->check, *fail = A->fail;
+  unsigned char *T = str(text);
+  size_t n = strLen(text), count = 0;
+  uint32_t s = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    unsigned char c = T[i];
+      // follow failure links until a transition on c exists;
+      // the slot base[s] + c always lies within the double array
+    while (s && check[base[s] + c] != s)
+      s = fail[s];
+    s = s ? base[s] + c : A->root[c];
+    if (A->out[s] >= 0 || A->dict[s])
+      count += reportAll(A, s, i, report, arg);
+  }
+  return count;
+}
@@ -0,0 +1,48 @@
+#ifndef AC_H_INCLUDED
+#define AC_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // An Aho-Corasick automaton for a set of patterns, stored as a 
+  // double array: the goto transition from state s on character c 
+  // leads to state t = base[s] + c if check[t] = s. The root is 
+  // state 0; its transitions are also kept in a full table, so that
+  // the matcher never has to follow failure links out of it
+typedef struct {
+  uint32_t *base;       // base offsets of the states
+  uint32_t *check;      // parent state of each slot, or AC_EMPTY
+  uint32_t *fail;       // failure link of each state
+  uint32_t *dict;       // nearest state on the failure chain that 
+                        // recognizes a pattern, or 0 if none
+  int32_t *out;         // first pattern recognized by each state, 
+                        // or -1 if none
+  uint32_t root[256];   // transitions of the root state
+  size_t size;          // number of slots in the double array
+  size_t nStates;       // number of states
+  size_t nPatterns;     // number of patterns
+  size_t *patLen;       // length of each pattern
+  int32_t *patNext;     // next pattern with the same string, or -1
+} acAutomaton;
+
+#define AC_EMPTY UINT32_MAX   // marks an unused slot
+
+  // Called for each match of pattern p at the given shift
+typedef void (*acReport)(size_t p, size_t shift, void *arg);
+
+  // Builds the automaton for the given k patterns; empty patterns
+  // are never reported
+acAutomaton *acNew(string **patterns, size_t k);
+
+  // Deallocates the automaton
+void acFree(acAutomaton *A);
+
+  // Reports all matches of all patterns in text in a single pass, 
+  // ordered by their end position, and returns their number; 
+  // report may be NULL to only count the matches
+size_t acMatch(acAutomaton *A, string *text, acReport report, 
+               void *arg);
+
+#endif // AC_H_INCLUDED
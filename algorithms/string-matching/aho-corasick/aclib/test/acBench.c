@@ -0,0 +1,119 @@
+/*
+  Benchmark of the Aho-Corasick automaton against running the
+    Knuth-Morris-Pratt matcher once for each pattern
+  The text consists of random words; the patterns are random 
+    substrings of the text of 8 to 16 characters. For each number 
+    of patterns k, the throughput is given in MB of text per second
+    for matching all k patterns, as long as KMP finishes in 
+    reasonable time, and the match counts are compared
+  Usage: ./acBench.out [textMB] [maxPatterns]
+  Author: David De Potter
+*/
+
+#include "../ac.h"
+#include <time.h>
+
+//===================================================================
+// Returns a random text of n characters, consisting of lowercase 
+// words of 1 to 10 letters separated by spaces
+string *randomText(size_t n) {
+  string *text = newString(n + 1);
+  for (size_t i = 0; i < n; i++) 
+    text->data[i] = rand() % 6 ? 'a' + rand() % 26 : ' ';
+  text->size = n;
+  return text;
+}
+
+//===================================================================
+// Returns a random substring of text of 8 to 16 characters
+string *randomPattern(string *text) {
+  size_t m = 8 + rand() % 9;
+  size_t s = (size_t) rand() % (strLen(text) - m);
+  string *pattern = newString(m + 1);
+  memcpy(pattern->data, str(text) + s, m);
+  pattern->size = m;
+  return pattern;
+}
+
+//===================================================================
+// Counts the matches of pattern in text in the same way as the 
+// matcher in kmp.c, computing the prefix function first
+size_t kmpCount(string *text, string *pattern) {
+  
+  size_t m = strLen(pattern), count = 0;
+  size_t *pi = safeCalloc(m, sizeof(size_t));
+  for (size_t q = 1, k = 0; q < m; q++) {
+    while (k > 0 && charAt(pattern, k) != charAt(pattern, q))
+      k = pi[k - 1];
+    if (charAt(pattern, k) == charAt(pattern, q)) 
+      k++;
+    pi[q] = k;
+  }
+  for (size_t i = 0, q = 0; i < strLen(text); i++) {
+    while (q > 0 && charAt(pattern, q) != charAt(text, i)) 
+      q = pi[q - 1];   
+    if (charAt(pattern, q) == charAt(text, i)) 
+      q++;
+    if (q == m) {
+      count++;
+      q = pi[q - 1];
+    }
+  }
+  free(pi);
+  return count;
+}
+
+//===================================================================
+// Returns the number of seconds since start
+double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t textMB = argc > 1 ? strtoul(argv[1], NULL, 10) : 16;
+  size_t maxPatterns = argc > 2 ? strtoul(argv[2], NULL, 10) 
+                                : 10000;
+  srand(42);
+
+  string *text = randomText(textMB << 20);
+  printf("Text: %zu MB\n", textMB);
+  printf("%10s  %10s  %10s  %10s  %12s\n", "patterns", "build", 
+         "AC MB/s", "KMP MB/s", "matches");
+
+  for (size_t k = 1; k <= maxPatterns; k *= 10) {
+    string **patterns = safeCalloc(k, sizeof(string *));
+    for (size_t p = 0; p < k; p++)
+      patterns[p] = randomPattern(text);
+
+    clock_t start = clock();
+    acAutomaton *A = acNew(patterns, k);
+    double build = elapsed(start);
+    
+    start = clock();
+    size_t acMatches = acMatch(A, text, NULL, NULL);
+    double acTime = elapsed(start);
+    printf("%10zu  %9.4fs  %10.1f", k, build, textMB / acTime);
+
+      // KMP needs k passes over the text
+    if (k <= 100) {
+      size_t kmpMatches = 0;
+      start = clock();
+      for (size_t p = 0; p < k; p++)
+        kmpMatches += kmpCount(text, patterns[p]);
+      printf("  %10.1f", textMB / elapsed(start));
+      if (kmpMatches != acMatches)
+        printf(" (wrong!)");
+    } else 
+      printf("  %10s", "-");
+    printf("  %12zu\n", acMatches);
+
+    acFree(A);
+    for (size_t p = 0; p < k; p++)
+      freeString(patterns[p]);
+    free(patterns);
+  }
+  freeString(text);
+  return 0;
+}
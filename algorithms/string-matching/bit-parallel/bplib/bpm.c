@@ -0,0 +1,281 @@
+/*
+  file: bpm.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: bit-parallel string matching with Shift-Or and
+    BNDM, and a first/last character filter that uses SSE2 or
+    AVX2 instructions if the CPU supports them, and falls back to 
+    KMP on texts where it finds too many false candidates
+*/
+
+#include "bpm.h"
+
+  // The filter falls back to KMP once a block of shifts has more 
+  // than this number of candidates that fail the verification, as
+  // on periodic text almost every shift may be a candidate, each of
+  // which costs up to m comparisons
+#define MAX_FAILS 4
+
+  // BNDM falls back to Shift-Or once it has read more than this 
+  // many characters per character that its window has advanced
+#define MAX_READS 8
+
+  // Patterns up to this length are matched with Shift-Or, as their 
+  // BNDM windows are too short to skip much of the text
+#define SHORT_LEN 4
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BP_X86
+#endif
+
+//===================================================================
+// Shift-Or matcher for the shifts from s onwards: bit i of the state
+// D is 0 if the last i + 1 characters of the text match the first 
+// i + 1 characters of the pattern, so that a match ends where bit
+// m - 1 becomes 0
+static size_t shiftOrFrom(unsigned char const *T, size_t n, size_t s,
+                          unsigned char const *P, size_t m,
+                          bpReport report, void *arg) {
+  
+    // bit i of B[c] is 0 if P[i] = c
+  uint64_t B[256], D = ~0ULL, high = 1ULL << (m - 1);
+  size_t count = 0;
+  for (size_t c = 0; c < 256; c++) 
+    B[c] = ~0ULL;
+  for (size_t i = 0; i < m; i++) 
+    B[P[i]] &= ~(1ULL << i);
+
+  for (size_t i = s; i < n; i++) {
+    D = (D << 1) | B[T[i]];
+    if (! (D & high)) {
+      if (report) 
+        report(i + 1 - m, arg);
+      count++;
+    }
+  }
+  return count;
+}
+
+//===================================================================
+// Shift-Or matcher
+size_t shiftOr(string *pattern, string *text, bpReport report, 
+               void *arg) {
+  
+  size_t m = strLen(pattern), n = strLen(text);
+  if (m == 0 || m > BP_MAX_LEN || m > n)
+    return 0;
+  return shiftOrFrom(str(text), n, 0, str(pattern), m, report, arg);
+}
+
+//===================================================================
+// BNDM matcher: the window of m characters is read from right to 
+// left, where bit m - 1 - i of the state D is 1 if the characters 
+// read so far occur in the pattern at position i. If D has bit m - 1
+// set, the characters read are a prefix of the pattern, and the 
+// window can be shifted up to that prefix; if D becomes 0, they do
+// not occur in the pattern at all. On periodic texts, a window may
+// read up to m characters only to advance by one, so the rest of 
+// the text is left to Shift-Or once too many characters were read
+size_t bndm(string *pattern, string *text, bpReport report, 
+            void *arg) {
+
+  size_t m = strLen(pattern), n = strLen(text), count = 0;
+  if (m == 0 || m > BP_MAX_LEN || m > n)
+    return 0;
+
+    // bit m - 1 - i of B[c] is 1 if P[i] = c
+  uint64_t B[256] = { 0 }, high = 1ULL << (m - 1);
+  uint64_t mask = m == 64 ? ~0ULL : (1ULL << m) - 1;
+  for (size_t i = 0; i < m; i++) 
+    B[charAt(pattern, i)] |= 1ULL << (m - 1 - i);
+
+  unsigned char const *T = str(text);
+  size_t reads = 0;
+  for (size_t pos = 0; pos <= n - m; ) {
+    size_t j = m, last = m;
+    uint64_t D = mask;
+      // after m characters, only the pattern itself can be left,
+      // which is shifted out of the mask
+    while (D) {
+      D &= B[T[pos + j - 1]];
+      j--;
+      if (D & high) {
+        if (j > 0) 
+          last = j;
+        else {
+          if (report) 
+            report(pos, arg);
+          count++;
+        }
+      }
+      D = (D << 1) & mask;
+    }
+    reads += m - j;
+    pos += last;
+    if (reads > MAX_READS * (pos + m))
+      return count + shiftOrFrom(T, n, pos, str(pattern), m, report,
+                                 arg);
+  }
+  return count;
+}
+
+//===================================================================
+// Reports all valid shifts from s onwards with the KMP matcher, for
+// any pattern length; O(m + n - s) time
+static size_t kmpFrom(unsigned char const *T, size_t n, size_t s,
+                      unsigned char const *P, size_t m, 
+                      bpReport report, void *arg) {
+
+  size_t *pi = safeCalloc(m, sizeof(size_t)), count = 0;
+  for (size_t q = 1, k = 0; q < m; q++) {
+    while (k > 0 && P[k] != P[q])
+      k = pi[k - 1];
+    if (P[k] == P[q]) 
+      k++;
+    pi[q] = k;
+  }
+  for (size_t i = s, q = 0; i < n; i++) {
+    while (q > 0 && P[q] != T[i]) 
+      q = pi[q - 1];   
+    if (P[q] == T[i]) 
+      q++;
+    if (q == m) {
+      if (report) 
+        report(i + 1 - m, arg);
+      count++;
+      q = pi[q - 1];
+    }
+  }
+  free(pi);
+  return count;
+}
+
+//===================================================================
+// Verifies a candidate shift s whose first and last characters 
+// already match, and reports it if valid
+static inline size_t verify(unsigned char const *T, size_t s, 
+                            unsigned char const *P, size_t m,
+                            bpReport report, void *arg) {
+  if (m > 2 && memcmp(T + s + 1, P + 1, m - 2) != 0)
+    return 0;
+  if (report) 
+    report(s, arg);
+  return 1;
+}
+
+//===================================================================
+// Checks the shifts from s up to n - m one at a time, in blocks of
+// 32 shifts, and falls back to KMP after a block with too many 
+// failed candidates
+static size_t filterScalar(unsigned char const *T, size_t n, 
+                           size_t s, unsigned char const *P, 
+                           size_t m, bpReport report, void *arg) {
+  size_t count = 0, fails = 0;
+  for ( ; s + m <= n; s++) {
+    if (T[s] == P[0] && T[s + m - 1] == P[m - 1]) {
+      size_t found = verify(T, s, P, m, report, arg);
+      count += found;
+      fails += ! found;
+    }
+    if (s % 32 == 31) {
+      if (fails > MAX_FAILS)
+        return count + kmpFrom(T, n, s + 1, P, m, report, arg);
+      fails = 0;
+    }
+  }
+  return count;
+}
+
+#ifdef BP_X86
+
+  // Checks the shifts in blocks of the given vector width, where 
+  // each bit of the comparison mask stands for one candidate shift;
+  // after a block with too many failed candidates, the rest of the
+  // text is left to KMP, and otherwise the remaining shifts are 
+  // checked one at a time
+#define FILTER_BLOCKS(vec, width, set1, loadu, cmpeq, and, movemask) \
+  size_t count = 0, s = 0, fails, found; \
+  vec first = set1(P[0]), last = set1(P[m - 1]); \
+  for ( ; s + m - 1 + width <= n; s += width) { \
+    vec bf = loadu((vec const *) (T + s)); \
+    vec bl = loadu((vec const *) (T + s + m - 1)); \
+    uint32_t cand = movemask(and(cmpeq(bf, first), \
+                                 cmpeq(bl, last))); \
+    for (fails = 0; cand; cand &= cand - 1) { \
+      found = verify(T, s + __builtin_ctz(cand), P, m, report, arg); \
+      count += found; \
+      fails += ! found; \
+    } \
+    if (fails > MAX_FAILS) \
+      return count + kmpFrom(T, n, s + width, P, m, report, arg); \
+  } \
+  return count + filterScalar(T, n, s, P, m, report, arg);
+
+//===================================================================
+// Checks 16 shifts at once using SSE2 instructions
+__attribute__((target("sse2")))
+static size_t filterSSE2(unsigned char const *T, size_t n, 
+                         unsigned char const *P, size_t m, 
+                         bpReport report, void *arg) {
+  FILTER_BLOCKS(__m128i, 16, _mm_set1_epi8, _mm_loadu_si128, 
+                _mm_cmpeq_epi8, _mm_and_si128, _mm_movemask_epi8)
+}
+
+//===================================================================
+// Checks 32 shifts at once using AVX2 instructions
+__attribute__((target("avx2")))
+static size_t filterAVX2(unsigned char const *T, size_t n, 
+                         unsigned char const *P, size_t m, 
+                         bpReport report, void *arg) {
+  FILTER_BLOCKS(__m256i, 32, _mm256_set1_epi8, _mm256_loadu_si256,
+                _mm256_cmpeq_epi8, _mm256_and_si256, 
+                _mm256_movemask_epi8)
+}
+
+#endif
+
+//===================================================================
+// Returns the best filter level supported by the CPU
+bpLevel bpSimdLevel(void) {
+#ifdef BP_X86
+  if (__builtin_cpu_supports("avx2"))
+    return BP_AVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return BP_SSE2;
+#endif
+  return BP_SCALAR;
+}
+
+//===================================================================
+// Matcher that filters the shifts on their first and last characters
+size_t firstLastFilter(string *pattern, string *text, bpLevel level,
+                       bpReport report, void *arg) {
+  
+  size_t m = strLen(pattern), n = strLen(text);
+  unsigned char const *T = str(text), *P = str(pattern);
+  if (m == 0 || m > n)
+    return 0;
+#ifdef BP_X86
+  if (level == BP_AVX2)
+    return filterAVX2(T, n, P, m, report, arg);
+  if (level == BP_SSE2)
+    return filterSSE2(T, n, P, m, report, arg);
+#endif
+  return filterScalar(T, n, 0, P, m, report, arg);
+}
+
+//===================================================================
+// Selects the best matcher for the pattern and the CPU: Shift-Or 
+// for the shortest patterns, BNDM for the other patterns that fit 
+// in a word, and the filter with the best level for longer ones
+size_t bpMatch(string *pattern, string *text, bpReport report, 
+               void *arg) {
+  size_t m = strLen(pattern);
+  if (m <= SHORT_LEN)
+    return shiftOr(pattern, text, report, arg);
+  if (m <= BP_MAX_LEN)
+    return bndm(pattern, text, report, arg);
+  return firstLastFilter(pattern, text, bpSimdLevel(), report, arg);
+}
@@ -0,0 +1,52 @@
+#ifndef BPM_H_INCLUDED
+#define BPM_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // maximum pattern length for the bit-parallel matchers
+#define BP_MAX_LEN 64
+
+  // instruction sets for the first/last character filter
+typedef enum { BP_SCALAR, BP_SSE2, BP_AVX2 } bpLevel;
+
+  // Called for each valid shift of the pattern
+typedef void (*bpReport)(size_t shift, void *arg);
+
+  // The matchers below report all valid shifts of the pattern in 
+  // text in increasing order, and return their number; report may
+  // be NULL to only count them
+
+  // Shift-Or matcher, for patterns of at most BP_MAX_LEN characters
+size_t shiftOr(string *pattern, string *text, bpReport report, 
+               void *arg);
+
+  // Backward nondeterministic DAWG matcher (BNDM), for patterns of 
+  // at most BP_MAX_LEN characters; falls back to Shift-Or when it
+  // reads too many characters, as it does on periodic texts
+size_t bndm(string *pattern, string *text, bpReport report, 
+            void *arg);
+
+  // Matcher that compares the first and last characters of the 
+  // pattern with 1, 16 or 32 text positions at once, depending on 
+  // the given level, and verifies the candidates; for patterns of
+  // any length. Once a block of shifts has too many candidates that
+  // fail the verification, the rest of the text is matched with 
+  // KMP, so that periodic texts, on which nearly every shift is a
+  // candidate, take linear time. The level should be supported by
+  // the CPU
+size_t firstLastFilter(string *pattern, string *text, bpLevel level,
+                       bpReport report, void *arg);
+
+  // Returns the best filter level supported by the CPU
+bpLevel bpSimdLevel(void);
+
+  // Selects the best matcher for the pattern and the CPU: Shift-Or
+  // or BNDM for patterns of at most BP_MAX_LEN characters, and the 
+  // filter for longer patterns
+size_t bpMatch(string *pattern, string *text, bpReport report, 
+               void *arg);
+
+#endif // BPM_H_INCLUDED
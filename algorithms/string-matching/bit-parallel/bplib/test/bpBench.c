@@ -0,0 +1,178 @@
+/*
+  Benchmark of the bit-parallel matchers and the first/last 
+    character filter against the KMP and Rabin-Karp matchers
+  The pattern and text are read from a test input file, as used by
+    the string matchers, and the text is repeated until it reaches
+    the given size. For each matcher, the throughput is given in MB
+    of text per second, and the match counts are compared
+  Usage: ./bpBench.out file [textMB]
+  Example: ./bpBench.out ../../tests/1.in 1024
+  Author: David De Potter
+*/
+
+#include "../bpm.h"
+#include "../../../rabin-karp/rklib/rk.h"
+#include <time.h>
+
+//===================================================================
+// Counts the matches of pattern in text in the same way as the 
+// matcher in kmp.c, computing the prefix function first
+size_t kmpCount(string *pattern, string *text, bpReport report, 
+                void *arg) {
+  
+  size_t m = strLen(pattern), count = 0;
+  size_t *pi = safeCalloc(m, sizeof(size_t));
+  for (size_t q = 1, k = 0; q < m; q++) {
+    while (k > 0 && charAt(pattern, k) != charAt(pattern, q))
+      k = pi[k - 1];
+    if (charAt(pattern, k) == charAt(pattern, q)) 
+      k++;
+    pi[q] = k;
+  }
+  for (size_t i = 0, q = 0; i < strLen(text); i++) {
+    while (q > 0 && charAt(pattern, q) != charAt(text, i)) 
+      q = pi[q - 1];   
+    if (charAt(pattern, q) == charAt(text, i)) 
+      q++;
+    if (q == m) {
+      count++;
+      q = pi[q - 1];
+    }
+  }
+  free(pi);
+  return count;
+}
+
+//===================================================================
+// Counts the matches of pattern in text with the rolling hash of 
+// the computeShifts function in rka.c, taken modulo 2^61 - 1
+size_t rkaCount(string *pattern, string *text, bpReport report, 
+                void *arg) {
+  
+  size_t m = strLen(pattern), n = strLen(text), count = 0;
+  uint64_t pHash = 0, tHash = 0, h = 1, d = 256; 
+  for (size_t i = 0; i < m - 1; i++) 
+    h = mulP(h, d);
+  for (size_t i = 0; i < m; i++) {
+    pHash = modP(mulP(pHash, d) + charAt(pattern, i));
+    tHash = modP(mulP(tHash, d) + charAt(text, i));
+  }
+  for (size_t i = 0; i <= n - m; i++) {
+    if (pHash == tHash && memcmp(str(text) + i, str(pattern), m) == 0)
+      count++;
+    if (i < n - m) 
+      tHash = modP(mulP(modP(tHash + RK_MOD 
+                             - mulP(charAt(text, i), h)), d) 
+                   + charAt(text, m + i));
+  }
+  return count;
+}
+
+//===================================================================
+// Wrappers for the filter at each level
+size_t filterScalar(string *pattern, string *text, bpReport report,
+                    void *arg) {
+  return firstLastFilter(pattern, text, BP_SCALAR, report, arg);
+}
+
+size_t filterSSE2(string *pattern, string *text, bpReport report,
+                  void *arg) {
+  return firstLastFilter(pattern, text, BP_SSE2, report, arg);
+}
+
+size_t filterAVX2(string *pattern, string *text, bpReport report,
+                  void *arg) {
+  return firstLastFilter(pattern, text, BP_AVX2, report, arg);
+}
+
+//===================================================================
+// Reads the pattern (first line) and text (rest) from the file, 
+// and repeats the text until it has the given size
+bool readInput(char const *path, size_t size, string **pattern, 
+               string **text) {
+  FILE *file = fopen(path, "rb");
+  if (! file) {
+    fprintf(stderr, "Cannot open %s\n", path);
+    return false;
+  }
+  reader *R = readerNew(file, 0);
+  *pattern = newString(100);
+  int c;
+  while ((c = readerChar(R)) != EOF && c != '\n') {
+    if ((*pattern)->size + 1 == (*pattern)->cap) {
+      (*pattern)->cap *= 2;
+      (*pattern)->data = safeRealloc((*pattern)->data, 
+                                     (*pattern)->cap);
+    }
+    (*pattern)->data[(*pattern)->size++] = c;
+  }
+  (*pattern)->data[(*pattern)->size] = '\0';
+
+  *text = newString(size + 1);
+  size_t len = 0;
+  while ((c = readerChar(R)) != EOF && len < size)
+    (*text)->data[len++] = c;
+  readerFree(R);
+  fclose(file);
+  if (len == 0) {
+    fprintf(stderr, "Empty text in %s\n", path);
+    return false;
+  }
+  for (size_t i = len; i < size; i++)
+    (*text)->data[i] = (*text)->data[i - len];
+  (*text)->size = size;
+  return true;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s file [textMB]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  size_t textMB = argc > 2 ? strtoul(argv[2], NULL, 10) : 256;
+  string *pattern, *text;
+  if (! readInput(argv[1], textMB << 20, &pattern, &text))
+    return EXIT_FAILURE;
+
+  size_t m = strLen(pattern);
+  bpLevel level = bpSimdLevel();
+  printf("Pattern length: %zu, text: %zu MB, SIMD: %s\n", m, textMB,
+         level == BP_AVX2 ? "AVX2" : level == BP_SSE2 ? "SSE2" 
+                                                      : "none");
+  
+  struct {
+    char const *name;
+    size_t (*match)(string *, string *, bpReport, void *);
+    bool enabled;
+  } matchers[] = {
+    { "KMP", kmpCount, true },
+    { "Rabin-Karp", rkaCount, true },
+    { "Shift-Or", shiftOr, m <= BP_MAX_LEN },
+    { "BNDM", bndm, m <= BP_MAX_LEN },
+    { "filter", filterScalar, true },
+    { "filter SSE2", filterSSE2, level >= BP_SSE2 },
+    { "filter AVX2", filterAVX2, level >= BP_AVX2 },
+  };
+
+  printf("%12s  %10s  %10s\n", "matcher", "MB/s", "matches");
+  size_t ref = 0;
+  for (size_t i = 0; i < sizeof(matchers) / sizeof(matchers[0]); i++) {
+    if (! matchers[i].enabled) 
+      continue;
+    clock_t start = clock();
+    size_t count = matchers[i].match(pattern, text, NULL, NULL);
+    double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%12s  %10.1f  %10zu", matchers[i].name, textMB / secs, 
+           count);
+    if (i == 0) 
+      ref = count;
+    else if (count != ref) 
+      printf(" (wrong!)");
+    printf("\n");
+  }
+  freeString(pattern);
+  freeString(text);
+  return 0;
+}
@@ -0,0 +1,49 @@
+/* 
+  file: bpm.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: string matching using bit-parallel matchers and a
+    SIMD first/last character filter (see bplib/bpm.c): Shift-Or 
+    or BNDM is used for patterns of up to 64 characters, and the 
+    filter for longer ones
+  time complexity: O(n + m) in the worst case, as BNDM falls back 
+    to Shift-Or and the filter to KMP on periodic texts; sublinear
+    on average for BNDM and the filter
+  assumption: length of the alphabet is 256 (ASCII)
+*/
+
+#include "../../../lib/clib.h"
+#include "bplib/bpm.h"
+
+//===================================================================
+// Prints a valid shift; found tracks whether it is the first one
+void showShift(size_t shift, void *found) {
+  printf(*(bool *) found ? ", %zu" : "%zu", shift);
+  *(bool *) found = true;
+}
+
+//===================================================================
+// Matches the pattern against the text and prints the shifts
+void matcher(string *text, string *pattern) {
+
+  printf("Shifts: ");
+  bool foundShift = false;
+  bpMatch(pattern, text, showShift, &foundShift);
+  if (foundShift) printf("\n"); 
+  else printf("None.\n");
+}
+
+//===================================================================
+
+int main () {
+
+  READ_STRING(pattern, '\n');
+  READ_STRING(text, EOF);
+
+  matcher(text, pattern);
+
+  freeString(text);
+  freeString(pattern);
+  return 0;
+}
@@ -0,0 +1,115 @@
+/*
+  file: fa.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: compact string-matching automaton, built from the
+    prefix function of the pattern
+*/
+
+#include "fa.h"
+
+//===================================================================
+// Computes the prefix function of the pattern
+static size_t *prefixFunction(string *pattern) {
+  size_t m = strLen(pattern);
+  size_t *pi = safeCalloc(m + 1, sizeof(size_t));
+  for (size_t q = 1, k = 0; q < m; q++) {
+    while (k > 0 && charAt(pattern, k) != charAt(pattern, q))
+      k = pi[k - 1];
+    if (charAt(pattern, k) == charAt(pattern, q))
+      k++;
+    pi[q] = k;
+  }
+  return pi;
+}
+
+  // Fills in the transition table with states of the given type:
+  // for q > 0, the row of state q equals the row of state π(q), 
+  // except for the transition on P[q], which extends the match; 
+  // so each row is copied from a row that is already complete
+#define FILL_DELTA(type) { \
+  type *delta = A->delta; \
+  size_t sigma = A->sigma; \
+  delta[A->map[charAt(pattern, 0)]] = 1; \
+  for (size_t q = 1; q <= m; q++) { \
+    memcpy(delta + q * sigma, delta + pi[q - 1] * sigma, \
+           sigma * sizeof(type)); \
+    if (q < m) \
+      delta[q * sigma + A->map[charAt(pattern, q)]] = q + 1; \
+  } \
+}
+
+//===================================================================
+// Builds the automaton for pattern in O(m|Σ|) time
+automaton *faNew(string *pattern) {
+
+  size_t m = strLen(pattern);
+  automaton *A = safeCalloc(1, sizeof(automaton));
+  A->m = m;
+
+    // remap the alphabet to the symbols of the pattern
+  A->sigma = 1;
+  for (size_t i = 0; i < m; i++) 
+    if (! A->map[charAt(pattern, i)])
+      A->map[charAt(pattern, i)] = A->sigma++;
+
+  A->width = m < UINT16_MAX ? sizeof(uint16_t) : sizeof(uint32_t);
+  A->delta = safeCalloc((m + 1) * A->sigma, A->width);
+  if (m == 0)
+    return A;
+
+    // the prefix function gives π(q) for the (q+1)-th state, so
+    // that π(q - 1) is the state to fall back to from state q
+  size_t *pi = prefixFunction(pattern);
+  if (A->width == sizeof(uint16_t))
+    FILL_DELTA(uint16_t)
+  else 
+    FILL_DELTA(uint32_t)
+  free(pi);
+  return A;
+}
+
+//===================================================================
+// Deallocates the automaton
+void faFree(automaton *A) {
+  free(A->delta);
+  free(A);
+}
+
+//===================================================================
+// Returns the size of the transition table in bytes
+size_t faTableSize(automaton *A) {
+  return (A->m + 1) * A->sigma * A->width;
+}
+
+  // Runs the automaton over the text with states of the given type
+#define RUN(type) { \
+  type const *delta = A->delta; \
+  for (size_t i = 0, q = 0; i < n; i++) { \
+    q = delta[q * sigma + map[T[i]]]; \
+    if (q == m) { \
+      if (report) \
+        report(i + 1 - m, arg); \
+      count++; \
+    } \
+  } \
+}
+
+//===================================================================
+// Reports all valid shifts of the pattern in text
+size_t faMatch(automaton *A, string *text, faReport report, 
+               void *arg) {
+  
+  size_t n = strLen(text), m = A->m, sigma = A->sigma, count = 0;
+  unsigned char const *T = str(text);
+  uint16_t const *map = A->map;
+  if (m == 0 || m > n)
+    return 0;
+
+  if (A->width == sizeof(uint16_t))
+    RUN(uint16_t)
+  else 
+    RUN(uint32_t)
+  return count;
+}
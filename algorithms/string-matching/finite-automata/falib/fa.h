@@ -0,0 +1,40 @@
+#ifndef FA_H_INCLUDED
+#define FA_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // A string-matching automaton for a pattern of length m, stored 
+  // in compact form: the alphabet is remapped to the symbols that 
+  // occur in the pattern, where class 0 stands for all other 
+  // characters, and the states are stored in 16 bits if m < 65535
+  // and in 32 bits otherwise
+typedef struct {
+  size_t m;             // length of the pattern
+  size_t sigma;         // number of symbol classes
+  uint16_t map[256];    // symbol class of each character
+  size_t width;         // bytes per state: 2 or 4
+  void *delta;          // transition table of (m + 1) x sigma states
+} automaton;
+
+  // Called for each valid shift of the pattern
+typedef void (*faReport)(size_t shift, void *arg);
+
+  // Builds the automaton for pattern in O(m|Σ|) time, where |Σ| is 
+  // the number of distinct symbols in the pattern
+automaton *faNew(string *pattern);
+
+  // Deallocates the automaton
+void faFree(automaton *A);
+
+  // Returns the size of the transition table in bytes
+size_t faTableSize(automaton *A);
+
+  // Reports all valid shifts of the pattern in text and returns 
+  // their number; report may be NULL to only count them
+size_t faMatch(automaton *A, string *text, faReport report, 
+               void *arg);
+
+#endif // FA_H_INCLUDED
@@ -0,0 +1,128 @@
+/*
+  Benchmark of the compact string-matching automaton against the
+    full transition table of sma.c, built with the suffix function
+  The text consists of random DNA characters; the patterns are
+    random substrings of the text. For each pattern length m, the 
+    build time, the table size, and the scan throughput in MB/s are
+    given, where the full table is only built as long as this 
+    finishes in reasonable time; the match counts are compared
+  Usage: ./faBench.out [textMB] [maxPatternLength]
+  Author: David De Potter
+*/
+
+#include "../fa.h"
+#include <time.h>
+
+#define d 256  // number of characters in the alphabet, d = |Σ|
+
+//===================================================================
+// Determines whether the pattern prefix of length k is also a  
+// suffix of Pq + a, as in sma.c
+bool isSuffix (string *pattern, size_t q, size_t a, size_t k) {
+  if (charAt(pattern, k - 1) != a) 
+    return false;
+  for (size_t i = 0; i < k - 1; i++) 
+    if (charAt(pattern, i) != charAt(pattern, q - (k-1) + i)) 
+      return false;
+  return true;
+}
+
+//===================================================================
+// Computes the full transition table in O(m³|Σ|) time, as in sma.c
+size_t **computeDelta (string *pattern) {
+  CREATE_MATRIX(size_t, delta, strLen(pattern) + 1, d, 0);
+  for (size_t q = 0; q <= strLen(pattern); q++) 
+    for (size_t a = 0; a < d; a++) {
+      size_t k = MIN(q + 1, strLen(pattern));
+      while (k > 0 && !isSuffix(pattern, q, a, k)) 
+        --k;
+      delta[q][a] = k;   
+    }
+  return delta;
+}
+
+//===================================================================
+// Counts the matches of the pattern using the full table
+size_t fullMatch(string *text, size_t m, size_t **delta) {
+  size_t count = 0;
+  for (size_t i = 0, q = 0; i < strLen(text); i++) {
+    q = delta[q][charAt(text, i)];
+    if (q == m) 
+      count++;
+  }
+  return count;
+}
+
+//===================================================================
+// Returns a random text of n DNA characters
+string *randomText(size_t n) {
+  string *text = newString(n + 1);
+  for (size_t i = 0; i < n; i++) 
+    text->data[i] = "acgt"[rand() % 4];
+  text->size = n;
+  return text;
+}
+
+//===================================================================
+// Returns a random substring of text of length m
+string *randomPattern(string *text, size_t m) {
+  size_t s = (size_t) rand() % (strLen(text) - m);
+  string *pattern = newString(m + 1);
+  memcpy(pattern->data, str(text) + s, m);
+  pattern->size = m;
+  return pattern;
+}
+
+//===================================================================
+// Returns the number of seconds since start
+double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t textMB = argc > 1 ? strtoul(argv[1], NULL, 10) : 16;
+  size_t maxLen = argc > 2 ? strtoul(argv[2], NULL, 10) : 100000;
+  srand(42);
+
+  string *text = randomText(textMB << 20);
+  printf("Text: %zu MB\n", textMB);
+  printf("%8s  %10s  %10s  %10s  %10s  %10s  %10s\n", "m", 
+         "full build", "full size", "full MB/s", "fa build", 
+         "fa size", "fa MB/s");
+
+  for (size_t m = 10; m <= maxLen; m *= 10) {
+    string *pattern = randomPattern(text, m);
+    printf("%8zu", m);
+
+    size_t fullCount = 0;
+    bool full = m <= 10000;
+    if (full) {
+      clock_t start = clock();
+      size_t **delta = computeDelta(pattern);
+      printf("  %9.4fs  %9zuK", elapsed(start), 
+             (m + 1) * d * sizeof(size_t) >> 10);
+      start = clock();
+      fullCount = fullMatch(text, m, delta);
+      printf("  %10.1f", textMB / elapsed(start));
+      FREE_MATRIX(delta, m + 1);
+    } else 
+      printf("  %10s  %10s  %10s", "-", "-", "-");
+
+    clock_t start = clock();
+    automaton *A = faNew(pattern);
+    printf("  %9.4fs  %9zuK", elapsed(start), faTableSize(A) >> 10);
+    start = clock();
+    size_t count = faMatch(A, text, NULL, NULL);
+    printf("  %10.1f", textMB / elapsed(start));
+    if (full && count != fullCount)
+      printf(" (wrong!)");
+    printf("\n");
+
+    faFree(A);
+    freeString(pattern);
+  }
+  freeString(text);
+  return 0;
+}
@@ -0,0 +1,50 @@
+/* 
+  file: sma-2.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: string matching using an automaton, whose
+    transition function is computed from the prefix function
+    and stored in a compact table (see falib/fa.c)
+  time complexity: automaton construction is in O(m|Σ|), where
+    Σ is the set of symbols occurring in the pattern, and 
+    matching time is in O(n) 
+  assumption: length of the alphabet is 256 (ASCII)
+*/
+
+#include "../../../lib/clib.h"
+#include "falib/fa.h"
+
+//===================================================================
+// Prints a valid shift; found tracks whether it is the first one
+void showShift(size_t shift, void *found) {
+  printf(*(bool *) found ? ", %zu" : "%zu", shift);
+  *(bool *) found = true;
+}
+
+//===================================================================
+// Matches the pattern against the text and prints the shifts
+void matcher(string *text, automaton *A) {
+
+  printf("Shifts: ");
+  bool foundShift = false;
+  faMatch(A, text, showShift, &foundShift);
+  if (foundShift) printf("\n"); 
+  else printf("None.\n");
+}
+
+//===================================================================
+
+int main () {
+
+  READ_STRING(pattern, '\n');
+  READ_STRING(text, EOF);
+
+  automaton *A = faNew(pattern);
+  matcher(text, A);
+
+  faFree(A);
+  freeString(text);
+  freeString(pattern);
+  return 0;
+}
@@ -0,0 +1,65 @@
+/* 
+  file: fmi.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: string matching using an FM-index of the text, 
+    which is built from its suffix array (see fmlib/fm.c), but only
+    keeps the Burrows-Wheeler transform and a sample of the suffix 
+    array
+  usage: ./fmi.out [rate] < input, where every rate-th position of 
+    the suffix array is sampled (default 32)
+  time complexity: O(n) to build the index, O(m log σ) to count 
+    the occurrences, and O(rate log σ) per occurrence to locate it
+  assumption: Σ is the extended ASCII alphabet (256 characters)
+*/
+
+#include "../../../lib/clib.h"
+#include "fmlib/fm.h"
+
+//===================================================================
+// Compares two shifts for qsort
+int cmpShifts(void const *a, void const *b) {
+  saIndex x = *(saIndex const *) a, y = *(saIndex const *) b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Finds all occurrences of pattern in the text and prints them in 
+// increasing order
+void matcher(fmIndex *F, string *pattern) {
+  
+  size_t count;
+  saIndex *shifts = fmLocate(F, pattern, &count);
+  if (! shifts) {
+    printf("No matches found.\n");
+    return;
+  }
+  qsort(shifts, count, sizeof(saIndex), cmpShifts);
+  printf("Pattern: ");
+  showString(pattern);
+  printf("Shifts (%zu): ", count);
+  for (size_t i = 0; i < count; i++) 
+    printf(i < count - 1 ? "%zu, " : "%zu\n", (size_t) shifts[i]);
+  free(shifts);
+}
+
+//===================================================================
+
+int main(int argc, char *argv[]) {
+
+  size_t rate = argc > 1 ? strtoul(argv[1], NULL, 10) : 32;
+
+  READ_STRING(pattern, '\n');
+  READ_STRING(text, EOF);
+
+  fmIndex *F = fmNew(text, rate);
+  matcher(F, pattern);
+  printf("Index size: %zu bytes for %zu characters\n", fmSize(F), 
+         strLen(text));
+
+  fmFree(F);
+  freeString(pattern);
+  freeString(text);
+  return 0;
+}
@@ -0,0 +1,256 @@
+/*
+  file: fm.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: FM-index, a compressed full-text index made of the 
+    Burrows-Wheeler transform of the text in a wavelet matrix, and
+    a sampled suffix array; it is built from the suffix array of 
+    salib/suffix.c
+*/
+
+#include "fm.h"
+
+#define BLOCK 256       // bits per block of the rank directory
+
+//===================================================================
+// Returns the number of ones in x; unlike __builtin_popcountll, this
+// does not become a library call when the popcnt instruction is not
+// enabled at compile time
+static inline size_t popCount(uint64_t x) {
+  x -= (x >> 1) & UINT64_C(0x5555555555555555);
+  x = (x & UINT64_C(0x3333333333333333)) 
+      + ((x >> 2) & UINT64_C(0x3333333333333333));
+  x = (x + (x >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+  return (x * UINT64_C(0x0101010101010101)) >> 56;
+}
+
+//===================================================================
+// Creates a bit vector of n zero bits
+static void newBitVector(bitVector *B, size_t n) {
+  B->n = n;
+  B->bits = safeCalloc(n / 64 + 1, sizeof(uint64_t));
+  B->ranks = safeCalloc(n / BLOCK + 1, sizeof(saIndex));
+}
+
+//===================================================================
+// Deallocates the bits and rank directory of a bit vector
+static void freeBitVector(bitVector *B) {
+  free(B->bits);
+  free(B->ranks);
+}
+
+//===================================================================
+// Returns the number of bytes used by a bit vector
+static size_t bitVectorSize(bitVector *B) {
+  return (B->n / 64 + 1) * sizeof(uint64_t) 
+         + (B->n / BLOCK + 1) * sizeof(saIndex);
+}
+
+//===================================================================
+// Sets bit i of a bit vector
+static inline void setBit(bitVector *B, size_t i) {
+  B->bits[i / 64] |= UINT64_C(1) << (i % 64);
+}
+
+//===================================================================
+// Returns bit i of a bit vector
+static inline bool getBit(bitVector *B, size_t i) {
+  return (B->bits[i / 64] >> (i % 64)) & 1;
+}
+
+//===================================================================
+// Fills in the rank directory once all bits have been set
+static void buildRanks(bitVector *B) {
+  saIndex ones = 0;
+  for (size_t w = 0; w <= B->n / 64; w++) {
+    if (w % (BLOCK / 64) == 0) 
+      B->ranks[w / (BLOCK / 64)] = ones;
+    ones += popCount(B->bits[w]);
+  }
+}
+
+//===================================================================
+// Returns the number of ones among the first i bits
+static inline size_t rank1(bitVector *B, size_t i) {
+  size_t w = i / 64, r = B->ranks[i / BLOCK];
+  for (size_t v = w & ~(size_t) (BLOCK / 64 - 1); v < w; v++)
+    r += popCount(B->bits[v]);
+  if (i % 64)
+    r += popCount(B->bits[w] << (64 - i % 64));
+  return r;
+}
+
+//===================================================================
+// Follows character c down the wavelet matrix from position i in 
+// the first level, and returns the position it ends up at in the 
+// last level
+static inline size_t descend(fmIndex *F, unsigned char c, size_t i) {
+  for (int l = 0; l < 8; l++) 
+    i = (c >> (7 - l)) & 1 ? F->zeros[l] + rank1(F->levels + l, i) 
+                           : i - rank1(F->levels + l, i);
+  return i;
+}
+
+//===================================================================
+// Returns the number of occurrences of c among the first i 
+// characters of the BWT; the sentinel is stored as character 0, 
+// so it has to be left out when counting zeros
+static inline size_t rankChar(fmIndex *F, unsigned char c, size_t i) {
+  return descend(F, c, i) - F->start[c] - (c == 0 && i > F->dollar);
+}
+
+//===================================================================
+// Builds the FM-index of text
+fmIndex *fmNew(string *text, size_t rate) {
+  
+  fmIndex *F = safeCalloc(1, sizeof(fmIndex));
+  size_t n = strLen(text), rows = n + 1;
+  unsigned char const *T = (unsigned char *) str(text);
+  F->n = n;
+  F->rate = MAX(rate, 1);
+
+    // the BWT holds the character before each suffix in sorted 
+    // order; row 0 is the suffix $, and the suffix array returned 
+    // by buildSuffixArray gives rows 1 to n
+  saIndex *sa = n ? buildSuffixArray(text) : NULL;
+  unsigned char *bwt = safeCalloc(rows, sizeof(unsigned char));
+  newBitVector(&F->sampled, rows);
+  bwt[0] = n ? T[n - 1] : 0;
+  setBit(&F->sampled, 0);
+  for (size_t r = 1; r < rows; r++) {
+    size_t pos = sa[r - 1];
+    if (pos == 0) 
+      F->dollar = r;
+    else 
+      bwt[r] = T[pos - 1];
+    if (pos % F->rate == 0) 
+      setBit(&F->sampled, r);
+  }
+  buildRanks(&F->sampled);
+  F->samples = safeCalloc(rank1(&F->sampled, rows) + 1, 
+                          sizeof(saIndex));
+  F->samples[0] = n;
+  for (size_t r = 1, s = 1; r < rows; r++) 
+    if (getBit(&F->sampled, r)) 
+      F->samples[s++] = sa[r - 1];
+  free(sa);
+
+    // C[c] counts the sentinel and all characters smaller than c
+  size_t count[256] = { 0 };
+  for (size_t i = 0; i < n; i++) 
+    count[T[i]]++;
+  F->C[0] = 1;
+  for (size_t c = 0; c < 256; c++) 
+    F->C[c + 1] = F->C[c] + count[c];
+
+    // each level of the wavelet matrix holds one bit of each 
+    // character, after the characters have been stably sorted on 
+    // all more significant bits, zeros before ones
+  unsigned char *next = safeCalloc(rows, sizeof(unsigned char));
+  for (int l = 0; l < 8; l++) {
+    bitVector *B = F->levels + l;
+    newBitVector(B, rows);
+    size_t z = 0;
+    for (size_t r = 0; r < rows; r++) 
+      if ((bwt[r] >> (7 - l)) & 1) 
+        setBit(B, r);
+      else 
+        next[z++] = bwt[r];
+    F->zeros[l] = z;
+    for (size_t r = 0; r < rows; r++) 
+      if ((bwt[r] >> (7 - l)) & 1) 
+        next[z++] = bwt[r];
+    buildRanks(B);
+    unsigned char *tmp = bwt; bwt = next; next = tmp;
+  }
+  free(bwt);
+  free(next);
+
+    // the first occurrence of c in the last level is where rank 
+    // queries for c end up when they start at position 0
+  for (size_t c = 0; c < 256; c++) 
+    F->start[c] = descend(F, c, 0);
+  return F;
+}
+
+//===================================================================
+// Deallocates the FM-index
+void fmFree(fmIndex *F) {
+  for (int l = 0; l < 8; l++) 
+    freeBitVector(F->levels + l);
+  freeBitVector(&F->sampled);
+  free(F->samples);
+  free(F);
+}
+
+//===================================================================
+// Returns the number of bytes used by the FM-index
+size_t fmSize(fmIndex *F) {
+  size_t size = sizeof(fmIndex) + bitVectorSize(&F->sampled) 
+                + (rank1(&F->sampled, F->n + 1) + 1) * sizeof(saIndex);
+  for (int l = 0; l < 8; l++) 
+    size += bitVectorSize(F->levels + l);
+  return size;
+}
+
+//===================================================================
+// Returns the number of occurrences of pattern, using backward 
+// search: if the rows [lo, hi) start with P[i+1..m-1], then the 
+// rows that start with P[i..m-1] are the LF-mapped rows among them
+// whose BWT character is P[i]
+size_t fmCount(fmIndex *F, string *pattern, size_t *lo, size_t *hi) {
+  size_t l = 0, h = F->n + 1;
+  for (size_t i = strLen(pattern); i-- > 0 && l < h; ) {
+    unsigned char c = charAt(pattern, i);
+    l = F->C[c] + rankChar(F, c, l);
+    h = F->C[c] + rankChar(F, c, h);
+  }
+  *lo = l;
+  *hi = MAX(l, h);
+  return *hi - *lo;
+}
+
+//===================================================================
+// Returns the row of the suffix that starts one position before 
+// that of row r (the LF mapping), where r is not the row of the
+// suffix that starts at position 0; the character and its rank 
+// are read off in a single pass down the wavelet matrix
+static inline size_t lfMap(fmIndex *F, size_t r) {
+  unsigned char c = 0;
+  size_t i = r;
+  for (int l = 0; l < 8; l++) {
+    bitVector *B = F->levels + l;
+    if (getBit(B, i)) {
+      c |= 1 << (7 - l);
+      i = F->zeros[l] + rank1(B, i);
+    } else 
+      i -= rank1(B, i);
+  }
+  return F->C[c] + i - F->start[c] - (c == 0 && r > F->dollar);
+}
+
+//===================================================================
+// Returns the position in the text of the suffix at row r, by 
+// walking back through the text until a sampled position is found
+size_t fmSuffix(fmIndex *F, size_t r) {
+  size_t steps = 0;
+  while (! getBit(&F->sampled, r)) {
+    r = lfMap(F, r);
+    steps++;
+  }
+  return F->samples[rank1(&F->sampled, r)] + steps;
+}
+
+//===================================================================
+// Returns the valid shifts of pattern in the order of their rows
+saIndex *fmLocate(fmIndex *F, string *pattern, size_t *count) {
+  size_t lo, hi;
+  *count = fmCount(F, pattern, &lo, &hi);
+  if (*count == 0) 
+    return NULL;
+  saIndex *shifts = safeCalloc(*count, sizeof(saIndex));
+  for (size_t r = lo; r < hi; r++) 
+    shifts[r - lo] = fmSuffix(F, r);
+  return shifts;
+}
@@ -0,0 +1,59 @@
+#ifndef FM_H_INCLUDED
+#define FM_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+#include "../../suffix-arrays/salib/suffix.h"
+
+  // A bit vector with a rank directory: ranks[b] is the number of
+  // ones before block b of 256 bits
+typedef struct {
+  uint64_t *bits;
+  saIndex *ranks;
+  size_t n;             // number of bits
+} bitVector;
+
+  // An FM-index of a text T of length n, which is the Burrows-Wheeler
+  // transform of T$ stored in a wavelet matrix, where $ is a virtual
+  // sentinel smaller than all characters. Row r of the BWT matrix 
+  // is the r-th suffix of T$ in sorted order, so that row 0 is $. 
+  // The suffix array is only kept for the rows whose suffix starts 
+  // at a multiple of the sample rate
+typedef struct {
+  size_t n;             // length of the text, without the sentinel
+  size_t dollar;        // row whose BWT character is the sentinel
+  size_t C[257];        // first row of the suffixes starting with c
+  bitVector levels[8];  // wavelet matrix of the BWT, one level 
+                        // per bit, from the most significant one
+  size_t zeros[8];      // number of zeros in each level
+  size_t start[256];    // position of the first c in the last level
+  size_t rate;          // sample rate of the suffix array
+  bitVector sampled;    // marks the rows whose suffix is sampled
+  saIndex *samples;     // sampled suffix array entries, by row
+} fmIndex;
+
+  // Builds the FM-index of text, sampling every rate-th position of 
+  // the suffix array (rate ≥ 1)
+fmIndex *fmNew(string *text, size_t rate);
+
+  // Deallocates the FM-index
+void fmFree(fmIndex *F);
+
+  // Returns the number of bytes used by the FM-index
+size_t fmSize(fmIndex *F);
+
+  // Returns the number of occurrences of pattern in the text, and
+  // stores the range [lo, hi) of rows that start with it
+size_t fmCount(fmIndex *F, string *pattern, size_t *lo, size_t *hi);
+
+  // Returns the valid shifts of pattern in the order of their rows, 
+  // which is the order of the suffix array, and stores their number
+  // in count; returns NULL if there are none
+saIndex *fmLocate(fmIndex *F, string *pattern, size_t *count);
+
+  // Returns the position in the text of the suffix at row r
+size_t fmSuffix(fmIndex *F, size_t r);
+
+#endif // FM_H_INCLUDED
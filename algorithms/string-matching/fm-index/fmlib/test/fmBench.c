@@ -0,0 +1,143 @@
+/*
+  Benchmark of the FM-index against the suffix array matcher
+  The whole file is used as text. For both indexes, the build time 
+    and the memory used by the index are shown, where the suffix 
+    array matcher needs the text, the suffix array, and the LCP 
+    array, while the FM-index replaces all three. Then, patterns of
+    the given length are taken from random positions in the text, 
+    and the average time to count and to locate their occurrences 
+    is shown, together with the total number of occurrences, for 
+    several sample rates of the FM-index
+  Usage: ./fmBench.out file [queries] [patLen]
+  Example: ./fmBench.out corpus.txt 10000 8
+  Author: David De Potter
+*/
+
+#include "../fm.h"
+#include <time.h>
+
+//===================================================================
+// Reads the whole file into a string
+string *readFile(char const *path) {
+  FILE *file = fopen(path, "rb");
+  if (! file) {
+    fprintf(stderr, "Cannot open %s\n", path);
+    return NULL;
+  }
+  string *text = newString(1 << 20);
+  size_t len;
+  while ((len = fread(text->data + text->size, 1, 
+                      text->cap - text->size - 1, file)) > 0) {
+    text->size += len;
+    if (text->size + 1 == text->cap) {
+      text->cap *= 2;
+      text->data = safeRealloc(text->data, text->cap);
+    }
+  }
+  text->data[text->size] = '\0';
+  fclose(file);
+  return text;
+}
+
+//===================================================================
+// Returns the seconds elapsed since start
+double secsSince(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s file [queries] [patLen]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  size_t queries = argc > 2 ? strtoul(argv[2], NULL, 10) : 10000;
+  size_t patLen = argc > 3 ? strtoul(argv[3], NULL, 10) : 8;
+  string *text = readFile(argv[1]);
+  if (! text) 
+    return EXIT_FAILURE;
+  size_t n = strLen(text);
+  if (n < patLen || queries == 0) {
+    fprintf(stderr, "Text shorter than the patterns\n");
+    return EXIT_FAILURE;
+  }
+
+    // patterns from random positions in the text
+  srand(42);
+  string **patterns = safeCalloc(queries, sizeof(string *));
+  for (size_t q = 0; q < queries; q++) {
+    size_t i = ((size_t) rand() * RAND_MAX + rand()) % (n - patLen + 1);
+    patterns[q] = newString(patLen + 1);
+    memcpy(patterns[q]->data, str(text) + i, patLen);
+    patterns[q]->size = patLen;
+  }
+  printf("Text: %zu bytes, %zu queries of length %zu\n\n", n, queries,
+         patLen);
+  printf("%14s  %9s  %10s  %11s  %12s  %10s\n", "index", "build (s)", 
+         "bytes/char", "count (µs)", "locate (µs)", "occurrences");
+
+    // the suffix array matcher of sa.c: the occurrences are read 
+    // off the suffix array once the range is found
+  clock_t start = clock();
+  saIndex *sa = buildSuffixArray(text);
+  saIndex *lcp = buildLCPArray(text, sa);
+  saIndex *lcpLR = buildLcpLRArray(lcp, n);
+  double build = secsSince(start);
+  size_t bytes = n + 4 * n * sizeof(saIndex), lo, hi, ref = 0;
+  start = clock();
+  for (size_t q = 0; q < queries; q++) 
+    findPattern(patterns[q], text, sa, lcp, lcpLR, &lo, &hi);
+  double count = secsSince(start);
+  start = clock();
+  saIndex sum = 0;
+  for (size_t q = 0; q < queries; q++) 
+    if (findPattern(patterns[q], text, sa, lcp, lcpLR, &lo, &hi)) {
+      for (size_t i = lo; i <= hi; i++) 
+        sum += sa[i];
+      ref += hi - lo + 1;
+    }
+  double locate = secsSince(start);
+  printf("%14s  %9.2f  %10.2f  %11.2f  %12.2f  %10zu\n", 
+         "suffix array", build, (double) bytes / n, 
+         1e6 * count / queries, 1e6 * locate / queries, ref);
+  free(sa);
+  free(lcp);
+  free(lcpLR);
+
+  size_t rates[] = { 8, 32, 128 };
+  for (size_t k = 0; k < sizeof(rates) / sizeof(rates[0]); k++) {
+    start = clock();
+    fmIndex *F = fmNew(text, rates[k]);
+    build = secsSince(start);
+    start = clock();
+    for (size_t q = 0; q < queries; q++) 
+      fmCount(F, patterns[q], &lo, &hi);
+    count = secsSince(start);
+    start = clock();
+    size_t total = 0;
+    saIndex fmSum = 0;
+    for (size_t q = 0; q < queries; q++) {
+      size_t c;
+      saIndex *shifts = fmLocate(F, patterns[q], &c);
+      for (size_t i = 0; i < c; i++) 
+        fmSum += shifts[i];
+      total += c;
+      free(shifts);
+    }
+    locate = secsSince(start);
+    char name[32];
+    sprintf(name, "FM (rate %zu)", rates[k]);
+    printf("%14s  %9.2f  %10.2f  %11.2f  %12.2f  %10zu%s\n", name, 
+           build, (double) fmSize(F) / n, 1e6 * count / queries, 
+           1e6 * locate / queries, total, 
+           total != ref || fmSum != sum ? " (wrong!)" : "");
+    fmFree(F);
+  }
+
+  for (size_t q = 0; q < queries; q++) 
+    freeString(patterns[q]);
+  free(patterns);
+  freeString(text);
+  return 0;
+}
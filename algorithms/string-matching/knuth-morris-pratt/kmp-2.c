@@ -0,0 +1,113 @@
+/* 
+  file: kmp-2.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: streaming string matching using the 
+    Knuth-Morris-Pratt algorithm: the text is consumed in chunks 
+    of arbitrary size, and the matcher state carries a partial 
+    match across chunk boundaries, so that the text never has to 
+    be held in memory and shifts are reported as soon as found
+  time complexity: O(m + n), using O(m) memory
+  assumption: length of the alphabet is 256 (ASCII)
+*/
+
+#include "../../../lib/clib.h"
+
+  // Called for each valid shift, as an offset in the whole stream
+typedef void (*matchReport)(size_t shift, void *arg);
+
+  // The state of the matcher between chunks
+typedef struct {
+  string *pattern;      // the pattern
+  size_t *pi;           // prefix function of the pattern
+  size_t q;             // length of the matched pattern prefix
+  size_t pos;           // offset of the next character in the stream
+} kmpState;
+
+//===================================================================
+// Computes the prefix function of the pattern
+size_t *computePrefixFunction (string *pattern) {
+  
+  CREATE_ARRAY(size_t, pi, strLen(pattern) + 1, 0);
+
+  for (size_t q = 1, k = 0; q < strLen(pattern); q++) {
+    while (k > 0 && charAt(pattern, k) != charAt(pattern, q))
+      k = pi[k - 1];
+    if (charAt(pattern, k) == charAt(pattern, q)) 
+      k++;
+    pi[q] = k;
+  }
+  return pi;
+}
+
+//===================================================================
+// Creates a matcher state for pattern at the start of a stream
+kmpState *kmpNew(string *pattern) {
+  kmpState *S = safeCalloc(1, sizeof(kmpState));
+  S->pattern = pattern;
+  S->pi = computePrefixFunction(pattern);
+  return S;
+}
+
+//===================================================================
+// Deallocates the matcher state; the pattern is not freed
+void kmpFree(kmpState *S) {
+  free(S->pi);
+  free(S);
+}
+
+//===================================================================
+// Feeds the next chunk of the stream to the matcher and reports 
+// the shifts of all matches that end in the chunk
+void kmpFeed(kmpState *S, unsigned char const *chunk, size_t len,
+             matchReport report, void *arg) {
+  
+  string *pattern = S->pattern;
+  size_t m = strLen(pattern), q = S->q, *pi = S->pi;
+  if (m == 0) 
+    return;
+
+  for (size_t i = 0; i < len; i++) {
+    while (q > 0 && charAt(pattern, q) != chunk[i]) 
+      q = pi[q - 1];   
+    if (charAt(pattern, q) == chunk[i]) 
+      q++;
+    if (q == m) {
+      report(S->pos + i + 1 - m, arg);
+      q = pi[q - 1];
+    }
+  }
+  S->q = q;
+  S->pos += len;
+}
+
+//===================================================================
+// Prints a valid shift; found tracks whether it is the first one
+void showShift(size_t shift, void *found) {
+  printf(*(bool *) found ? ", %zu" : "%zu", shift);
+  *(bool *) found = true;
+}
+
+//===================================================================
+
+int main () {
+
+  READ_STRING(pattern, '\n');
+  kmpState *S = kmpNew(pattern);
+
+    // feed the rest of the input to the matcher, one 
+    // buffer of the input reader at a time
+  printf("Shifts: ");
+  bool foundShift = false;
+  unsigned char const *chunk;
+  size_t len;
+  while ((len = readerChunk(stdinReader(), &chunk)))
+    kmpFeed(S, chunk, len, showShift, &foundShift);
+  if (foundShift) printf("\n");
+  else printf("None.\n");
+
+  kmpFree(S);
+  freeString(pattern);
+  return 0;
+}
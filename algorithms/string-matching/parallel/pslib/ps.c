@@ -0,0 +1,204 @@
+/*
+  file: ps.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: multi-threaded string matching, which splits the
+    text into overlapping chunks and runs one of the string 
+    matchers on each chunk in its own thread
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include "ps.h"
+#include <pthread.h>
+#include <unistd.h>
+#include "../../suffix-arrays/salib/suffix.h"
+#include "../../rabin-karp/rklib/rk.h"
+
+//===================================================================
+// Reports the valid shifts of pattern in text in the same way as 
+// the matcher in kmp.c
+void kmpMatcher(string *pattern, string *text, psReport report, 
+                void *arg) {
+
+  size_t m = strLen(pattern);
+  if (m == 0) 
+    return;
+
+  size_t *pi = safeCalloc(m, sizeof(size_t));
+  for (size_t q = 1, k = 0; q < m; q++) {
+    while (k > 0 && charAt(pattern, k) != charAt(pattern, q))
+      k = pi[k - 1];
+    if (charAt(pattern, k) == charAt(pattern, q)) 
+      k++;
+    pi[q] = k;
+  }
+  for (size_t i = 0, q = 0; i < strLen(text); i++) {
+    while (q > 0 && charAt(pattern, q) != charAt(text, i)) 
+      q = pi[q - 1];   
+    if (charAt(pattern, q) == charAt(text, i)) 
+      q++;
+    if (q == m) {
+      report(i - q + 1, arg);
+      q = pi[q - 1];
+    }
+  }
+  free(pi);
+}
+
+//===================================================================
+// Reports the valid shifts of pattern in text in the same way as 
+// the computeShifts function in rka.c, but with the hash taken 
+// modulo the Mersenne prime 2^61 - 1, using the arithmetic of 
+// rklib/rk.h
+void rkMatcher(string *pattern, string *text, psReport report, 
+               void *arg) {
+
+  size_t m = strLen(pattern), n = strLen(text);
+  uint64_t pHash = 0, tHash = 0, h = 1, d = 256;
+  if (m == 0 || m > n) 
+    return;
+
+  for (size_t i = 0; i < m - 1; i++) 
+    h = mulP(h, d);
+  for (size_t i = 0; i < m; i++) {
+    pHash = modP(mulP(pHash, d) + charAt(pattern, i));
+    tHash = modP(mulP(tHash, d) + charAt(text, i));
+  }
+  for (size_t i = 0; i <= n - m; i++) {
+    if (pHash == tHash && 
+        memcmp(str(text) + i, str(pattern), m) == 0)
+      report(i, arg);
+    if (i < n - m) 
+      tHash = modP(mulP(modP(tHash + RK_MOD 
+                             - mulP(charAt(text, i), h)), d)
+                   + charAt(text, m + i));
+  }
+}
+
+//===================================================================
+// Compares two shifts for qsort
+static int cmpShifts(void const *a, void const *b) {
+  saIndex x = *(saIndex const *) a, y = *(saIndex const *) b;
+  return (x > y) - (x < y);
+}
+
+//===================================================================
+// Reports the valid shifts of pattern in text by building the 
+// suffix array and LCP array of text, as in sa.c; the shifts are 
+// sorted, as they appear in lexicographic order in the suffix array
+void saMatcher(string *pattern, string *text, psReport report, 
+               void *arg) {
+
+  if (strLen(text) == 0)
+    return;
+  saIndex *sa = buildSuffixArray(text);
+  saIndex *lcp = buildLCPArray(text, sa);
+  saIndex *lcpLR = buildLcpLRArray(lcp, strLen(text));
+  size_t start, end;
+  if (findPattern(pattern, text, sa, lcp, lcpLR, &start, &end)) {
+    qsort(sa + start, end - start + 1, sizeof(saIndex), cmpShifts);
+    for (size_t i = start; i <= end; i++) 
+      report(sa[i], arg);
+  }
+  free(sa);
+  free(lcp);
+  free(lcpLR);
+}
+
+  // The work of a single thread
+typedef struct {
+  pthread_t thread;
+  psMatcher match;
+  string *pattern;
+  string chunk;         // chunk of the text, not owned
+  size_t offset;        // offset of the chunk in the text
+  shiftList shifts;     // shifts found, as offsets in the text
+} task;
+
+//===================================================================
+// Appends a shift, found in the chunk of a task, to its list
+static void addShift(size_t shift, void *arg) {
+  task *T = arg;
+  shiftList *L = &T->shifts;
+  if (L->len == L->cap) {
+    L->cap = L->cap ? 2 * L->cap : 64;
+    L->shifts = safeRealloc(L->shifts, L->cap * sizeof(size_t));
+  }
+  L->shifts[L->len++] = T->offset + shift;
+}
+
+//===================================================================
+// Runs the matcher of a task on its chunk
+static void *runTask(void *arg) {
+  task *T = arg;
+  T->match(T->pattern, &T->chunk, addShift, T);
+  return NULL;
+}
+
+//===================================================================
+// Runs the matcher in parallel on overlapping chunks of the text
+shiftList *parallelMatch(string *pattern, string *text, 
+                         psMatcher match, size_t nThreads) {
+
+  size_t m = strLen(pattern), n = strLen(text);
+  shiftList *result = safeCalloc(1, sizeof(shiftList));
+  if (m == 0 || m > n)
+    return result;
+
+    // each task is responsible for a range of shifts, and its chunk
+    // holds the characters of all windows starting at those shifts:
+    // so consecutive chunks overlap by m - 1 characters, and each 
+    // match is found by exactly one task
+  size_t nShifts = n - m + 1;
+  nThreads = MAX(1, MIN(nThreads, nShifts));
+  size_t perTask = (nShifts + nThreads - 1) / nThreads;
+  task *tasks = safeCalloc(nThreads, sizeof(task));
+
+  for (size_t t = 0; t < nThreads; t++) {
+    task *T = tasks + t;
+    size_t first = t * perTask;
+    size_t last = MIN(nShifts, first + perTask);
+    T->match = match;
+    T->pattern = pattern;
+    T->offset = first;
+    T->chunk.data = str(text) + first;
+    T->chunk.size = T->chunk.cap = first < last ? last - first + m - 1 
+                                                : 0;
+    if (pthread_create(&T->thread, NULL, runTask, T) != 0) {
+      fprintf(stderr, "Error: could not create thread\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+    // the lists are in order within each chunk, and the chunks 
+    // are in order, so concatenating them keeps the shifts sorted
+  for (size_t t = 0; t < nThreads; t++) {
+    pthread_join(tasks[t].thread, NULL);
+    result->len += tasks[t].shifts.len;
+  }
+  result->cap = MAX(1, result->len);
+  result->shifts = safeCalloc(result->cap, sizeof(size_t));
+  for (size_t t = 0, len = 0; t < nThreads; t++) {
+    memcpy(result->shifts + len, tasks[t].shifts.shifts, 
+           tasks[t].shifts.len * sizeof(size_t));
+    len += tasks[t].shifts.len;
+    free(tasks[t].shifts.shifts);
+  }
+  free(tasks);
+  return result;
+}
+
+//===================================================================
+// Deallocates a list of shifts
+void freeShiftList(shiftList *L) {
+  free(L->shifts);
+  free(L);
+}
+
+//===================================================================
+// Returns the number of processors that are online
+size_t nrProcessors(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? n : 1;
+}
@@ -0,0 +1,44 @@
+#ifndef PS_H_INCLUDED
+#define PS_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "../../../../lib/clib.h"
+
+  // Called for each valid shift of the pattern
+typedef void (*psReport)(size_t shift, void *arg);
+
+  // A matcher reports all valid shifts of pattern in text in 
+  // increasing order
+typedef void (*psMatcher)(string *pattern, string *text, 
+                          psReport report, void *arg);
+
+  // The matchers that can be run in parallel: the Knuth-Morris-Pratt
+  // matcher, the Rabin-Karp matcher, and the suffix array matcher, 
+  // which builds the suffix array of each chunk
+void kmpMatcher(string *pattern, string *text, psReport report, 
+                void *arg);
+void rkMatcher(string *pattern, string *text, psReport report, 
+               void *arg);
+void saMatcher(string *pattern, string *text, psReport report, 
+               void *arg);
+
+  // A list of shifts in increasing order
+typedef struct {
+  size_t *shifts;
+  size_t len, cap;
+} shiftList;
+
+  // Splits the text into nThreads chunks, which overlap by m - 1 
+  // characters, and runs the matcher on each chunk in its own 
+  // thread; returns all valid shifts in increasing order
+shiftList *parallelMatch(string *pattern, string *text, 
+                         psMatcher match, size_t nThreads);
+
+  // Deallocates a list of shifts
+void freeShiftList(shiftList *L);
+
+  // Returns the number of processors that are online
+size_t nrProcessors(void);
+
+#endif // PS_H_INCLUDED
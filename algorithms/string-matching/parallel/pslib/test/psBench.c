@@ -0,0 +1,125 @@
+/*
+  Benchmark of the multi-threaded string matchers
+  The pattern and text are read from a test input file, as used by
+    the string matchers, and the text is repeated until it reaches
+    the given size. Each matcher is run with 1 up to maxThreads 
+    threads, and the wall clock time, the speedup over a single 
+    thread, and the match counts are shown. As building a suffix 
+    array is much slower than scanning the text, the suffix array
+    matcher only uses the first 16 MB of the text
+  Usage: ./psBench.out file [maxThreads] [textMB]
+  Example: ./psBench.out ../../tests/1.in 8 256
+  Author: David De Potter
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include "../ps.h"
+#include <time.h>
+
+#define SA_MAX_MB 16
+
+//===================================================================
+// Reads the pattern (first line) and text (rest) from the file, 
+// and repeats the text until it has the given size
+bool readInput(char const *path, size_t size, string **pattern, 
+               string **text) {
+  FILE *file = fopen(path, "rb");
+  if (! file) {
+    fprintf(stderr, "Cannot open %s\n", path);
+    return false;
+  }
+  reader *R = readerNew(file, 0);
+  *pattern = newString(100);
+  int c;
+  while ((c = readerChar(R)) != EOF && c != '\n') {
+    if ((*pattern)->size + 1 == (*pattern)->cap) {
+      (*pattern)->cap *= 2;
+      (*pattern)->data = safeRealloc((*pattern)->data, 
+                                     (*pattern)->cap);
+    }
+    (*pattern)->data[(*pattern)->size++] = c;
+  }
+  (*pattern)->data[(*pattern)->size] = '\0';
+
+  *text = newString(size + 1);
+  size_t len = 0;
+  while ((c = readerChar(R)) != EOF && len < size)
+    (*text)->data[len++] = c;
+  readerFree(R);
+  fclose(file);
+  if (len == 0) {
+    fprintf(stderr, "Empty text in %s\n", path);
+    return false;
+  }
+  for (size_t i = len; i < size; i++)
+    (*text)->data[i] = (*text)->data[i - len];
+  (*text)->size = size;
+  return true;
+}
+
+
+//===================================================================
+// Returns the wall clock time in seconds
+double wallTime(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s file [maxThreads] [textMB]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  size_t maxThreads = argc > 2 ? strtoul(argv[2], NULL, 10) 
+                               : nrProcessors();
+  size_t textMB = argc > 3 ? strtoul(argv[3], NULL, 10) : 256;
+  string *pattern, *text;
+  if (! readInput(argv[1], textMB << 20, &pattern, &text))
+    return EXIT_FAILURE;
+
+  printf("Pattern length: %zu, text: %zu MB, processors: %zu\n", 
+         strLen(pattern), textMB, nrProcessors());
+
+  struct {
+    char const *name;
+    psMatcher match;
+    size_t textMB;
+  } matchers[] = {
+    { "KMP", kmpMatcher, textMB },
+    { "Rabin-Karp", rkMatcher, textMB },
+    { "suffix array", saMatcher, MIN(textMB, SA_MAX_MB) },
+  };
+
+  printf("%12s  %7s  %7s  %10s  %7s  %10s\n", "matcher", "threads", 
+         "MB", "seconds", "speedup", "matches");
+  for (size_t i = 0; i < sizeof(matchers) / sizeof(matchers[0]); i++) {
+      // the suffix array matcher runs on a prefix of the text
+    string prefix = *text;
+    prefix.size = matchers[i].textMB << 20;
+    double base = 0;
+    size_t ref = 0;
+    for (size_t t = 1; t <= maxThreads; t++) {
+      double start = wallTime();
+      shiftList *L = parallelMatch(pattern, &prefix, 
+                                   matchers[i].match, t);
+      double secs = wallTime() - start;
+      if (t == 1) {
+        base = secs;
+        ref = L->len;
+      }
+      printf("%12s  %7zu  %7zu  %10.3f  %7.2f  %10zu", 
+             matchers[i].name, t, matchers[i].textMB, secs, 
+             base / secs, L->len);
+      if (L->len != ref) 
+        printf(" (wrong!)");
+      printf("\n");
+      freeShiftList(L);
+    }
+  }
+  freeString(pattern);
+  freeString(text);
+  return 0;
+}
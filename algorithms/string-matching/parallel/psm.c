@@ -0,0 +1,61 @@
+/* 
+  file: psm.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: multi-threaded string matching, where the text is
+    split into overlapping chunks that are searched in parallel
+    with the KMP, Rabin-Karp, or suffix array matcher 
+    (see pslib/ps.c)
+  usage: ./psm.out [threads] [kmp|rk|sa] < input, where the number 
+    of threads defaults to the number of processors, and the 
+    matcher to KMP
+  time complexity: O(n/t + m) per thread for KMP, where t is the
+    number of threads
+  assumption: length of the alphabet is 256 (ASCII)
+*/
+
+#include "../../../lib/clib.h"
+#include "pslib/ps.h"
+
+//===================================================================
+// Matches the pattern against the text and prints the shifts
+void matcher(string *text, string *pattern, psMatcher match, 
+             size_t nThreads) {
+
+  shiftList *L = parallelMatch(pattern, text, match, nThreads);
+  printf("Shifts: ");
+  for (size_t i = 0; i < L->len; i++) 
+    printf(i ? ", %zu" : "%zu", L->shifts[i]);
+  if (L->len) printf("\n"); 
+  else printf("None.\n");
+  freeShiftList(L);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+
+  size_t nThreads = argc > 1 ? strtoul(argv[1], NULL, 10) 
+                             : nrProcessors();
+  psMatcher match = kmpMatcher;
+  if (argc > 2) {
+    if (strcmp(argv[2], "rk") == 0) 
+      match = rkMatcher;
+    else if (strcmp(argv[2], "sa") == 0) 
+      match = saMatcher;
+    else if (strcmp(argv[2], "kmp") != 0) {
+      fprintf(stderr, "Usage: %s [threads] [kmp|rk|sa]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  READ_STRING(pattern, '\n');
+  READ_STRING(text, EOF);
+
+  matcher(text, pattern, match, nThreads);
+
+  freeString(text);
+  freeString(pattern);
+  return 0;
+}
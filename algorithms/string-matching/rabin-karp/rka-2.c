@@ -0,0 +1,148 @@
+/* 
+  file: rka-2.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: streaming string matching using the Rabin-Karp
+    algorithm: the text is consumed in chunks of arbitrary size,
+    and the matcher state keeps the rolling hash and the last m 
+    characters of the stream, so that the text never has to be 
+    held in memory and shifts are reported as soon as found
+    The hash is computed modulo the Mersenne prime 2^61 - 1
+  time complexity: O(m + n) expected, using O(m) memory
+  assumption: length of the alphabet is 256 (extended ASCII)
+*/
+
+#include "../../../lib/clib.h"
+
+#define d 256       // number of characters in the alphabet, d = |Σ|
+#define P ((UINT64_C(1) << 61) - 1)  // Mersenne prime 2^61 - 1
+#define MASK53 ((UINT64_C(1) << 53) - 1)
+
+//===================================================================
+// Returns a number < 2^61 - 1 that is congruent to x, using 
+// 2^61 ≡ 1
+static inline uint64_t modP(uint64_t x) {
+  x = (x >> 61) + (x & P);
+  return x >= P ? x - P : x;
+}
+
+//===================================================================
+// Returns x * c mod 2^61 - 1 for x < 2^61 and c ≤ 256, which are 
+// the only products of the hash: with x = hi * 2^53 + lo and
+// t = hi * c < 2^16, we have t * 2^53 ≡ (t >> 8) + (t & 255) * 2^53
+static inline uint64_t mulP(uint64_t x, uint64_t c) {
+  uint64_t t = (x >> 53) * c;
+  return modP((x & MASK53) * c + (t >> 8) + ((t & 255) << 53));
+}
+
+  // Called for each valid shift, as an offset in the whole stream
+typedef void (*matchReport)(size_t shift, void *arg);
+
+  // The state of the matcher between chunks
+typedef struct {
+  string *pattern;          // the pattern
+  uint64_t pHash;           // hash value of the pattern
+  uint64_t tHash;           // hash value of the current window
+  uint64_t h;               // d^(m-1) mod 2^61 - 1
+  unsigned char *window;    // last m characters of the stream, 
+                            // used as a circular buffer
+  size_t pos;               // offset of the next character in 
+                            // the stream
+} rkState;
+
+//===================================================================
+// Creates a matcher state for pattern at the start of a stream
+rkState *rkNew(string *pattern) {
+
+  rkState *S = safeCalloc(1, sizeof(rkState));
+  size_t m = strLen(pattern);
+  S->pattern = pattern;
+  S->window = safeCalloc(m + 1, sizeof(unsigned char));
+  S->h = 1;
+
+    // precompute h = d^(m-1) mod 2^61 - 1
+  for (size_t i = 0; i + 1 < m; i++) 
+    S->h = mulP(S->h, d);
+    // precompute hash value for pattern
+  for (size_t i = 0; i < m; i++) 
+    S->pHash = modP(mulP(S->pHash, d) + charAt(pattern, i));
+  return S;
+}
+
+//===================================================================
+// Deallocates the matcher state; the pattern is not freed
+void rkFree(rkState *S) {
+  free(S->window);
+  free(S);
+}
+
+//===================================================================
+// Returns true if the current window equals the pattern; the 
+// window starts at index start of the circular buffer
+bool windowMatches(rkState *S, size_t start) {
+  size_t m = strLen(S->pattern);
+  return memcmp(S->window + start, str(S->pattern), m - start) == 0
+    && memcmp(S->window, str(S->pattern) + m - start, start) == 0;
+}
+
+//===================================================================
+// Feeds the next chunk of the stream to the matcher and reports 
+// the shifts of all matches that end in the chunk
+void rkFeed(rkState *S, unsigned char const *chunk, size_t len,
+            matchReport report, void *arg) {
+
+  size_t m = strLen(S->pattern);
+  if (m == 0) 
+    return;
+
+  for (size_t i = 0; i < len; i++, S->pos++) {
+      // slot of the circular buffer that receives the new 
+      // character, which is also where the window starts 
+      // once the buffer is full
+    size_t slot = S->pos % m;
+    if (S->pos < m) 
+      S->tHash = modP(mulP(S->tHash, d) + chunk[i]);
+    else 
+      S->tHash = modP(mulP(modP(S->tHash + P 
+                                - mulP(S->h, S->window[slot])), d)
+                      + chunk[i]);
+    S->window[slot] = chunk[i];
+
+      // check for a valid shift by comparing hash values,
+      // excluding spurious hits in case of hash collisions
+    if (S->pos + 1 >= m && S->tHash == S->pHash 
+        && windowMatches(S, (slot + 1) % m))
+      report(S->pos + 1 - m, arg);
+  }
+}
+
+//===================================================================
+// Prints a valid shift; found tracks whether it is the first one
+void showShift(size_t shift, void *found) {
+  printf(*(bool *) found ? ", %zu" : "%zu", shift);
+  *(bool *) found = true;
+}
+
+//===================================================================
+
+int main () {
+
+  READ_STRING(pattern, '\n');
+  rkState *S = rkNew(pattern);
+
+    // feed the rest of the input to the matcher, one 
+    // buffer of the input reader at a time
+  printf("Shifts: ");
+  bool foundShift = false;
+  unsigned char const *chunk;
+  size_t len;
+  while ((len = readerChunk(stdinReader(), &chunk)))
+    rkFeed(S, chunk, len, showShift, &foundShift);
+  if (foundShift) printf("\n");
+  else printf("None.\n");
+
+  rkFree(S);
+  freeString(pattern);
+  return 0;
+}
@@ -0,0 +1,96 @@
+/* 
+  file: rka-3.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: string matching of one or more patterns of the same
+    length using the Rabin-Karp algorithm, with a rolling hash 
+    modulo the Mersenne prime 2^61 - 1 and a random base 
+    (see rklib/rk.c); the number of spurious hits is shown as well
+  input: the number of patterns k, followed by k patterns of the 
+    same length m, one per line, and the text, which runs until the
+    end of the input
+  time complexity: O(km) for the hashes of the patterns, and 
+    expected O(n + z·m) for matching, where z is the number of 
+    matches
+  assumption: length of the alphabet is 256 (extended ASCII)
+*/
+
+#include <time.h>
+#include "../../../lib/clib.h"
+#include "rklib/rk.h"
+
+  // the shifts found for a pattern
+typedef struct {
+  size_t *shifts;
+  size_t len, cap;
+} shiftList;
+
+//===================================================================
+// Appends the shift of a match of pattern p to its list
+void addShift(size_t p, size_t shift, void *arg) {
+  shiftList *list = (shiftList *) arg + p;
+  if (list->len == list->cap) {
+    list->cap = list->cap ? 2 * list->cap : 8;
+    list->shifts = safeRealloc(list->shifts, 
+                               list->cap * sizeof(size_t));
+  }
+  list->shifts[list->len++] = shift;
+}
+
+//===================================================================
+// Finds all matches of all patterns in text in a single pass and
+// prints the valid shifts of each pattern
+bool matcher(string *text, string **patterns, size_t k) {
+  
+  srand(time(NULL));
+  rkSet *S = newRkSet(patterns, k, rkRandomBase());
+  if (! S) 
+    return false;
+
+  shiftList *lists = safeCalloc(k, sizeof(shiftList));
+  rkStats stats;
+  matchRkSet(S, text, addShift, lists, &stats);
+
+  for (size_t p = 0; p < k; p++) {
+    printf("Pattern: ");
+    showString(patterns[p]);
+    printf("Shifts: ");
+    for (size_t i = 0; i < lists[p].len; i++) 
+      printf(i ? ", %zu" : "%zu", lists[p].shifts[i]);
+    printf(lists[p].len ? "\n" : "None.\n");
+    free(lists[p].shifts);
+  }
+  printf("Spurious hits: %zu of %zu\n", stats.spurious, stats.hits);
+  free(lists);
+  freeRkSet(S);
+  return true;
+}
+
+//===================================================================
+
+int main () {
+
+  size_t k; 
+  reader *R = stdinReader();
+  if (! readerScan(R, "%zu", &k)) {
+    fprintf(stderr, "Invalid input\n");
+    return EXIT_FAILURE;
+  }
+  readerSkipLine(R);
+
+  string **patterns = safeCalloc(k, sizeof(string *));
+  for (size_t p = 0; p < k; p++) {
+    READ_STRING(pattern, '\n');
+    patterns[p] = pattern;
+  }
+  READ_STRING(text, EOF);
+
+  bool ok = matcher(text, patterns, k);
+
+  for (size_t p = 0; p < k; p++) 
+    freeString(patterns[p]);
+  free(patterns);
+  freeString(text);
+  return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,191 @@
+/*
+  file: rk.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: Rabin-Karp matching of one or more patterns of the
+    same length, using a polynomial rolling hash modulo the Mersenne
+    prime 2^61 - 1 and a hash table of the pattern hashes
+*/
+
+#include "rk.h"
+
+//===================================================================
+// Returns the hash of the m characters starting at s
+static uint64_t hashOf(rkSet *S, unsigned char const *s) {
+  uint64_t h = 0;
+  for (size_t i = 0; i < S->m; i++)
+    h = modP(mulP(h, S->base) + s[i]);
+  return h;
+}
+
+//===================================================================
+// Returns the slot of the table for hash h, using multiply-shift
+static inline size_t slotOf(rkSet *S, uint64_t h) {
+  return (h * UINT64_C(0x9E3779B97F4A7C15)) >> S->shift;
+}
+
+//===================================================================
+// Returns a random base in [256, 2^61 - 2]
+uint64_t rkRandomBase(void) {
+  uint64_t r = 0;
+  for (int i = 0; i < 4; i++)
+    r = (r << 16) ^ (rand() & 0xFFFF);
+  return 256 + r % (RK_MOD - 257);
+}
+
+//===================================================================
+// Builds the set of k patterns for the given base
+rkSet *newRkSet(string **patterns, size_t k, uint64_t base) {
+
+  if (k == 0 || strLen(patterns[0]) == 0) {
+    fprintf(stderr, "Error: empty set of patterns or empty pattern\n");
+    return NULL;
+  }
+  for (size_t p = 1; p < k; p++) 
+    if (strLen(patterns[p]) != strLen(patterns[0])) {
+      fprintf(stderr, "Error: patterns differ in length\n");
+      return NULL;
+    }
+
+  rkSet *S = safeCalloc(1, sizeof(rkSet));
+  S->k = k;
+  S->m = strLen(patterns[0]);
+  S->patterns = patterns;
+  S->base = base % RK_MOD;
+
+    // adding out[c] removes the contribution of c when it leaves 
+    // the window, after the window has been multiplied by the base
+  uint64_t h = 1;
+  for (size_t i = 0; i < S->m; i++) 
+    h = mulP(h, S->base);
+  S->pow[0] = 1;
+  for (size_t i = 1; i <= 4; i++)
+    S->pow[i] = mulP(S->pow[i - 1], S->base);
+  for (size_t c = 0; c < 256; c++) 
+    S->out[c] = modP(RK_MOD - mulP(c, h));
+
+    // the table has at least 16 times as many slots as patterns, 
+    // so that most windows hit an empty slot right away, and the 
+    // branch that checks this is predicted well
+  size_t size = 16;
+  S->shift = 60;
+  while (size < 16 * k) {
+    size *= 2;
+    S->shift--;
+  }
+  S->mask = size - 1;
+  S->hashes = safeCalloc(size, sizeof(uint64_t));
+  S->first = safeCalloc(size, sizeof(int32_t));
+  S->next = safeCalloc(k, sizeof(int32_t));
+  for (size_t i = 0; i < size; i++) 
+    S->hashes[i] = RK_EMPTY;
+
+    // patterns with the same hash are chained in input order
+  int32_t *last = safeCalloc(size, sizeof(int32_t));
+  for (size_t p = 0; p < k; p++) {
+    uint64_t hp = hashOf(S, (unsigned char *) str(patterns[p]));
+    size_t i = slotOf(S, hp);
+    while (S->hashes[i] != RK_EMPTY && S->hashes[i] != hp) 
+      i = (i + 1) & S->mask;
+    S->next[p] = -1;
+    if (S->hashes[i] == RK_EMPTY) {
+      S->hashes[i] = hp;
+      S->first[i] = p;
+    } else 
+      S->next[last[i]] = p;
+    last[i] = p;
+  }
+  free(last);
+  return S;
+}
+
+//===================================================================
+// Deallocates the set
+void freeRkSet(rkSet *S) {
+  free(S->hashes);
+  free(S->first);
+  free(S->next);
+  free(S);
+}
+
+//===================================================================
+// Returns the first pattern with hash h, or -1 if there is none
+static inline int32_t lookup(rkSet *S, uint64_t h) {
+  size_t i = slotOf(S, h);
+  while (S->hashes[i] != h) {
+    if (S->hashes[i] == RK_EMPTY) 
+      return -1;
+    i = (i + 1) & S->mask;
+  }
+  return S->first[i];
+}
+
+//===================================================================
+// Verifies the window at shift i if its hash h equals that of a 
+// pattern, and reports the patterns that match it
+static inline void checkWindow(rkSet *S, unsigned char const *T, 
+                               size_t i, uint64_t h, rkReport report,
+                               void *arg, rkStats *st) {
+  int32_t p = lookup(S, h);
+  if (p < 0) 
+    return;
+  st->hits++;
+  bool found = false;
+  for ( ; p >= 0; p = S->next[p]) 
+    if (memcmp(T + i, str(S->patterns[p]), S->m) == 0) {
+      if (report) 
+        report(p, i, arg);
+      st->matches++;
+      found = true;
+    }
+  if (! found) 
+    st->spurious++;
+}
+
+//===================================================================
+// Reports all matches of all patterns in text
+size_t matchRkSet(rkSet *S, string *text, rkReport report, 
+                  void *arg, rkStats *stats) {
+
+  rkStats st = { 0, 0, 0 };
+  unsigned char const *T = (unsigned char *) str(text);
+  size_t n = strLen(text), m = S->m, i = 0;
+  if (m > n) {
+    if (stats) *stats = st;
+    return 0;
+  }
+
+    // sliding the window by one shift changes its hash h into
+    // h * b - T[i] * b^m + T[i+m] = h * b + d[i], so that sliding 
+    // it by four shifts at once gives h * b^4 + ((d[i] * b + 
+    // d[i+1]) * b + d[i+2]) * b + d[i+3]; the terms d do not depend
+    // on h, so that only one multiplication per four shifts has to 
+    // wait for the previous hash, instead of one per shift
+  uint64_t h = hashOf(S, T), b = S->base, *pow = S->pow;
+  for ( ; i + 4 <= n - m; i += 4) {
+    uint64_t d0 = S->out[T[i]] + T[i + m];
+    uint64_t d1 = S->out[T[i + 1]] + T[i + m + 1];
+    uint64_t d2 = S->out[T[i + 2]] + T[i + m + 2];
+    uint64_t d3 = S->out[T[i + 3]] + T[i + m + 3];
+    uint64_t s2 = modP(mulLazy(d0, b) + d1);
+    uint64_t s3 = modP(mulLazy(s2, b) + d2);
+    uint64_t s4 = modP(mulLazy(s3, b) + d3);
+    checkWindow(S, T, i, h, report, arg, &st);
+    checkWindow(S, T, i + 1, modP(mulLazy(h, b) + d0), report, 
+                arg, &st);
+    checkWindow(S, T, i + 2, modP(mulLazy(h, pow[2]) + s2), report, 
+                arg, &st);
+    checkWindow(S, T, i + 3, modP(mulLazy(h, pow[3]) + s3), report, 
+                arg, &st);
+    h = modP(mulLazy(h, pow[4]) + s4);
+  }
+  for ( ; ; i++) {
+    checkWindow(S, T, i, h, report, arg, &st);
+    if (i == n - m) 
+      break;
+    h = modP(mulLazy(h, b) + S->out[T[i]] + T[i + m]);
+  }
+  if (stats) *stats = st;
+  return st.matches;
+}
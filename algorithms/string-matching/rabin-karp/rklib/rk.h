@@ -0,0 +1,98 @@
+#ifndef RK_H_INCLUDED
+#define RK_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+#define RK_MOD ((UINT64_C(1) << 61) - 1)  // Mersenne prime 2^61 - 1
+#define RK_EMPTY UINT64_MAX               // marks an empty slot
+
+#define RK_MASK30 ((UINT64_C(1) << 30) - 1)
+#define RK_MASK31 ((UINT64_C(1) << 31) - 1)
+
+  // Returns a number < 2^61 - 1 that is congruent to x, using 
+  // 2^61 ≡ 1
+static inline uint64_t modP(uint64_t x) {
+  x = (x >> 61) + (x & RK_MOD);
+  return x >= RK_MOD ? x - RK_MOD : x;
+}
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128;
+
+  // Returns a number < 2^62 that is congruent to a * b mod 2^61 - 1,
+  // for a, b < 2^61, by folding the upper bits of the 128-bit 
+  // product
+static inline uint64_t mulLazy(uint64_t a, uint64_t b) {
+  uint128 prod = (uint128) a * b;
+  return (uint64_t) (prod >> 61) + ((uint64_t) prod & RK_MOD);
+}
+#else
+
+  // Returns a number < 2^62 that is congruent to a * b mod 2^61 - 1,
+  // for a, b < 2^61, without a 128-bit product: with a = a1 * 2^31 
+  // + a0 and b = b1 * 2^31 + b0, the product is a1 * b1 * 2^62 + 
+  // (a0 * b1 + a1 * b0) * 2^31 + a0 * b0, where 2^62 ≡ 2 and the 
+  // middle term is split at bit 30 so that its upper part wraps 
+  // around to bit 0
+static inline uint64_t mulLazy(uint64_t a, uint64_t b) {
+  uint64_t a1 = a >> 31, a0 = a & RK_MASK31;
+  uint64_t b1 = b >> 31, b0 = b & RK_MASK31;
+  uint64_t mid = a0 * b1 + a1 * b0;
+  return modP(2 * a1 * b1 + (mid >> 30) + ((mid & RK_MASK30) << 31) 
+              + a0 * b0);
+}
+#endif
+
+  // Returns a * b mod 2^61 - 1 for a, b < 2^61
+static inline uint64_t mulP(uint64_t a, uint64_t b) {
+  return modP(mulLazy(a, b));
+}
+
+  // A set of patterns of the same length m, matched by a polynomial
+  // rolling hash modulo 2^61 - 1. The hashes of the patterns are kept
+  // in an open addressing hash table, so that each window of the text
+  // needs a single lookup, regardless of the number of patterns
+typedef struct {
+  size_t k, m;          // number of patterns and their length
+  string **patterns;    // the patterns, not owned
+  uint64_t base;        // base of the polynomial hash
+  uint64_t pow[5];      // base^i mod 2^61 - 1 for i ≤ 4
+  uint64_t out[256];    // -c * base^m mod 2^61 - 1 for each c
+  uint64_t *hashes;     // hash of each slot, or RK_EMPTY
+  int32_t *first;       // first pattern with the hash of each slot
+  int32_t *next;        // next pattern with the same hash, or -1
+  size_t mask;          // number of slots - 1
+  int shift;            // 64 - log2(number of slots)
+} rkSet;
+
+  // Counters for instrumentation: a hit is a window whose hash 
+  // equals that of a pattern, and a spurious hit is a hit that does 
+  // not match any pattern
+typedef struct {
+  size_t hits, spurious, matches;
+} rkStats;
+
+  // Called for each match of pattern p at the given shift
+typedef void (*rkReport)(size_t p, size_t shift, void *arg);
+
+  // Returns a random base for the hash in [256, 2^61 - 2]
+uint64_t rkRandomBase(void);
+
+  // Builds the set of k patterns for the given base; returns NULL if
+  // the patterns are empty or do not all have the same length
+rkSet *newRkSet(string **patterns, size_t k, uint64_t base);
+
+  // Deallocates the set, but not the patterns
+void freeRkSet(rkSet *S);
+
+  // Reports all matches of all patterns in text, in order of their
+  // shifts, where patterns with the same shift are reported in input
+  // order; returns the number of matches. Both report and stats may 
+  // be NULL
+size_t matchRkSet(rkSet *S, string *text, rkReport report, 
+                  void *arg, rkStats *stats);
+
+#endif // RK_H_INCLUDED
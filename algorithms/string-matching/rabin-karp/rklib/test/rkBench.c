@@ -0,0 +1,176 @@
+/*
+  Benchmark of the Rabin-Karp matchers
+  The pattern and text are read from a test input file, as used by
+    the string matchers, and the text is repeated until it reaches
+    the given size. First, the hash of rka.c, which reduces modulo 
+    ULONG_MAX at each step, is compared with the hash modulo the 
+    Mersenne prime 2^61 - 1 for the pattern. Then, sets of k 
+    patterns of the same length are taken from random positions in
+    the text, and matched in a single pass, using the hash table, 
+    and in k separate passes, for k up to maxPatterns. For each run,
+    the throughput is given in MB of text per second, together with
+    the number of matches, hits and spurious hits
+  Usage: ./rkBench.out file [textMB] [maxPatterns]
+  Example: ./rkBench.out ../../tests/1.in 256 10000
+  Author: David De Potter
+*/
+
+#include "../rk.h"
+#include <limits.h>
+#include <time.h>
+
+//===================================================================
+// Matches pattern in text in the same way as the computeShifts 
+// function in rka.c, and counts the hits and spurious hits
+void rkaCount(string *pattern, string *text, rkStats *stats) {
+  
+  size_t m = strLen(pattern), n = strLen(text);
+  unsigned long long pHash = 0, tHash = 0, h = 1, d = 256; 
+  unsigned long long p = ULONG_MAX;
+  rkStats st = { 0, 0, 0 };
+  for (size_t i = 0; i < m - 1; i++) 
+    h = (h * d) % p;
+  for (size_t i = 0; i < m; i++) {
+    pHash = (pHash * d + charAt(pattern, i)) % p;
+    tHash = (tHash * d + charAt(text, i)) % p;
+  }
+  for (size_t i = 0; i <= n - m; i++) {
+    if (pHash == tHash) {
+      st.hits++;
+      if (memcmp(str(text) + i, str(pattern), m) == 0)
+        st.matches++;
+      else 
+        st.spurious++;
+    }
+    if (i < n - m) 
+      tHash = ((tHash - charAt(text, i) * h) * d 
+               + charAt(text, m + i)) % p;
+  }
+  *stats = st;
+}
+
+//===================================================================
+// Reads the pattern (first line) and text (rest) from the file, 
+// and repeats the text until it has the given size
+bool readInput(char const *path, size_t size, string **pattern, 
+               string **text) {
+  FILE *file = fopen(path, "rb");
+  if (! file) {
+    fprintf(stderr, "Cannot open %s\n", path);
+    return false;
+  }
+  reader *R = readerNew(file, 0);
+  *pattern = newString(100);
+  int c;
+  while ((c = readerChar(R)) != EOF && c != '\n') {
+    if ((*pattern)->size + 1 == (*pattern)->cap) {
+      (*pattern)->cap *= 2;
+      (*pattern)->data = safeRealloc((*pattern)->data, 
+                                     (*pattern)->cap);
+    }
+    (*pattern)->data[(*pattern)->size++] = c;
+  }
+  (*pattern)->data[(*pattern)->size] = '\0';
+
+  *text = newString(size + 1);
+  size_t len = 0;
+  while ((c = readerChar(R)) != EOF && len < size)
+    (*text)->data[len++] = c;
+  readerFree(R);
+  fclose(file);
+  if (len == 0) {
+    fprintf(stderr, "Empty text in %s\n", path);
+    return false;
+  }
+  for (size_t i = len; i < size; i++)
+    (*text)->data[i] = (*text)->data[i - len];
+  (*text)->size = size;
+  return true;
+}
+
+//===================================================================
+// Shows the throughput and counters of a run
+void showRun(char const *name, size_t k, double secs, size_t textMB,
+             rkStats *st) {
+  printf("%14s  %7zu  %10.1f  %10zu  %10zu  %10zu\n", name, k, 
+         textMB / secs, st->matches, st->hits, st->spurious);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s file [textMB] [maxPatterns]\n", 
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+  size_t textMB = argc > 2 ? strtoul(argv[2], NULL, 10) : 256;
+  size_t maxPatterns = argc > 3 ? strtoul(argv[3], NULL, 10) : 10000;
+  string *pattern, *text;
+  if (! readInput(argv[1], textMB << 20, &pattern, &text))
+    return EXIT_FAILURE;
+  size_t m = strLen(pattern), n = strLen(text);
+  if (m == 0 || m > n) {
+    fprintf(stderr, "Invalid pattern length %zu\n", m);
+    return EXIT_FAILURE;
+  }
+  srand(42);
+  printf("Pattern length: %zu, text: %zu MB\n", m, textMB);
+  printf("%14s  %7s  %10s  %10s  %10s  %10s\n", "matcher", "k", 
+         "MB/s", "matches", "hits", "spurious");
+
+  rkStats st;
+  clock_t start = clock();
+  rkaCount(pattern, text, &st);
+  showRun("rka.c", 1, (double)(clock() - start) / CLOCKS_PER_SEC, 
+          textMB, &st);
+
+  rkSet *S = newRkSet(&pattern, 1, rkRandomBase());
+  start = clock();
+  matchRkSet(S, text, NULL, NULL, &st);
+  showRun("2^61 - 1", 1, (double)(clock() - start) / CLOCKS_PER_SEC,
+          textMB, &st);
+  freeRkSet(S);
+
+    // sets of patterns taken from random positions in the text, 
+    // within the part that was read from the file
+  string **patterns = safeCalloc(maxPatterns, sizeof(string *));
+  size_t range = MIN(n - m + 1, (size_t) RAND_MAX);
+  for (size_t p = 0; p < maxPatterns; p++) {
+    size_t i = rand() % range;
+    patterns[p] = newString(m + 1);
+    memcpy(patterns[p]->data, str(text) + i, m);
+    patterns[p]->size = m;
+  }
+  for (size_t k = 1; k <= maxPatterns; k *= 10) {
+    S = newRkSet(patterns, k, rkRandomBase());
+    start = clock();
+    matchRkSet(S, text, NULL, NULL, &st);
+    showRun("hash set", k, (double)(clock() - start) / CLOCKS_PER_SEC,
+            textMB, &st);
+    freeRkSet(S);
+    if (k > 10) 
+      continue;
+
+      // the same patterns, one pass each
+    rkStats total = { 0, 0, 0 };
+    start = clock();
+    for (size_t p = 0; p < k; p++) {
+      S = newRkSet(patterns + p, 1, rkRandomBase());
+      matchRkSet(S, text, NULL, NULL, &st);
+      total.matches += st.matches;
+      total.hits += st.hits;
+      total.spurious += st.spurious;
+      freeRkSet(S);
+    }
+    showRun("k passes", k, (double)(clock() - start) / CLOCKS_PER_SEC,
+            textMB, &total);
+  }
+
+  for (size_t p = 0; p < maxPatterns; p++) 
+    freeString(patterns[p]);
+  free(patterns);
+  freeString(pattern);
+  freeString(text);
+  return 0;
+}
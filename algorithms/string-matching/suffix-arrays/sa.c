@@ -5,207 +5,46 @@
   license: MIT, see LICENSE file in repository root folder
   description: suffix arrays, longest common prefixes, string
     matching, longest repeated substrings, number of unique
-    substrings, longest palindromic substring
+    substrings, longest palindromic substring, and a persistent
+    index file that is memory-mapped to answer batches of patterns;
+    the suffix arrays themselves are built in salib/suffix.c
+  usage: ./sa.out < input           pattern and text from stdin
+         ./sa.out -b index < text   builds index file for text
+         ./sa.out -q index < pats   answers patterns, one per line
   assumption: Σ is the extended ASCII alphabet (256 characters)
 */
 
+#define _POSIX_C_SOURCE 200809L
 #include "../../../lib/clib.h"
-
-typedef struct {
-  size_t index;       // index of suffix in text
-  size_t leftRank;    // rank of left half of suffix
-  size_t rightRank;   // rank of right half of suffix
-} suffix;
-
-//===================================================================
-// Sorts suffixes by their ranks by using counting sort twice: 
-// first on the right ranks and then on the left ranks
-void radixSort(suffix *suffixes, size_t n, size_t maxRank) {
-  
-  size_t *count = safeCalloc(maxRank, sizeof(size_t));
-  suffix *output = safeCalloc(n, sizeof(suffix));
-
-    // SORT BY RIGHT RANKS
-    // count occurences of each rank
-  for (size_t i = 0; i < n; ++i) 
-    count[suffixes[i].rightRank]++;
-    // compute cumulative counts
-  for (size_t i = 1; i < maxRank; ++i) 
-    count[i] += count[i - 1];
-    // sort suffixes
-  for (size_t i = n; i--; ) {
-    output[count[suffixes[i].rightRank] - 1] = suffixes[i];
-    count[suffixes[i].rightRank]--;
-  }
-  
-    // SORT BY LEFT RANKS
-    // reset count
-  memset(count, 0, maxRank * sizeof(size_t));
-    // count occurences of each rank
-  for (size_t i = 0; i < n; ++i) 
-    count[output[i].leftRank]++;
-    // compute cumulative counts
-  for (size_t i = 1; i < maxRank; ++i) 
-    count[i] += count[i - 1];
-    // sort suffixes
-  for (size_t i = n; i--; ) {
-    suffixes[count[output[i].leftRank] - 1] = output[i];
-    count[output[i].leftRank]--;
-  }
-  free(count);
-  free(output);
-}
-
-//===================================================================
-// Assigns ranks to suffixes and returns the maximum rank
-size_t makeRanks (suffix *suffixes, size_t *ranks, size_t n) {
-  size_t rank = 1;
-  ranks[suffixes[0].index] = rank;
-  for (size_t i = 1; i < n; i++) {
-    if (suffixes[i - 1].leftRank != suffixes[i].leftRank  
-        || suffixes[i - 1].rightRank != suffixes[i].rightRank) 
-      rank++;
-    ranks[suffixes[i].index] = rank;
-  }
-  return rank;
-}
-
-//===================================================================
-// Builds a suffix array for text of length n in O(nlogn) time
-size_t *buildSuffixArray(string *text) {
-
-  size_t n = strLen(text);
-  size_t *sa = safeCalloc(n, sizeof(size_t));
-  suffix *suffixes = safeCalloc(n, sizeof(suffix));
-  size_t *ranks = safeCalloc(n, sizeof(size_t));
-
-    // initialize suffixes
-  for (size_t i = 0; i < n; i++) {
-    suffixes[i].index = i;
-    suffixes[i].leftRank = charAt(text, i);
-    suffixes[i].rightRank = (i + 1 < n) ? charAt(text, i + 1) : 0;
-  }
-
-    // sort suffixes by their ranks
-  radixSort(suffixes, n, 256);
-    // length of sorted suffixes
-  size_t len = 2; 
- 
-    // repeat until all suffixes are sorted
-  while (len < n) {
-      // assign ranks to suffixes and return maximum rank
-    size_t maxRank = makeRanks(suffixes, ranks, n);
-
-      // update left and right ranks
-    for (size_t i = 0; i < n; i++) {
-      suffixes[i].leftRank = ranks[i];
-      suffixes[i].rightRank = (i + len < n) ? ranks[i + len] : 0;	
-      suffixes[i].index = i;
-    }
-      // sort suffixes according to new substring ranks
-    radixSort(suffixes, n, maxRank + 1);
-      // the sorted suffixes are twice as long
-    len *= 2;
-  }
-    // store the final indices of the sorted suffixes
-  for (size_t i = 0; i < n; i++) 
-    sa[i] = suffixes[i].index;
-  free(suffixes);
-  free(ranks); 
-  return sa;
-}
-
-//===================================================================
-// Builds a longest common prefix array for given text and its 
-// suffix array in O(n) time
-size_t *buildLCPArray(string *text, size_t *sa) {
-  
-  size_t n = strLen(text);
-  size_t *lcp = safeCalloc(n, sizeof(size_t));
-  size_t *ranks = safeCalloc(n, sizeof(size_t));
-
-    // compute suffix ranks; this is the inverse of sa
-    // ranks[i] = sorted index of suffix at text index i
-  for (size_t i = 0; i < n; i++) 
-    ranks[sa[i]] = i; 
-
-    // lcp of first suffix is 0 
-  lcp[0] = 0;         
-    // length of longest common prefix
-  size_t len = 0;     
-    // iterate over all suffixes in text order
-  for (size_t i = 0; i < n; i++) { 
-    if (ranks[i] == 0) 
-      continue;       
-      // get text index j of the lexicographically preceding suffix
-    size_t j = sa[ranks[i] - 1];      
-      // compute lcp of suffixes at text indices i and j
-    while (i + len < n && j + len < n 
-           && charAt(text, i + len) == charAt(text, j + len)) 
-      len++;  
-      // store lcp of suffix at sorted index ranks[i]
-    lcp[ranks[i]] = len; 
-      // lcp of next suffix is at least one less 
-      // than current lcp if len > 0, otherwise it is 0
-    if (len > 0)
-      len--;  
-  }
-  free(ranks);
-  return lcp;
-}
+#include "salib/suffix.h"
+#include "../../dynamic-programming/palib/pal.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 //===================================================================
 // Finds all occurences of pattern in text using binary search
-// Time complexity: O(mlogn) 
+// Time complexity: O(m + logn + occ) 
 void matcher(string *pattern, string *text, 
-             size_t *sa, size_t *lcp) {
+             saIndex *sa, saIndex *lcp, saIndex *lcpLR) {
   
-  size_t m = strLen(pattern), n = strLen(text);
-  size_t left = 0, right = n - 1, i, j, mid; 
-  bool foundShift = false;
-
-    // find occurence of pattern using binary search
-  while (left <= right) {
-    mid = left + (right - left)/2;  
-    i = sa[mid];        // index of suffix 
-    j = 0;              // index of pattern
-      // compare pattern and suffix at middle index
-    while (i + j < n && j < m 
-           && charAt(text, i + j) == charAt(pattern, j))
-      j++;
-      // pattern found?
-    if (j == m) {
-      foundShift = true;
-      break;
-    }
-      // is pattern lexicographically larger ?
-    if (j < m && charAt(text, i + j) < charAt(pattern, j)) 
-      left = mid + 1; 
-      // pattern is lexicographically smaller
-    else right = mid - 1; 
-  }
-  if (! foundShift) {
+  size_t start, end;
+  if (! findPattern(pattern, text, sa, lcp, lcpLR, &start, &end)) {
     printf("No matches found.\n");
     return;
   }
- 
-    // find all other occurences of pattern in text
-  size_t start = mid, end = mid;
-    // find start of occurences
-  while (start > 0 && lcp[start] >= m) start--;
-    // find end of occurences
-  while (end < n - 1 && lcp[end + 1] >= m) end++;
     // print all valid shifts
   printf("Pattern: ");
   showString(pattern);
   printf("Shifts (%zu): ", end - start + 1);
   for (size_t i = start; i <= end; i++) 
-    printf(i < end ? "%zu, " : "%zu\n", sa[i]);
+    printf(i < end ? "%zu, " : "%zu\n", (size_t) sa[i]);
 }
 
 //===================================================================
 // Finds all longest repeated substrings in text in O(n) time
-void getLrs(string *text, size_t *sa, size_t *lcp) {
+void getLrs(string *text, saIndex *sa, saIndex *lcp) {
 
     // find length of longest repeated substring
   size_t n = strLen(text), max = 0;
@@ -237,7 +76,7 @@ void getLrs(string *text, size_t *sa, size_t *lcp) {
 //===================================================================
 // Computes the total number of substrings in text without counting
 // duplicates in O(n) time
-void getNrSubs(string *text, size_t *sa, size_t  *lcp) {
+void getNrSubs(string *text, saIndex *sa, saIndex *lcp) {
    
   size_t lcpSum = 0, n = strLen(text);
   for (size_t i = 1; i < n; ++i)
@@ -248,48 +87,299 @@ void getNrSubs(string *text, size_t *sa, size_t  *lcp) {
 
 //===================================================================
 // Computes the longest palindromic substring that occurs in text in  
-// O(nlogn) time
+// O(n) time, using the radii of Manacher's algorithm (see
+// ../../dynamic-programming/palib/pal.c) instead of the suffix
+// array and LCP array of the text concatenated with its reverse
 void getLps(string *text) {
   
-  size_t n = strLen(text);
-  size_t *lps = safeCalloc(n, sizeof(size_t));
-    
-    // concatenate text and its reverse
-  string *str = copyString(text);
-  string *rev = copyString(text);
-  concatStrings(str, reverseString(rev));
-
-    // build suffix array and LCP array for concatenated string
-  size_t *sa = buildSuffixArray(str);
-  size_t *lcp = buildLCPArray(str, sa);
+  size_t *rad = palRadii(text), max = 0, k = 0;
+  unsigned char *t = str(text);
 
-    // find longest palindromic substring
-  size_t max = 0, k = 0;
-  for (size_t i = 1; i < 2*n; ++i) 
-    if (lcp[i] > max && sa[i] == 2 * n - sa[i - 1] - lcp[i]) {
-      max = lcp[i];
-      k = sa[i];
+  for (size_t c = 0; c <= 2 * strLen(text); c++) {
+    size_t start = (c - rad[c]) / 2;
+      // on ties, the lexicographically smallest palindrome is kept,
+      // which is the one the suffix array finds first
+    if (rad[c] > max || (rad[c] == max && 
+                         memcmp(t + start, t + k, max) < 0)) {
+      max = rad[c];
+      k = start;
     }
+  }
 
   printf("Longest palindromic substring: ");
-  showSubstring(str, k, k + max - 1, '\n');
-  free(lps); freeString(str); freeString(rev);
-  free(sa); free(lcp);
+  showSubstring(text, k, k + max - 1, '\n');
+  free(rad);
 }
 
 //===================================================================
+// INDEX FILES
+// An index file stores the text together with its suffix array, 
+// LCP array and LCP-LR array, so that it can be memory-mapped and 
+// queried directly, without copying or rebuilding anything. All 
+// integers are stored in little-endian order. The 64-byte header 
+// is laid out as follows:
+//   0: magic "CLRSSAIX"      8: format version (32 bits)
+//  12: index width in bytes  16: text length n (64 bits)
+//  24: text offset           32: suffix array offset 
+//  40: LCP array offset      48: file size  
+//  56: LCP-LR array offset
+// The text starts right after the header; the suffix array and LCP 
+// array each hold n entries of the index width, the LCP-LR array 
+// 2n entries, and all three are padded to start at an offset that
+// is a multiple of 8
+
+#define SA_MAGIC "CLRSSAIX"
+#define SA_VERSION 2
+#define SA_HEADER 64
+  // rounds x up to a multiple of 8
+#define ALIGN8(x) (((x) + 7) & ~(size_t) 7)
+
+typedef struct {
+  unsigned char *map;   // the mapped index file
+  size_t mapSize;       // size of the mapping in bytes
+  string text;          // the text, pointing into the mapping
+  saIndex *sa;          // suffix array, pointing into the mapping
+  saIndex *lcp;         // LCP array, pointing into the mapping
+  saIndex *lcpLR;       // LCP-LR array, pointing into the mapping
+} saFile;
+
+//===================================================================
+// Returns true if the machine stores integers in little-endian order;
+// only then can the arrays in an index file be used in place
+static bool isLittleEndian() {
+  uint16_t x = 1;
+  return *(unsigned char *) &x == 1;
+}
 
-int main() {
+//===================================================================
+// Stores x in little-endian order in the given number of bytes
+static void putLE(unsigned char *buf, uint64_t x, size_t bytes) {
+  for (size_t i = 0; i < bytes; i++, x >>= 8)
+    buf[i] = x & 0xff;
+}
+
+//===================================================================
+// Loads a little-endian integer of the given number of bytes
+static uint64_t getLE(unsigned char const *buf, size_t bytes) {
+  uint64_t x = 0;
+  for (size_t i = bytes; i--; )
+    x = x << 8 | buf[i];
+  return x;
+}
+
+//===================================================================
+// Writes an index file for text with its suffix, LCP and LCP-LR 
+// arrays to the given path; returns true on success
+bool writeSaFile(char const *path, string *text, saIndex *sa, 
+                 saIndex *lcp, saIndex *lcpLR) {
+
+  if (! isLittleEndian()) {
+    fprintf(stderr, "Index files require a little-endian "
+                    "machine\n");
+    return false;
+  }
+  size_t n = strLen(text), w = sizeof(saIndex);
+  size_t saOffset = ALIGN8(SA_HEADER + n);
+  size_t lcpOffset = ALIGN8(saOffset + n * w);
+  size_t lcpLROffset = ALIGN8(lcpOffset + n * w);
+  size_t size = lcpLROffset + 2 * n * w;
+
+  unsigned char header[SA_HEADER] = { 0 };
+  memcpy(header, SA_MAGIC, 8);
+  putLE(header + 8, SA_VERSION, 4);
+  putLE(header + 12, w, 4);
+  putLE(header + 16, n, 8);
+  putLE(header + 24, SA_HEADER, 8);
+  putLE(header + 32, saOffset, 8);
+  putLE(header + 40, lcpOffset, 8);
+  putLE(header + 48, size, 8);
+  putLE(header + 56, lcpLROffset, 8);
+
+  FILE *file = fopen(path, "wb");
+  if (! file) {
+    fprintf(stderr, "Cannot create index file %s\n", path);
+    return false;
+  }
+  unsigned char pad[8] = { 0 };
+  size_t pad1 = saOffset - SA_HEADER - n;
+  size_t pad2 = lcpOffset - saOffset - n * w;
+  size_t pad3 = lcpLROffset - lcpOffset - n * w;
+  bool ok = fwrite(header, 1, SA_HEADER, file) == SA_HEADER
+    && fwrite(str(text), 1, n, file) == n
+    && fwrite(pad, 1, pad1, file) == pad1
+    && fwrite(sa, w, n, file) == n
+    && fwrite(pad, 1, pad2, file) == pad2
+    && fwrite(lcp, w, n, file) == n
+    && fwrite(pad, 1, pad3, file) == pad3
+    && fwrite(lcpLR, w, 2 * n, file) == 2 * n;
+  if (fclose(file) != 0) 
+    ok = false;
+  if (! ok) 
+    fprintf(stderr, "Cannot write index file %s\n", path);
+  return ok;
+}
+
+//===================================================================
+// Checks the header of a mapped index file and sets up the views 
+// of the text and arrays; returns true if the file is valid
+static bool loadSaFile(saFile *F) {
+
+  unsigned char *h = F->map;
+  if (F->mapSize < SA_HEADER || memcmp(h, SA_MAGIC, 8) != 0) {
+    fprintf(stderr, "Not an index file\n");
+    return false;
+  }
+  if (getLE(h + 8, 4) != SA_VERSION) {
+    fprintf(stderr, "Unsupported index file version %u\n", 
+            (unsigned) getLE(h + 8, 4));
+    return false;
+  }
+  if (getLE(h + 12, 4) != sizeof(saIndex)) {
+    fprintf(stderr, "Index file uses %u-bit indices; compile %s "
+            "-D SA_INDEX64\n", (unsigned) getLE(h + 12, 4) * 8,
+            sizeof(saIndex) == 4 ? "with" : "without");
+    return false;
+  }
+  uint64_t n = getLE(h + 16, 8), textOffset = getLE(h + 24, 8);
+  uint64_t saOffset = getLE(h + 32, 8), lcpOffset = getLE(h + 40, 8);
+  uint64_t lcpLROffset = getLE(h + 56, 8), w = sizeof(saIndex);
+  if (getLE(h + 48, 8) != F->mapSize || n >= F->mapSize
+      || textOffset < SA_HEADER || textOffset + n > saOffset 
+      || saOffset % 8 || lcpOffset % 8 || lcpLROffset % 8
+      || saOffset + n * w > lcpOffset 
+      || lcpOffset + n * w > lcpLROffset
+      || lcpLROffset + 2 * n * w > F->mapSize) {
+    fprintf(stderr, "Corrupt index file\n");
+    return false;
+  }
+  F->text.data = F->map + textOffset;
+  F->text.size = F->text.cap = n;
+  F->sa = (saIndex *) (F->map + saOffset);
+  F->lcp = (saIndex *) (F->map + lcpOffset);
+  F->lcpLR = (saIndex *) (F->map + lcpLROffset);
+  return true;
+}
+
+//===================================================================
+// Maps the index file at the given path into memory; the text and
+// arrays are used in place, so that they are only read from disk 
+// when accessed. Returns NULL on failure
+saFile *openSaFile(char const *path) {
+
+  if (! isLittleEndian()) {
+    fprintf(stderr, "Index files require a little-endian "
+                    "machine\n");
+    return NULL;
+  }
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) < 0 || st.st_size == 0) {
+    fprintf(stderr, "Cannot open index file %s\n", path);
+    if (fd >= 0) close(fd);
+    return NULL;
+  }
+  saFile *F = safeCalloc(1, sizeof(saFile));
+  F->mapSize = st.st_size;
+  F->map = mmap(NULL, F->mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the file
+  close(fd);
+  if (F->map == MAP_FAILED) {
+    fprintf(stderr, "Cannot map index file %s\n", path);
+    free(F);
+    return NULL;
+  }
+  if (! loadSaFile(F)) {
+    munmap(F->map, F->mapSize);
+    free(F);
+    return NULL;
+  }
+  return F;
+}
+
+//===================================================================
+// Unmaps an index file
+void closeSaFile(saFile *F) {
+  munmap(F->map, F->mapSize);
+  free(F);
+}
+
+//===================================================================
+// Reads the next line from R into s, without the newline, and keeps
+// the data null-terminated; returns false if there are no more lines
+static bool readLine(reader *R, string *s) {
+  int c = readerChar(R);
+  if (c == EOF) 
+    return false;
+  s->size = 0;
+  while (c != EOF && c != '\n') {
+    if (s->size + 1 == s->cap) {
+      s->cap *= 2;
+      s->data = safeRealloc(s->data, s->cap);
+    }
+    s->data[s->size++] = c;
+    c = readerChar(R);
+  }
+  s->data[s->size] = '\0';
+  return true;
+}
+
+//===================================================================
+// Builds the index file for the text on stdin
+int buildIndex(char const *path) {
+  
+  READ_STRING(text, EOF);
+  saIndex *sa = buildSuffixArray(text);
+  saIndex *lcp = buildLCPArray(text, sa);
+  saIndex *lcpLR = buildLcpLRArray(lcp, strLen(text));
+  bool ok = writeSaFile(path, text, sa, lcp, lcpLR);
   
+  free(sa);
+  free(lcp);
+  free(lcpLR);
+  freeString(text);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//===================================================================
+// Answers the patterns on stdin, one per line, using the index file
+int queryIndex(char const *path) {
+
+  saFile *F = openSaFile(path);
+  if (! F) 
+    return EXIT_FAILURE;
+
+  string *pattern = newString(100);
+  while (readLine(stdinReader(), pattern))
+    matcher(pattern, &F->text, F->sa, F->lcp, F->lcpLR);
+  
+  freeString(pattern);
+  closeSaFile(F);
+  return EXIT_SUCCESS;
+}
+
+//===================================================================
+
+int main(int argc, char *argv[]) {
+  
+  if (argc == 3 && strcmp(argv[1], "-b") == 0) 
+    return buildIndex(argv[2]);
+  if (argc == 3 && strcmp(argv[1], "-q") == 0) 
+    return queryIndex(argv[2]);
+  if (argc != 1) {
+    fprintf(stderr, "Usage: %s [-b index | -q index]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
   READ_STRING(pattern, '\n');
   READ_STRING(text, EOF);
 
-    // build suffix array and LCP array
-  size_t *sa = buildSuffixArray(text); 
-  size_t *lcp = buildLCPArray(text, sa); 
+    // build suffix array, LCP array and LCP-LR array
+  saIndex *sa = buildSuffixArray(text); 
+  saIndex *lcp = buildLCPArray(text, sa); 
+  saIndex *lcpLR = buildLcpLRArray(lcp, strLen(text));
 
     // find all occurences of pattern in text
-  matcher(pattern, text, sa, lcp);
+  matcher(pattern, text, sa, lcp, lcpLR);
 
     // compute longest repeated substring
   getLrs(text, sa, lcp);
@@ -302,6 +392,7 @@ int main() {
   
   free(sa);
   free(lcp);
+  free(lcpLR);
   freeString(pattern);
   freeString(text);
   return 0;
@@ -0,0 +1,375 @@
+/* 
+  file: suffix.c
+  author: David De Potter
+  email: pl3onasm@gmail.com
+  license: MIT, see LICENSE file in repository root folder
+  description: suffix array construction with SA-IS, LCP arrays,
+    and pattern search on a suffix array
+  assumption: Σ is the extended ASCII alphabet (256 characters)
+*/
+
+#include "suffix.h"
+
+  // marks an empty slot of the suffix array during construction
+#define EMPTY ((saIndex) -1)
+
+  // The type of each suffix is stored as a single bit: 1 if it is 
+  // an S-type suffix (smaller than the suffix that follows it), and 
+  // 0 if it is an L-type suffix (larger than the one that follows)
+#define getType(t, i) (((t)[(i) >> 3] >> ((i) & 7)) & 1)
+#define setType(t, i) ((t)[(i) >> 3] |= 1 << ((i) & 7))
+  // a leftmost S-type (LMS) suffix is an S-type suffix that is 
+  // preceded by an L-type suffix
+#define isLMS(t, i) ((i) > 0 && getType(t, i) && ! getType(t, (i) - 1))
+
+  // The string whose suffixes are sorted at some level of the 
+  // recursion; at the top level, this is the text, where each 
+  // character c is shifted to c + 1 and followed by a virtual 
+  // sentinel 0, and at the lower levels, it is an array of names
+  // that already ends with a unique smallest name 0
+typedef struct {
+  unsigned char *text;    // text at the top level, else NULL
+  saIndex *names;         // names at the lower levels
+  size_t n;               // length, including the sentinel
+  size_t sigma;           // alphabet size
+} saString;
+
+//===================================================================
+// Returns the i-th character of s
+static inline size_t chr(saString *s, size_t i) {
+  if (s->text)
+    return i + 1 < s->n ? s->text[i] + 1 : 0;
+  return s->names[i];
+}
+
+//===================================================================
+// Computes the start (or end if end is true) of each bucket in sa,
+// where a bucket holds all suffixes starting with the same character
+static void getBuckets(saString *s, saIndex *bkt, bool end) {
+  memset(bkt, 0, s->sigma * sizeof(saIndex));
+  for (size_t i = 0; i < s->n; i++)
+    bkt[chr(s, i)]++;
+  size_t sum = 0;
+  for (size_t c = 0; c < s->sigma; c++) {
+    sum += bkt[c];
+    bkt[c] = end ? sum : sum - bkt[c];
+  }
+}
+
+//===================================================================
+// Induces the order of the L-type suffixes from the suffixes that
+// are already in sa, by scanning sa from left to right
+static void induceL(saString *s, unsigned char *t, saIndex *sa, 
+                    saIndex *bkt) {
+  getBuckets(s, bkt, false);
+  for (size_t i = 0; i < s->n; i++) {
+    if (sa[i] == EMPTY || sa[i] == 0) 
+      continue;
+    size_t j = sa[i] - 1;
+    if (! getType(t, j))
+      sa[bkt[chr(s, j)]++] = j;
+  }
+}
+
+//===================================================================
+// Induces the order of the S-type suffixes from the L-type suffixes
+// in sa, by scanning sa from right to left
+static void induceS(saString *s, unsigned char *t, saIndex *sa, 
+                    saIndex *bkt) {
+  getBuckets(s, bkt, true);
+  for (size_t i = s->n; i--; ) {
+    if (sa[i] == EMPTY || sa[i] == 0) 
+      continue;
+    size_t j = sa[i] - 1;
+    if (getType(t, j))
+      sa[--bkt[chr(s, j)]] = j;
+  }
+}
+
+//===================================================================
+// Returns true if the LMS substrings starting at a and b are equal,
+// i.e. if they have the same characters and types up to and 
+// including the next LMS position
+static bool equalLMS(saString *s, unsigned char *t, size_t a, 
+                     size_t b) {
+  for (size_t d = 0; ; d++) {
+    if (chr(s, a + d) != chr(s, b + d) || 
+        getType(t, a + d) != getType(t, b + d))
+      return false;
+    if (d > 0 && (isLMS(t, a + d) || isLMS(t, b + d)))
+      return true;
+  }
+}
+
+//===================================================================
+// Sorts the suffixes of s into sa using the SA-IS algorithm by
+// Nong, Zhang and Chan: the LMS substrings are sorted by induced 
+// sorting and given names, the LMS suffixes are sorted by recursing
+// on the string of names if these are not unique, and finally all
+// suffixes are induced from the sorted LMS suffixes
+static void sais(saString *s, saIndex *sa) {
+
+  size_t n = s->n, n1 = 0, name = 0;
+  unsigned char *t = safeCalloc(n / 8 + 1, sizeof(unsigned char));
+  saIndex *bkt = safeCalloc(s->sigma, sizeof(saIndex));
+
+    // classify the suffixes; the sentinel is S-type and the suffix
+    // preceding it L-type, as the sentinel is the unique smallest 
+  setType(t, n - 1);
+  for (size_t i = n - 1; i--; ) 
+    if (chr(s, i) < chr(s, i + 1) || (chr(s, i) == chr(s, i + 1) 
+        && getType(t, i + 1)))
+      setType(t, i);
+
+    // STAGE 1: sort the LMS substrings
+    // put the LMS suffixes at the ends of their buckets, 
+    // and induce the order of the other suffixes from them
+  getBuckets(s, bkt, true);
+  for (size_t i = 0; i < n; i++) 
+    sa[i] = EMPTY;
+  for (size_t i = 1; i < n; i++) 
+    if (isLMS(t, i)) 
+      sa[--bkt[chr(s, i)]] = i;
+  induceL(s, t, sa, bkt);
+  induceS(s, t, sa, bkt);
+
+    // move the sorted LMS substrings to the first n1 slots of sa
+  for (size_t i = 0; i < n; i++) 
+    if (isLMS(t, sa[i])) 
+      sa[n1++] = sa[i];
+
+    // name the LMS substrings in sorted order, giving equal
+    // substrings the same name; as no two LMS positions are 
+    // adjacent, the name of position p can be stored at n1 + p/2
+  for (size_t i = n1; i < n; i++) 
+    sa[i] = EMPTY;
+  for (size_t i = 0, prev = 0; i < n1; i++) {
+    size_t pos = sa[i];
+    if (i == 0 || ! equalLMS(s, t, pos, prev)) 
+      name++;
+    prev = pos;
+    sa[n1 + pos / 2] = name - 1;
+  }
+    // collect the names in text order at the end of sa
+  for (size_t i = n, j = n; i-- > n1; )
+    if (sa[i] != EMPTY) 
+      sa[--j] = sa[i];
+
+    // STAGE 2: sort the LMS suffixes, using the first n1 slots of 
+    // sa as the suffix array of the string of names s1, which 
+    // occupies the last n1 slots
+  saIndex *sa1 = sa, *s1 = sa + n - n1;
+  if (name < n1) {
+      // names are not unique: sort the suffixes of s1 recursively
+    saString sub = { NULL, s1, n1, name };
+    sais(&sub, sa1);
+  } else 
+      // all names are unique: s1 directly yields the order
+    for (size_t i = 0; i < n1; i++) 
+      sa1[s1[i]] = i;
+
+    // STAGE 3: induce the order of all suffixes from the sorted 
+    // LMS suffixes; first map the ranks in sa1 back to positions
+  for (size_t i = 1, j = 0; i < n; i++) 
+    if (isLMS(t, i)) 
+      s1[j++] = i;
+  for (size_t i = 0; i < n1; i++) 
+    sa1[i] = s1[sa1[i]];
+  for (size_t i = n1; i < n; i++) 
+    sa[i] = EMPTY;
+    // put the sorted LMS suffixes at the ends of their buckets,
+    // starting with the largest one
+  getBuckets(s, bkt, true);
+  for (size_t i = n1; i--; ) {
+    size_t j = sa[i];
+    sa[i] = EMPTY;
+    sa[--bkt[chr(s, j)]] = j;
+  }
+  induceL(s, t, sa, bkt);
+  induceS(s, t, sa, bkt);
+
+  free(t);
+  free(bkt);
+}
+
+//===================================================================
+// Builds a suffix array for text of length n in O(n) time
+saIndex *buildSuffixArray(string *text) {
+
+  size_t n = strLen(text);
+  if (n >= (size_t) EMPTY - 1) {
+    fprintf(stderr, "Text too long for the suffix array index "
+                    "type; compile with -D SA_INDEX64\n");
+    exit(EXIT_FAILURE);
+  }
+  
+    // sort the suffixes of the text followed by a sentinel, which 
+    // ends up in the first slot of sa, and remove the sentinel
+  saIndex *sa = safeCalloc(n + 1, sizeof(saIndex));
+  saString s = { str(text), NULL, n + 1, 257 };
+  sais(&s, sa);
+  memmove(sa, sa + 1, n * sizeof(saIndex));
+  return sa;
+}
+
+//===================================================================
+// Builds a longest common prefix array for given text and its 
+// suffix array in O(n) time
+saIndex *buildLCPArray(string *text, saIndex *sa) {
+  
+  size_t n = strLen(text);
+  saIndex *lcp = safeCalloc(n, sizeof(saIndex));
+  saIndex *ranks = safeCalloc(n, sizeof(saIndex));
+
+    // compute suffix ranks; this is the inverse of sa
+    // ranks[i] = sorted index of suffix at text index i
+  for (size_t i = 0; i < n; i++) 
+    ranks[sa[i]] = i; 
+
+    // lcp of first suffix is 0 
+  lcp[0] = 0;         
+    // length of longest common prefix
+  size_t len = 0;     
+    // iterate over all suffixes in text order
+  for (size_t i = 0; i < n; i++) { 
+    if (ranks[i] == 0) 
+      continue;       
+      // get text index j of the lexicographically preceding suffix
+    size_t j = sa[ranks[i] - 1];      
+      // compute lcp of suffixes at text indices i and j
+    while (i + len < n && j + len < n 
+           && charAt(text, i + len) == charAt(text, j + len)) 
+      len++;  
+      // store lcp of suffix at sorted index ranks[i]
+    lcp[ranks[i]] = len; 
+      // lcp of next suffix is at least one less 
+      // than current lcp if len > 0, otherwise it is 0
+    if (len > 0)
+      len--;  
+  }
+  free(ranks);
+  return lcp;
+}
+
+//===================================================================
+// Fills in the LCP-LR entries of the search interval [l, r] and of
+// all intervals below it, and returns the LCP of the suffixes at 
+// sorted indices l and r, which is the minimum of lcp[l+1..r]
+static saIndex fillLcpLR(saIndex *lcp, saIndex *lcpLR, size_t l, 
+                         size_t r) {
+  if (r - l == 1) 
+    return lcp[r];
+  size_t mid = l + (r - l) / 2;
+  lcpLR[2 * mid] = fillLcpLR(lcp, lcpLR, l, mid);
+  lcpLR[2 * mid + 1] = fillLcpLR(lcp, lcpLR, mid, r);
+  return MIN(lcpLR[2 * mid], lcpLR[2 * mid + 1]);
+}
+
+//===================================================================
+// Builds the LCP-LR array for a suffix array of n suffixes with the
+// given LCP array in O(n) time: each index mid strictly between 0 
+// and n - 1 is the midpoint of exactly one interval [l, r] of the
+// binary search in findPattern, and lcpLR[2mid] and lcpLR[2mid+1] 
+// hold the LCP of the suffix at mid with those at l and r
+saIndex *buildLcpLRArray(saIndex *lcp, size_t n) {
+
+  saIndex *lcpLR = safeCalloc(2 * MAX(n, 1), sizeof(saIndex));
+  if (n > 1)
+    fillLcpLR(lcp, lcpLR, 0, n - 1);
+  return lcpLR;
+}
+
+//===================================================================
+// Extends the common prefix of the pattern and the suffix at text 
+// index i beyond its known length j, and returns true if the 
+// pattern is at most the suffix, i.e. a prefix of it or smaller at
+// the first mismatch; a suffix that ends is smaller than any 
+// character
+static inline bool atMost(string *pattern, string *text, size_t i,
+                          size_t *j) {
+  size_t m = strLen(pattern), n = strLen(text);
+  while (*j < m && i + *j < n 
+         && charAt(text, i + *j) == charAt(pattern, *j))
+    (*j)++;
+  return *j == m || (i + *j < n 
+                     && charAt(text, i + *j) > charAt(pattern, *j));
+}
+
+//===================================================================
+// Searches the range [start, end] of suffixes in sa that begin with
+// pattern and returns true if it is not empty. The binary search 
+// keeps the invariant suffix(l) < pattern <= suffix(r), along with
+// the lengths L and R of the common prefixes of the pattern with 
+// these two suffixes. If L >= R, the LCP of the suffixes at l and 
+// mid decides the comparison at mid whenever it differs from L: if
+// it is larger, suffix(mid) agrees with suffix(l) beyond position L
+// and is therefore smaller than the pattern; if it is smaller, 
+// suffix(mid) already exceeds suffix(l) where the pattern still 
+// agrees with the latter. The case R > L is symmetric. Only if the
+// LCP equals the larger of L and R are characters compared, 
+// starting from there, so that max(L, R) never decreases and each
+// character of the pattern is matched at most once. The end of the
+// range is then found by extending it as long as the LCP with the
+// previous suffix is at least the pattern length
+// Time complexity: O(m + logn + occ)
+bool findPattern(string *pattern, string *text, saIndex *sa, 
+                 saIndex *lcp, saIndex *lcpLR, size_t *start, 
+                 size_t *end) {
+  
+  size_t m = strLen(pattern), n = strLen(text);
+  if (n == 0)
+    return false;
+
+    // find the first suffix that is not smaller than the pattern, 
+    // after checking the first and last suffixes
+  size_t l = 0, r = n - 1, L = 0, R = 0, lo;
+  if (atMost(pattern, text, sa[0], &L)) {
+    lo = 0;
+    R = L;
+  } else if (! atMost(pattern, text, sa[n - 1], &R)) 
+    return false;
+  else {
+    while (r - l > 1) {
+      size_t mid = l + (r - l) / 2, j;
+      if (L >= R) {
+        j = lcpLR[2 * mid];
+        if (j > L) {
+          l = mid;
+          continue;
+        }
+        if (j < L) {
+          r = mid;
+          R = j;
+          continue;
+        }
+      } else {
+        j = lcpLR[2 * mid + 1];
+        if (j > R) {
+          r = mid;
+          continue;
+        }
+        if (j < R) {
+          l = mid;
+          L = j;
+          continue;
+        }
+      }
+      if (atMost(pattern, text, sa[mid], &j)) {
+        r = mid;
+        R = j;
+      } else {
+        l = mid;
+        L = j;
+      }
+    }
+    lo = r;
+  }
+    // the pattern occurs if it is a prefix of this suffix
+  if (R < m) 
+    return false;
+
+  *start = *end = lo;
+  while (*end + 1 < n && lcp[*end + 1] >= m) 
+    (*end)++;
+  return true;
+}
@@ -0,0 +1,38 @@
+#ifndef SUFFIX_H_INCLUDED
+#define SUFFIX_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../../../../lib/clib.h"
+
+  // The suffix and LCP arrays use 32-bit indices by default, which
+  // halves their size compared to size_t and suffices for texts
+  // shorter than 4 GiB; compile with -D SA_INDEX64 for larger texts
+#ifdef SA_INDEX64
+typedef size_t saIndex;
+#else
+typedef uint32_t saIndex;
+#endif
+
+  // Builds a suffix array for text of length n in O(n) time,
+  // using the SA-IS algorithm
+saIndex *buildSuffixArray(string *text);
+
+  // Builds a longest common prefix array for given text and its 
+  // suffix array in O(n) time
+saIndex *buildLCPArray(string *text, saIndex *sa);
+
+  // Builds the LCP-LR array of 2n entries for the binary search in
+  // findPattern from the LCP array of n suffixes in O(n) time
+saIndex *buildLcpLRArray(saIndex *lcp, size_t n);
+
+  // Searches the range [start, end] of suffixes in sa that begin 
+  // with pattern, using the LCP-LR array to compare each character
+  // of the pattern at most once; O(m + logn + occ) time. Returns 
+  // false if there are no such suffixes
+bool findPattern(string *pattern, string *text, saIndex *sa, 
+                 saIndex *lcp, saIndex *lcpLR, size_t *start, 
+                 size_t *end);
+
+#endif // SUFFIX_H_INCLUDED
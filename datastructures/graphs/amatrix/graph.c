@@ -494,27 +494,26 @@ void addVandE(graph *G, char *from, char *to) {
 void readGraph(graph *G) {
   char from[MAX_VERTEX_LABEL], to[MAX_VERTEX_LABEL];
   double weight = 1;
+  reader *R = stdinReader();
 
     // check if the graph is set to undirected
-  if (scanf ("%s", from) == 1 && 
+  if (readerToken(R, from, MAX_VERTEX_LABEL) && 
      (cmpStrCI(from, "undirected") == 0)) {
     setUndirected(G);
   } else {
     // add the first edge
-    if (G->weight == UNWEIGHTED)
-      assert(scanf("%s", to) == 1);
-    else 
-      assert(scanf("%s %lf", to, &weight) == 2);
+    assert(readerToken(R, to, MAX_VERTEX_LABEL) > 0);
+    if (G->weight == WEIGHTED)
+      assert(readerDouble(R, &weight));
     addVandEW(G, from, to, weight);
   } 
   
     // read the rest of the graph
-  if (G->weight == UNWEIGHTED) {
-    while (scanf("%s %s", from, to) == 2) 
-      addVandEW(G, from, to, 1);
-  } else {
-    while (scanf("%s %s %lf", from, to, &weight) == 3) 
-      addVandEW(G, from, to, weight);
+  while (readerToken(R, from, MAX_VERTEX_LABEL) && 
+         readerToken(R, to, MAX_VERTEX_LABEL)) {
+    if (G->weight == WEIGHTED && ! readerDouble(R, &weight))
+      break;
+    addVandEW(G, from, to, weight);
   }
 }
 
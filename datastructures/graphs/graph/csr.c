@@ -0,0 +1,94 @@
+/*
+  Frozen compressed sparse row (CSR) view of a graph
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#include "csr.h"
+#include "../../../lib/clib.h"
+
+//=================================================================
+// Returns the slot of a vertex in the lookup table, which is a
+// hash table with linear probing whose size is a power of 2;
+// the address is hashed with Fibonacci hashing, after dropping
+// the low bits that are equal for all aligned vertices
+static size_t csrSlot(csrGraph *C, vertex *v) {
+  uint64_t h = (uint64_t)((uintptr_t)v >> 4) * 0x9E3779B97F4A7C15ULL;
+  size_t i = (size_t)(h >> 32) & C->mask;
+  while (C->lookup[i].v && C->lookup[i].v != v)
+    i = (i + 1) & C->mask;
+  return i;
+}
+
+//=================================================================
+// Builds a CSR view of the graph G
+csrGraph *graphFreeze(graph *G) {
+  if (! G)
+    return NULL;
+
+  csrGraph *C = safeCalloc(1, sizeof(csrGraph));
+  C->nV = nVertices(G);
+
+    // vertex ids follow the order of the labels
+  C->vertices = sortVertices(G);
+
+    // the ids are stored once in a table that is at most half
+    // full, so that each edge target is found in O(1) time
+  size_t cap = 2;
+  while (cap < 2 * C->nV)
+    cap <<= 1;
+  C->mask = cap - 1;
+  C->lookup = safeCalloc(cap, sizeof(csrPair));
+  for (size_t i = 0; i < C->nV; i++) {
+    csrPair *pair = C->lookup + csrSlot(C, C->vertices[i]);
+    pair->v = C->vertices[i];
+    pair->id = i;
+  }
+
+    // the offsets are the prefix sums of the out-degrees
+  dll **adj = safeCalloc(C->nV, sizeof(dll *));
+  C->offsets = safeCalloc(C->nV + 1, sizeof(size_t));
+  for (size_t i = 0; i < C->nV; i++) {
+    adj[i] = getNeighbors(G, C->vertices[i]);
+    C->offsets[i + 1] = C->offsets[i] + 
+                        (adj[i] ? dllSize(adj[i]) : 0);
+  }
+  C->nE = C->offsets[C->nV];
+
+    // copy the adjacency lists into the flat arrays
+  C->targets = safeCalloc(C->nE, sizeof(size_t));
+  C->weights = safeCalloc(C->nE, sizeof(double));
+  for (size_t i = 0; i < C->nV; i++) {
+    size_t pos = C->offsets[i];
+    if (! adj[i])
+      continue;
+    for (edge *e = dllFirst(adj[i]); e; e = dllNext(adj[i])) {
+      C->targets[pos] = csrId(C, e->to);
+      C->weights[pos++] = e->weight;
+    }
+  }
+  free(adj);
+  return C;
+}
+
+//=================================================================
+// Deallocates the CSR view
+void csrFree(csrGraph *C) {
+  if (! C)
+    return;
+  free(C->offsets);
+  free(C->targets);
+  free(C->weights);
+  free(C->vertices);
+  free(C->lookup);
+  free(C);
+}
+
+//=================================================================
+// Returns the id of a vertex, or SIZE_MAX if not found
+size_t csrId(csrGraph *C, vertex *v) {
+  if (! C || ! v)
+    return SIZE_MAX;
+  csrPair *pair = C->lookup + csrSlot(C, v);
+  return pair->v ? pair->id : SIZE_MAX;
+}
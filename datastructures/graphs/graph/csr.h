@@ -0,0 +1,73 @@
+/*
+  Frozen compressed sparse row (CSR) view of a graph
+  Description:
+    A CSR view is a read-only snapshot of a graph G = (V, E)
+    in which the vertices are numbered 0..n-1 in the order
+    of their labels, and the adjacency lists are stored one
+    after the other in contiguous arrays: the out-edges of
+    vertex u are found at the positions offsets[u] up to
+    (but not including) offsets[u + 1] in the targets and
+    weights arrays. Scanning the edges of a vertex is thus
+    a linear walk over an array instead of following the
+    pointers of a linked list.
+    The view does not follow later changes to the graph,
+    and should be rebuilt if the graph is modified.
+  Author: David De Potter
+  LICENSE: MIT, see LICENSE file in repository root folder
+*/
+
+#ifndef CSR_H_INCLUDED
+#define CSR_H_INCLUDED
+
+#include "graph.h"
+
+  // vertex to id pair, used for id lookup
+typedef struct {
+  vertex *v;
+  size_t id;
+} csrPair;
+
+  // CSR view of a graph
+typedef struct {
+  size_t nV;          // number of vertices
+  size_t nE;          // number of (directed) edges
+  size_t *offsets;    // nV + 1 offsets into targets/weights
+  size_t *targets;    // destination vertex ids
+  double *weights;    // edge weights
+  vertex **vertices;  // maps vertex ids to vertices of G
+  csrPair *lookup;    // hash table of vertex -> id pairs
+  size_t mask;        // size of the lookup table minus 1
+} csrGraph;
+
+  // Builds a CSR view of the graph G; in an undirected
+  // graph, each edge is stored in both directions
+csrGraph *graphFreeze(graph *G);
+
+  // Deallocates the CSR view; the graph is not affected
+void csrFree(csrGraph *C);
+
+  // Returns the id of a vertex of the frozen graph,
+  // or SIZE_MAX if the vertex is not in the view
+size_t csrId(csrGraph *C, vertex *v);
+
+  // Returns the number of vertices in the view
+static inline size_t csrNVertices(csrGraph *C) {
+  return C->nV;
+}
+
+  // Returns the number of edges in the view
+static inline size_t csrNEdges(csrGraph *C) {
+  return C->nE;
+}
+
+  // Returns the vertex with the given id
+static inline vertex *csrVertex(csrGraph *C, size_t id) {
+  return C->vertices[id];
+}
+
+  // Returns the out-degree of the vertex with the given id
+static inline size_t csrOutDegree(csrGraph *C, size_t id) {
+  return C->offsets[id + 1] - C->offsets[id];
+}
+
+#endif // CSR_H_INCLUDED
@@ -52,8 +52,9 @@ void showStr(void const *key) {
 
 //=================================================================
 // Creates a new graph node
-vertex *newVertex(char *label) {
-  vertex *v = safeCalloc(1, sizeof(vertex));
+vertex *newVertex(graph *G, char *label) {
+  vertex *v = G->pool ? poolAlloc(G->pool, sizeof(vertex)) 
+                      : safeCalloc(1, sizeof(vertex));
   strcpy(v->label, label);
   return v;
 }
@@ -69,8 +70,9 @@ void freeVertex(void *v) {
 //=================================================================
 // Creates a new edge, from -> to
 // An edge is the value of a key (vertex) in the hash table
-edge *newEdge(vertex *to, double weight) {
-  edge *e = safeCalloc(1, sizeof(edge));
+edge *newEdge(graph *G, vertex *to, double weight) {
+  edge *e = G->pool ? poolAlloc(G->pool, sizeof(edge)) 
+                    : safeCalloc(1, sizeof(edge));
   e->to = to;
   e->weight = weight;
   return e;
@@ -202,7 +204,14 @@ graph *newGraph (size_t capacity, weightType weight) {
 void freeGraph(graph *G) {
   if (! G) 
     return;
-  htFree(G->V);
+  if (G->pool) {
+      // all vertices, edges, entries and lists are in the 
+      // pool, so only the bucket array is left to free
+    free(G->V->buckets);
+    free(G->V);
+    poolFree(G->pool);
+  } else 
+    htFree(G->V);
   free(G->u);
   free(G->v);
   free(G->e);
@@ -217,6 +226,18 @@ void setUndirected(graph *G) {
   G->type = UNDIRECTED;
 }
 
+//=================================================================
+// Makes the graph allocate from its own pool
+void usePool(graph *G) {
+  if (! G || G->pool) 
+    return;
+  G->pool = poolNew();
+  htUsePool(G->V, G->pool);
+    // vertices and edges are reclaimed with the pool
+  htOwnKeys(G->V, NULL);
+  htOwnVals(G->V, NULL);
+}
+
 //=================================================================
 // Gets a vertex given its label
 vertex *getVertex(graph *G, char *label) {
@@ -236,7 +257,7 @@ void addVertex(graph *G, char *label) {
   strcpy(G->v->label, label);
   if (htHasKey(G->V, G->v))
     return;
-  vertex *vertex = newVertex(label);
+  vertex *vertex = newVertex(G, label);
   htAddKey(G->V, vertex);
 }
 
@@ -247,7 +268,7 @@ vertex *addVertexR(graph *G, char *label) {
   vertex *v = htGetKey(G->V, G->v);
   if (v) 
     return v;
-  vertex *vertex = newVertex(label);
+  vertex *vertex = newVertex(G, label);
   htAddKey(G->V, vertex);
   return vertex;
 }
@@ -264,12 +285,12 @@ void addEdgeW(graph *G, vertex *from, vertex *to, double weight) {
   if (htHasKeyVal(G->V, from, G->e)) 
     return;
 
-  edge *e = newEdge(to, weight);
+  edge *e = newEdge(G, to, weight);
   htAddKeyVal(G->V, from, e);
   to->inDegree++;
 
   if (G->type == UNDIRECTED) {
-    edge *rev = newEdge(from, weight);
+    edge *rev = newEdge(G, from, weight);
     htAddKeyVal(G->V, to, rev);
     from->inDegree++;
     #ifdef EDGE_TYPE3
@@ -492,27 +513,26 @@ void addVandE(graph *G, char *from, char *to) {
 void readGraph(graph *G) {
   char from[MAX_LABEL], to[MAX_LABEL];
   double weight = 1;
+  reader *R = stdinReader();
 
     // check if the graph is set to undirected
-  if (scanf ("%s", from) == 1 && 
+  if (readerToken(R, from, MAX_LABEL) && 
      (cmpStrCI(from, "undirected") == 0)) {
     setUndirected(G);
   } else {
     // add the first edge
-    if (G->weight == UNWEIGHTED)
-      assert(scanf("%s", to) == 1);
-    else 
-      assert(scanf("%s %lf", to, &weight) == 2);
+    assert(readerToken(R, to, MAX_LABEL) > 0);
+    if (G->weight == WEIGHTED)
+      assert(readerDouble(R, &weight));
     addVandEW(G, from, to, weight);
   } 
   
     // read the rest of the graph
-  if (G->weight == UNWEIGHTED) {
-    while (scanf("%s %s", from, to) == 2) 
-      addVandEW(G, from, to, 1);
-  } else {
-    while (scanf("%s %s %lf", from, to, &weight) == 3) 
-      addVandEW(G, from, to, weight);
+  while (readerToken(R, from, MAX_LABEL) && 
+         readerToken(R, to, MAX_LABEL)) {
+    if (G->weight == WEIGHTED && ! readerDouble(R, &weight))
+      break;
+    addVandEW(G, from, to, weight);
   }
 }
 
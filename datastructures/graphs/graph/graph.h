@@ -39,6 +39,8 @@ typedef struct {
   vertex *u;          // dummy vertex for lookup
   vertex *v;          // dummy vertex for lookup  
   vertex *z;          // dummy vertex for iteration
+  struct pool *pool;  // pool for vertices, edges and lists,
+                      // if set by usePool
 } graph;
 
 
@@ -51,6 +53,12 @@ graph *newGraph (size_t capacity, weightType weight);
   // Should be called before adding any edges
 void setUndirected(graph *G);
 
+  // Makes the graph take its vertices, edges and internal
+  // list nodes from a pool owned by the graph, so that 
+  // freeGraph releases them all at once
+  // Should be called before adding any vertices
+void usePool(graph *G);
+
   // Deallocates the graph
 void freeGraph(graph *G);
 
@@ -0,0 +1,97 @@
+/*
+  Benchmark of the graph allocation modes: one heap allocation
+    per vertex, edge and list node (default) versus a pool
+    owned by the graph (usePool)
+  For each size, a random directed graph is built and freed
+    in both modes; the number of heap allocations and the
+    times to build and to free the graph are shown. The heap
+    allocations are counted by wrapping malloc, calloc and 
+    realloc at link time (see the makefile), so that the library
+    itself is not instrumented
+  Usage: ./graphBench.out [maxVertices] [avgDegree]
+  Author: David De Potter
+*/
+
+#include "../graph.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+  // number of calls to malloc, calloc and realloc so far
+static size_t allocCount = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+//===================================================================
+// counting wrappers, which the linker substitutes for the calls
+// to malloc, calloc and realloc in all objects of the benchmark
+void *__wrap_malloc(size_t size) {
+  allocCount++;
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  allocCount++;
+  return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  allocCount++;
+  return __real_realloc(ptr, size);
+}
+
+//===================================================================
+// returns the elapsed time in seconds since start
+double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+// builds and frees a random graph with n vertices and about
+// n * deg edges, and shows the results
+void bench(size_t n, size_t deg, bool pooled) {
+  char label[50];
+
+  size_t allocs = allocCount;
+  clock_t start = clock();
+  graph *G = newGraph(n, WEIGHTED);
+  if (pooled)
+    usePool(G);
+    // seeded after newGraph, since the hash table seeds rand
+  srand(42);
+  vertex **V = safeCalloc(n, sizeof(vertex *));
+  for (size_t i = 0; i < n; i++) {
+    sprintf(label, "v%zu", i);
+    V[i] = addVertexR(G, label);
+  }
+  for (size_t i = 0; i < n * deg; i++)
+    addEdgeW(G, V[i / deg], V[rand() % n], 1 + rand() % 100);
+  double tBuild = elapsed(start);
+  allocs = allocCount - allocs;
+  size_t m = nEdges(G);
+
+  start = clock();
+  freeGraph(G);
+  double tFree = elapsed(start);
+  free(V);
+
+  printf("%10zu  %10zu  %-8s  %12zu  %9.3fs  %9.3fs\n", n, m,
+         pooled ? "pool" : "malloc", allocs, tBuild, tFree);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  size_t maxN = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+  size_t deg = argc > 2 ? strtoul(argv[2], NULL, 10) : 8;
+
+  printf("%10s  %10s  %-8s  %12s  %10s  %10s\n", "vertices",
+         "edges", "mode", "allocations", "build", "free");
+
+  for (size_t n = 1000; n <= maxN; n *= 10) {
+    bench(n, deg, false);
+    bench(n, deg, true);
+  }
+  return 0;
+}
@@ -0,0 +1,91 @@
+/*
+  Benchmark of the buffered reader of clib versus scanf
+  A weighted edge list with the given number of edges is
+    written to a temporary file, which is then parsed with
+    fscanf("%s %s %lf") and with a reader, and the results
+    are compared
+  In graph mode, a weighted graph is loaded from stdin
+    by readGraph, which uses the reader on stdin
+  Usage: ./readBench.out [nEdges]
+         ./readBench.out graph < edgelist.txt
+  Author: David De Potter
+*/
+
+#include "../graph.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// returns the elapsed time in seconds since start
+double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  if (argc > 1 && strcmp(argv[1], "graph") == 0) {
+    clock_t start = clock();
+    graph *G = newGraph(1000, WEIGHTED);
+    readGraph(G);
+    printf("Loaded %zu vertices and %zu edges in %.3lfs\n",
+           nVertices(G), nEdges(G), elapsed(start));
+    freeGraph(G);
+    return 0;
+  }
+
+  size_t m = argc > 1 ? strtoul(argv[1], NULL, 10) : 5000000;
+  size_t n = m / 8 + 1;
+  char from[50], to[50];
+  double weight;
+  srand(42);
+
+    // generate the edge list
+  FILE *file = tmpfile();
+  if (! file) {
+    fprintf(stderr, "Could not create a temporary file\n");
+    return 1;
+  }
+  for (size_t i = 0; i < m; i++)
+    fprintf(file, "v%zu v%zu %.2lf\n", (size_t)rand() % n,
+            (size_t)rand() % n, (rand() % 10000) / 100.0);
+  long size = ftell(file);
+  printf("Edge list: %zu edges, %.1lf MB\n\n", m, size / 1e6);
+
+    // parse with fscanf
+  rewind(file);
+  double sum1 = 0;
+  size_t cnt1 = 0;
+  clock_t start = clock();
+  while (fscanf(file, "%s %s %lf", from, to, &weight) == 3) {
+    sum1 += weight + from[1] + to[1];
+    cnt1++;
+  }
+  double t1 = elapsed(start);
+
+    // parse with a reader
+  rewind(file);
+  double sum2 = 0;
+  size_t cnt2 = 0;
+  start = clock();
+  reader *R = readerNew(file, 0);
+  while (readerToken(R, from, 50) && readerToken(R, to, 50) &&
+         readerDouble(R, &weight)) {
+    sum2 += weight + from[1] + to[1];
+    cnt2++;
+  }
+  readerFree(R);
+  double t2 = elapsed(start);
+
+  if (cnt1 != cnt2 || sum1 != sum2)
+    fprintf(stderr, "Parsed edge lists differ\n");
+
+  printf("%-10s  %9s  %10s\n", "parser", "time", "MB/s");
+  printf("%-10s  %8.3lfs  %10.1lf\n", "fscanf", t1,
+         t1 > 0 ? size / t1 / 1e6 : 0);
+  printf("%-10s  %8.3lfs  %10.1lf\n", "reader", t2,
+         t2 > 0 ? size / t2 / 1e6 : 0);
+
+  fclose(file);
+  return 0;
+}
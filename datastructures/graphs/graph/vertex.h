@@ -49,6 +49,7 @@
     double dist;              // distance from the source vertex
     char label[MAX_LABEL];    // the label of the vertex
     size_t inDegree;          // in-degree of the vertex
+    size_t pqIdx;             // index in a slot-based priority queue
   } vertex;
 
 //===================================================================
@@ -52,8 +52,9 @@ void showStr(void const *key) {
 
 //=================================================================
 // Creates a new network node
-vertex *newVertex(char *label) {
-  vertex *v = safeCalloc(1, sizeof(vertex));
+vertex *newVertex(network *N, char *label) {
+  vertex *v = N->pool ? poolAlloc(N->pool, sizeof(vertex)) 
+                      : safeCalloc(1, sizeof(vertex));
   strcpy(v->label, label);
   return v;
 }
@@ -69,9 +70,10 @@ void freeVertex(void *v) {
 //=================================================================
 // Creates a new edge, from -> to
 // An edge is the value of a key (vertex) in the hash table
-edge *newEdge(vertex *from, vertex *to, size_t cap, 
+edge *newEdge(network *N, vertex *from, vertex *to, size_t cap, 
               double weight, bool residual) {
-  edge *e = safeCalloc(1, sizeof(edge));
+  edge *e = N->pool ? poolAlloc(N->pool, sizeof(edge)) 
+                    : safeCalloc(1, sizeof(edge));
   e->from = from;
   e->to = to;
   e->cap = cap;
@@ -239,13 +241,32 @@ network *newNetwork (size_t capacity, weightType wType) {
 void freeNetwork(network *N) {
   if (! N) 
     return;
-  htFree(N->V);
+  if (N->pool) {
+      // all vertices, edges, entries and lists are in the 
+      // pool, so only the bucket array is left to free
+    free(N->V->buckets);
+    free(N->V);
+    poolFree(N->pool);
+  } else 
+    htFree(N->V);
   free(N->u);
   free(N->v);
   free(N->e);
   free(N);
 }
 
+//=================================================================
+// Makes the network allocate from its own pool
+void usePool(network *N) {
+  if (! N || N->pool) 
+    return;
+  N->pool = poolNew();
+  htUsePool(N->V, N->pool);
+    // vertices and edges are reclaimed with the pool
+  htOwnKeys(N->V, NULL);
+  htOwnVals(N->V, NULL);
+}
+
 //=================================================================
 // Gets a vertex given its label
 vertex *getVertex(network *N, char *label) {
@@ -265,7 +286,7 @@ void addVertex(network *N, char *label) {
   strcpy(N->v->label, label);
   if (htHasKey(N->V, N->v))
     return;
-  vertex *vertex = newVertex(label);
+  vertex *vertex = newVertex(N, label);
   htAddKey(N->V, vertex);
 }
 
@@ -277,7 +298,7 @@ vertex *addVertexR(network *N, char *label) {
   vertex *v = htGetKey(N->V, N->v);
   if (v) 
     return v;
-  vertex *vertex = newVertex(label);
+  vertex *vertex = newVertex(N, label);
   htAddKey(N->V, vertex);
   return vertex;
 }
@@ -321,11 +342,11 @@ void addEdgeW(network *N, vertex *from, vertex *to,
 
   if (e) return;
 
-  e = newEdge(from, to, cap, weight, false);
+  e = newEdge(N, from, to, cap, weight, false);
   htAddKeyVal(N->V, from, e);
   to->inDegree++;
     // add the residual edge
-  edge *r = newEdge(to, from, 0, -weight, true);
+  edge *r = newEdge(N, to, from, 0, -weight, true);
   htAddKeyVal(N->V, to, r);
     // since the last edge belongs to the residual network,
     // correct dll size for residual edge
@@ -529,39 +550,35 @@ void readNetwork(network *N) {
   if (! N) 
     return;
   
-  char from[MAX_LABEL], to[MAX_LABEL];
-  char input[4 * MAX_LABEL];
-  size_t capacity = 0;
-
-  if (N->weight == WEIGHTED) {
-    double weight;
-
-    while (fgets(input, sizeof(input), stdin)) {
-      size_t n = sscanf(input, "%s %s %lf %zu", 
-                        from, to, &weight, &capacity);
-      if (n == 4) 
-        addVandEW(N, from, to, capacity, weight);
-      else if (n == 3 && (strstr(input, "inf") 
-                      || strstr(input, "INF")))
-        addVandEW(N, from, to, SIZE_MAX, weight);
-      else if (n == 3)
-        addVandEW(N, from, to, 1, weight);
-      else 
-        break;
-    }
-  } else {
-    while (fgets(input, sizeof(input), stdin)) {
-      size_t n = sscanf(input, "%s %s %zu", from, to, &capacity);
-      if (n == 3) 
-        addVandE(N, from, to, capacity);
-      else if (n == 2 && (strstr(input, "inf") 
-                      || strstr(input, "INF")))
-        addVandE(N, from, to, SIZE_MAX);
-      else if (n == 2)
-        addVandE(N, from, to, 1);
-      else 
-        break;
+  char from[MAX_LABEL], to[MAX_LABEL], cap[MAX_LABEL];
+  double weight = 0;
+  reader *R = stdinReader();
+
+    // one edge per line: from, to, the weight if the network 
+    // is weighted, and an optional capacity (default 1), which
+    // may be "inf"; an empty or malformed line ends the input
+  while (! readerAtEol(R)) {
+    if (! readerToken(R, from, MAX_LABEL) || readerAtEol(R) ||
+        ! readerToken(R, to, MAX_LABEL))
+      break;
+    if (N->weight == WEIGHTED && 
+       (readerAtEol(R) || ! readerDouble(R, &weight)))
+      break;
+
+    size_t capacity = 1;
+    if (! readerAtEol(R) && readerToken(R, cap, MAX_LABEL)) {
+      if (strncmp(cap, "inf", 3) == 0 || 
+          strncmp(cap, "INF", 3) == 0)
+        capacity = SIZE_MAX;
+      else if (cap[0] >= '0' && cap[0] <= '9') 
+        capacity = strtoull(cap, NULL, 10);
     }
+    readerSkipLine(R);
+
+    if (N->weight == WEIGHTED)
+      addVandEW(N, from, to, capacity, weight);
+    else 
+      addVandE(N, from, to, capacity);
   }
 }
 
@@ -35,6 +35,8 @@ typedef struct {
   vertex *z;          // dummy vertex for iteration
   size_t maxCap;      // maximum edge capacity
   size_t maxFlow;     // maximum flow in the network
+  struct pool *pool;  // pool for vertices, edges and lists,
+                      // if set by usePool
 } network;
 
 
@@ -44,6 +46,12 @@ network *newNetwork (size_t capacity, weightType weight);
   // Deallocates the network
 void freeNetwork (network *N);
 
+  // Makes the network take its vertices, edges and internal
+  // list nodes from a pool owned by the network, so that 
+  // freeNetwork releases them all at once
+  // Should be called before adding any vertices
+void usePool(network *N);
+
   // Sets the pointer to the adjList of a vertex
   // If the vertex has no adj list or is not in the network,
   // the pointer is set to NULL
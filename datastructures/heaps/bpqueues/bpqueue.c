@@ -4,6 +4,9 @@
     mapping data to indices in the queue (str(data) -> idx)
     String representation of data should be unique for each 
     data item
+  Alternatively, the queue can be created with bpqNewSlot, 
+    in which case the data carries its own index slot and 
+    no hashing or allocation is needed to locate it
   Author: David De Potter
   LICENSE: MIT, see LICENSE file in repository root folder
 */
@@ -39,6 +42,29 @@ bpqueue *bpqNew(size_t capacity, bpqType type, bpqCompKey compKey,
   return pq;
 }
 
+//===================================================================
+// Creates a new priority queue in which each data item carries
+// a slot that holds its current index in the queue
+bpqueue *bpqNewSlot(size_t capacity, bpqType type, 
+                    bpqCompKey compKey, bpqCopyKey copyKey, 
+                    bpqFreeKey freeKey, bpqPosSlot posSlot, 
+                    void *sentinel) {
+
+  bpqueue *pq = safeCalloc(1, sizeof(bpqueue));
+  pq->arr = safeCalloc(capacity, sizeof(bpqNode *));
+  pq->posSlot = posSlot;
+  pq->capacity = capacity;
+  pq->compKey = compKey;
+  pq->copyKey = copyKey;
+  pq->freeKey = freeKey;
+  pq->type = type;
+  pq->fac = type == MIN ? 1 : -1;
+  pq->label = "BINARY PQ";
+  pq->delim = ", ";
+  pq->sentinel = sentinel;
+  return pq;
+}
+
 //===================================================================
 // Creates a new pbqNode
 bpqNode *bpqNodeNew(void *data, void *key) {
@@ -57,7 +83,8 @@ void bpqFree(bpqueue *pq) {
     free(pq->arr[i]);
   }
   free(pq->arr);
-  sstMapFree(pq->datamap);
+  if (pq->datamap)
+    sstMapFree(pq->datamap);
   free(pq);
 }
 
@@ -90,13 +117,47 @@ void *bpqPeek(bpqueue *pq) {
   return pq->arr[0]->data;
 }
 
+//===================================================================
+// Records that the data is now at index idx in the queue
+static inline void setIdx(bpqueue *pq, void *data, size_t idx) {
+  if (pq->posSlot)
+    *pq->posSlot(data) = idx;
+  else 
+    sstMapAddKey(pq->datamap, pq->toString(data), idx);
+}
+
+//===================================================================
+// Removes the data -> idx mapping
+static inline void delIdx(bpqueue *pq, void *data) {
+  if (pq->posSlot)
+    *pq->posSlot(data) = SIZE_MAX;
+  else 
+    sstMapDelKey(pq->datamap, pq->toString(data));
+}
+
+//===================================================================
+// Sets idx to the index of the data in the queue;
+// returns false if the data is not in the queue
+static inline bool getIdx(bpqueue *pq, void *data, size_t *idx) {
+  if (pq->posSlot) {
+    *idx = *pq->posSlot(data);
+      // the slot may hold a stale value, so we need to 
+      // check if the node at that index holds the data
+    return *idx < pq->size && pq->arr[*idx]->data == data;
+  }
+  return sstMapHasKeyVal(pq->datamap, pq->toString(data), idx) 
+         && pq->arr[*idx];
+}
+
 //===================================================================
 // Swaps two nodes in the priority queue
 static void swapNodes(bpqueue *pq, size_t i, size_t j) {
-  SWAP(pq->arr[i], pq->arr[j]);
-    // update the map with the new indices
-  sstMapAddKey(pq->datamap, pq->toString(pq->arr[i]->data), i);
-  sstMapAddKey(pq->datamap, pq->toString(pq->arr[j]->data), j);
+  bpqNode *tmp = pq->arr[i];
+  pq->arr[i] = pq->arr[j];
+  pq->arr[j] = tmp;
+    // update the index mapping
+  setIdx(pq, pq->arr[i]->data, i);
+  setIdx(pq, pq->arr[j]->data, j);
 }
 
 //===================================================================
@@ -125,8 +186,8 @@ void *bpqPop(bpqueue *pq) {
     return NULL;
     // get the top element
   void *top = pq->arr[0]->data;
-    // remove the string(data) -> idx mapping
-  sstMapDelKey(pq->datamap, pq->toString(top));
+    // remove the data -> idx mapping
+  delIdx(pq, top);
     // free the key
   pq->freeKey(pq->arr[0]->key);
     // free the bpqNode, obviously NOT the data
@@ -142,8 +203,8 @@ void *bpqPop(bpqueue *pq) {
   pq->arr[0] = pq->arr[pq->size];
     // avoid dangling pointers
   pq->arr[pq->size] = NULL;   
-    // update the map
-  sstMapAddKey(pq->datamap, pq->toString(pq->arr[0]->data), 0);
+    // update the mapping
+  setIdx(pq, pq->arr[0]->data, 0);
     // restore the heap property
   bpqHeapify(pq, 0);
   return top;
@@ -161,8 +222,8 @@ void bpqPush(bpqueue *pq, void *data, void *key) {
   size_t idx = pq->size;
     // create a new node
   pq->arr[idx] = bpqNodeNew(data, pq->copyKey(key));
-    // add a string(data) -> idx mapping 
-  sstMapAddKey(pq->datamap, pq->toString(data), idx);
+    // add a data -> idx mapping 
+  setIdx(pq, data, idx);
     // restore the heap property
   while (idx > 0 && (pq->fac * pq->compKey(pq->arr[idx]->key, 
                                pq->arr[PARENT(idx)]->key) < 0)) {
@@ -176,15 +237,15 @@ void bpqPush(bpqueue *pq, void *data, void *key) {
 //===================================================================
 // Checks if the data is in the priority queue
 bool bpqContains(bpqueue *pq, void *data) {
-  return sstMapHasKey(pq->datamap, pq->toString(data));
+  size_t idx = 0;
+  return getIdx(pq, data, &idx);
 }
 
 //===================================================================
 // Returns the key associated with the data
 void *bpqGetKey(bpqueue *pq, void *data) {
   size_t idx = 0;
-  if (!sstMapHasKeyVal(pq->datamap, pq->toString(data), &idx) ||
-      ! pq->arr[idx])
+  if (! getIdx(pq, data, &idx))
     return NULL;
   return pq->arr[idx]->key;
 }
@@ -195,8 +256,7 @@ static bool bpqChangeKey(bpqueue *pq, void *data, void *newKey) {
   
     // get the index of the node in the queue
   size_t idx = 0;
-  if (!sstMapHasKeyVal(pq->datamap, pq->toString(data), &idx) ||
-      ! pq->arr[idx]) {
+  if (! getIdx(pq, data, &idx)) {
     fprintf(stderr, "bpqChangeKey: data not in the queue\n");
     return false;
   }
@@ -4,6 +4,10 @@
     mapping data to indices in the queue (str(data) -> idx)
     String representation of data should be unique for each 
     data item
+  Alternatively, use bpqNewSlot to create a queue in which each
+    data item carries a size_t slot where the queue stores the
+    item's current index; this avoids all hashing and string 
+    copying when nodes are moved around in the heap
     The comparison function should compare the keys of the
     nodes in the queue (not the data) and return -1, 0, 1
     for less than, equal to, greater than, respectively
@@ -26,6 +30,7 @@ typedef void *(*bpqCopyKey)(void const *key);
 typedef void (*bpqShowKey)(void const *key);
 typedef char *(*bpqToString)(void const *data);
 typedef void (*bpqShowData)(void const *data);
+typedef size_t *(*bpqPosSlot)(void const *data);
 
 // priority queue type
 typedef enum { MIN, MAX } bpqType;
@@ -41,6 +46,8 @@ typedef struct {
   bpqNode **arr;         // array of nodes
   sstMap *datamap;       // maps input data to indices in the queue
   bpqToString toString;  // function to convert data to string
+  bpqPosSlot posSlot;    // function returning the index slot of 
+                         // the data; if set, datamap is not used
   bpqShowData showData;  // function to show data                        
   size_t size;           // number of nodes in the queue
   size_t capacity;       // capacity of the queue
@@ -70,6 +77,16 @@ bpqueue *bpqNew(size_t capacity, bpqType type,
                 bpqFreeKey freeKey, bpqToString toString,
                 void *sentinel);
 
+  // creates a new priority queue, just like bpqNew, but 
+  // instead of a data to string function, it takes a 
+  // function that returns a pointer to a size_t slot 
+  // inside the data, in which the queue keeps the current
+  // index of the data; the slot need not be initialized
+bpqueue *bpqNewSlot(size_t capacity, bpqType type, 
+                    bpqCompKey cmp, bpqCopyKey copyKey,
+                    bpqFreeKey freeKey, bpqPosSlot posSlot,
+                    void *sentinel);
+
   // sets the show function for the priority queue
 void bpqSetShow(bpqueue *pq, bpqShowKey show, 
                 bpqShowData showData);
@@ -0,0 +1,158 @@
+/*
+  Benchmark of the two modes of the binary priority queue:
+    the string-keyed data map (bpqNew) versus the index
+    slot carried by the data (bpqNewSlot)
+  Both modes are used to run Dijkstra's algorithm on the
+    same random sparse graphs, and the distances are compared
+    to make sure both runs agree
+  Usage: ./bpqBench.out [nVertices] [avgDegree]
+  Author: David De Potter
+*/
+
+#include "../bpqueue.h"
+#include <time.h>
+#include <float.h>
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// node of the benchmark graph
+typedef struct {
+  char label[50];
+  double dist;
+  size_t pqIdx;
+} node;
+
+//===================================================================
+// random graph in adjacency array form
+typedef struct {
+  size_t n, m;
+  node *nodes;
+  size_t *offsets;        // edges of u are in [offsets[u], offsets[u+1])
+  size_t *targets;
+  double *weights;
+} bgraph;
+
+//===================================================================
+// comparison function for double keys
+int compKeys(void const *a, void const *b) {
+  double x = *(double *)a;
+  double y = *(double *)b;
+  return x < y ? -1 : x > y;
+}
+
+//===================================================================
+// makes a copy of a double key
+void *copyKey(void const *key) {
+  double *copy = safeCalloc(1, sizeof(double));
+  *copy = *(double *)key;
+  return copy;
+}
+
+//===================================================================
+// string representation of a node
+char *nodeToString(void const *data) {
+  return ((node *)data)->label;
+}
+
+//===================================================================
+// index slot of a node
+size_t *nodeSlot(void const *data) {
+  return &((node *)data)->pqIdx;
+}
+
+//===================================================================
+// generates a random directed graph with n nodes and n * deg edges
+bgraph *newRandomGraph(size_t n, size_t deg) {
+  bgraph *G = safeCalloc(1, sizeof(bgraph));
+  G->n = n;
+  G->m = n * deg;
+  G->nodes = safeCalloc(n, sizeof(node));
+  G->offsets = safeCalloc(n + 1, sizeof(size_t));
+  G->targets = safeCalloc(G->m, sizeof(size_t));
+  G->weights = safeCalloc(G->m, sizeof(double));
+  for (size_t u = 0; u < n; u++) {
+    sprintf(G->nodes[u].label, "v%zu", u);
+    G->offsets[u + 1] = G->offsets[u] + deg;
+  }
+  for (size_t e = 0; e < G->m; e++) {
+    G->targets[e] = rand() % n;
+    G->weights[e] = 1 + rand() % 100;
+  }
+  return G;
+}
+
+//===================================================================
+// deallocates the graph
+void freeRandomGraph(bgraph *G) {
+  free(G->nodes);
+  free(G->offsets);
+  free(G->targets);
+  free(G->weights);
+  free(G);
+}
+
+//===================================================================
+// runs Dijkstra's algorithm from node 0 using the given queue,
+// which is expected to be empty; returns the time in seconds
+double dijkstra(bgraph *G, bpqueue *pq, double *dist) {
+  clock_t start = clock();
+  for (size_t u = 0; u < G->n; u++) {
+    G->nodes[u].dist = u == 0 ? 0 : DBL_MAX;
+    bpqPush(pq, &G->nodes[u], &G->nodes[u].dist);
+  }
+  while (! bpqIsEmpty(pq)) {
+    node *u = bpqPop(pq);
+    size_t ui = u - G->nodes;
+    for (size_t e = G->offsets[ui]; e < G->offsets[ui + 1]; e++) {
+      node *v = &G->nodes[G->targets[e]];
+      if (bpqContains(pq, v) && v->dist > u->dist + G->weights[e]) {
+        v->dist = u->dist + G->weights[e];
+        bpqUpdateKey(pq, v, &v->dist);
+      }
+    }
+  }
+  double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+  for (size_t u = 0; u < G->n; u++)
+    dist[u] = G->nodes[u].dist;
+  return secs;
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  srand(42);
+
+  size_t maxN = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  size_t deg = argc > 2 ? strtoul(argv[2], NULL, 10) : 8;
+
+  printf("Dijkstra with a binary PQ, average out-degree %zu\n\n"
+         "%10s  %12s  %12s  %8s\n", deg,
+         "vertices", "string map", "index slot", "speedup");
+
+  for (size_t n = 1000; n <= maxN; n *= 10) {
+    bgraph *G = newRandomGraph(n, deg);
+    double *d1 = safeCalloc(n, sizeof(double));
+    double *d2 = safeCalloc(n, sizeof(double));
+
+    bpqueue *pq = bpqNew(n, MIN, compKeys, copyKey, free,
+                         nodeToString, NULL);
+    double t1 = dijkstra(G, pq, d1);
+    bpqFree(pq);
+
+    pq = bpqNewSlot(n, MIN, compKeys, copyKey, free,
+                    nodeSlot, NULL);
+    double t2 = dijkstra(G, pq, d2);
+    bpqFree(pq);
+
+    if (memcmp(d1, d2, n * sizeof(double)) != 0)
+      fprintf(stderr, "Distances differ for n = %zu\n", n);
+
+    printf("%10zu  %11.3fs  %11.3fs  %7.2fx\n", n, t1, t2,
+           t2 > 0 ? t1 / t2 : 0);
+
+    free(d1);
+    free(d2);
+    freeRandomGraph(G);
+  }
+  return 0;
+}
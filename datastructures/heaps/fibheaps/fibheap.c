@@ -50,7 +50,8 @@ fibheap *fibNew(fibType type, fibCompKey compKey,
 //===================================================================
 // Creates a new Fibonnacci node with data and key
 static fibnode *newFibnode(fibheap *F, void *data, void *key) {
-  fibnode *u = safeCalloc(1, sizeof(fibnode));
+  fibnode *u = F->pool ? poolAlloc(F->pool, sizeof(fibnode)) 
+                      : safeCalloc(1, sizeof(fibnode));
   u->data = data;
   u->key = key;
   u->mark = false;
@@ -66,7 +67,10 @@ static void freeFibnode(fibheap *F, fibnode *u) {
   F->freeKey(u->key);
     // remove the key-value pair from the datamap
   mapDelKey(F->datamap, F->toString(u->data));
-  free(u);
+  if (F->pool)
+    poolRelease(F->pool, u, sizeof(fibnode));
+  else
+    free(u);
 }
 
 //===================================================================
@@ -93,6 +97,13 @@ void fibSetLabel(fibheap *F, char *label) {
   F->label = label;
 }
 
+//===================================================================
+// Makes the heap and its data map take their nodes from the pool
+void fibUsePool(fibheap *F, pool *P) {
+  F->pool = P;
+  mapUsePool(F->datamap, P);
+}
+
 //===================================================================
 // Inserts node u before node v in the circular doubly linked list
 // containing v
@@ -65,6 +65,7 @@ typedef struct {
   void *sentinel;         // sentinel key for deletion:
                           // a non-inclusive upper limit for a max heap
                           // a non-inclusive lower limit for a min heap
+  struct pool *pool;      // pool for the nodes, if any
 } fibheap;
 
 // function prototypes
@@ -81,6 +82,11 @@ void fibSetShow(fibheap *F, fibShowKey showKey, fibShowData showData);
   // sets the label for the Fibonacci heap
 void fibSetLabel(fibheap *F, char *label);
 
+  // makes the heap and its data map take their nodes from 
+  // the given pool (see lib/clib.h); should be called 
+  // before pushing any data
+void fibUsePool(fibheap *F, struct pool *P);
+
   // deallocates the Fibonacci heap
 void fibFree(fibheap *F);
 
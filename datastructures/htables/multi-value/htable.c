@@ -64,6 +64,25 @@ void htCopyVals(htable *H, htCopyValue copyValue,
   H->freeValue = freeValue;
 }
 
+void htUsePool(htable *H, pool *P) {
+  H->pool = P;
+}
+
+//=================================================================
+// creates a new list for a bucket or for the values of a key
+static dll *newList(htable *H) {
+  return H->pool ? dllNewP(H->pool) : dllNew();
+}
+
+//=================================================================
+// releases the memory of an entry
+static void releaseEntry(htable *H, htEntry *e) {
+  if (H->pool)
+    poolRelease(H->pool, e, sizeof(htEntry));
+  else
+    free(e);
+}
+
 //=================================================================
 // gets number of values associated with a key
 size_t htKeySize(htable *H, void *key) {
@@ -83,7 +102,7 @@ void htFree(htable *H) {
         if (H->freeKey)
           H->freeKey(e->key);         
         dllFree(e->values);
-        free(e);
+        releaseEntry(H, e);
       }
       dllFree(bucket);
     }
@@ -200,7 +219,7 @@ static void htRehash(htable *H) {
     for (htEntry *e = dllFirst(bucket); e; e = dllNext(bucket)) {
       size_t newIndex = getIndex(H, e->key);
       if (! newBuckets[newIndex]) {
-        newBuckets[newIndex] = dllNew();
+        newBuckets[newIndex] = newList(H);
         H->nFilled++;
       } 
       dllPush(newBuckets[newIndex], e);
@@ -219,12 +238,13 @@ static void htRehash(htable *H) {
 static void htAddNewkeyVal(htable *H, void *key, void *value, 
                            dll *bucket) {
 
-  htEntry *entry = safeCalloc(1, sizeof(htEntry));
+  htEntry *entry = H->pool ? poolAlloc(H->pool, sizeof(htEntry))
+                            : safeCalloc(1, sizeof(htEntry));
 
     // copy the key if a copy function is provided
   entry->key = H->copyKey ? H->copyKey(key) : key;
     // create a new value list
-  entry->values = dllNew();
+  entry->values = newList(H);
     // set ownership of the value list
   if (H->copyValue)
     dllCopyData(entry->values, H->copyValue, H->freeValue);
@@ -255,7 +275,7 @@ void htAddKeyVal(htable *H, void *key, void *value) {
   size_t index = getIndex(H, key);
   
   if (! H->buckets[index]) {
-    H->buckets[index] = dllNew();
+    H->buckets[index] = newList(H);
     // no ownership for the entries, since we want
     // to keep the entries when rehashing, but still
     // want to free the bucket after rehashing
@@ -287,7 +307,7 @@ void htAddKey(htable *H, void *key) {
   size_t index = getIndex(H, key);
 
   if (! H->buckets[index]) {
-    H->buckets[index] = dllNew();
+    H->buckets[index] = newList(H);
     // no ownership for the entries, since we 
     // want to keep the entries when rehashing
     H->nFilled++;
@@ -322,7 +342,7 @@ bool htDelKey(htable *H, void *key) {
         // free the list of values 
       dllFree(e->values);
         // free the entry itself
-      free(e);
+      releaseEntry(H, e);
         // remove the entry from the bucket
       dllDeleteCurr(bucket);
         // one key less
@@ -49,6 +49,8 @@ typedef struct {
   char *label;            // label for the hash table
   char *valDelim;         // delimiter for the values
                           // default is ", "
+  struct pool *pool;      // pool for the entries and all
+                          // lists, if any
 } htable;
 
 typedef struct {          // key-value pair
@@ -92,6 +94,11 @@ void htOwnKeys(htable *H, htFreeKey freeKey);
   // freeing them when the table is freed
 void htOwnVals(htable *H, htFreeValue freeValue);
 
+  // makes the table take its entries, bucket lists and
+  // value lists from the given pool (see lib/clib.h);
+  // should be called before adding any keys
+void htUsePool(htable *H, struct pool *P);
+
   // frees the hash table
 void htFree(htable *H);
 
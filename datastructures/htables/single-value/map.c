@@ -1,6 +1,8 @@
 /* 
   Generic hash table implementation.
   Keys can have only one value.
+  Collisions are resolved either by separate chaining, or 
+  by open addressing with Robin Hood linear probing.
   Author: David De Potter
   LICENSE: MIT, see LICENSE file in repository root folder
 */
@@ -26,6 +28,119 @@ map *mapNew(mapHash hash, size_t capacity,
   return M;
 }
 
+//=================================================================
+// Creates a new map using open addressing
+map *mapNewOA(mapHash hash, size_t capacity, 
+              mapCompKey cmpKey) {
+  
+  map *M = safeCalloc(1, sizeof(map));
+  M->engine = OPEN_ADDRESSING;
+    // the capacity is a power of two, so that the
+    // slot index can be computed with a mask
+  M->capacity = 32;
+  while (M->capacity < capacity)
+    M->capacity <<= 1;
+  M->slots = safeCalloc(M->capacity, sizeof(mapEntry));
+  M->dists = safeCalloc(M->capacity, sizeof(uint32_t));
+  M->hash = hash;
+  M->cmpKey = cmpKey;
+  M->label = "Map";
+  srand(time(NULL));
+  M->seed = rand();
+  M->seed ^= (uint64_t)time(NULL) << 16;
+  return M;
+}
+
+//=================================================================
+// Open addressing: returns the home slot of a key
+static inline size_t oaIndex(map *M, void *key) {
+  return M->hash(key, M->seed) & (M->capacity - 1);
+}
+
+//=================================================================
+// Open addressing: returns the slot of the key, or
+// SIZE_MAX if the key is not in the map
+// An entry at distance d from its home slot is stored with 
+// dists = d + 1, so the key can only be in a slot whose 
+// distance equals the current probe distance. Since the 
+// entries along a probe sequence are kept in order of their 
+// distance (Robin Hood), the search stops as soon as it meets 
+// an entry that is closer to its home than the probe would be.
+static size_t oaFind(map *M, void *key) {
+  size_t mask = M->capacity - 1;
+  size_t i = oaIndex(M, key);
+  for (uint32_t d = 1; M->dists[i] >= d; d++) {
+    if (M->dists[i] == d && ! M->cmpKey(key, M->slots[i].key))
+      return i;
+    i = (i + 1) & mask;
+  }
+  return SIZE_MAX;
+}
+
+//=================================================================
+// Open addressing: inserts an entry whose key is not yet in
+// the map; on the way, the entry takes the slot of any entry
+// that is closer to its home slot, which then moves on
+static void oaInsert(map *M, mapEntry entry) {
+  size_t mask = M->capacity - 1;
+  size_t i = oaIndex(M, entry.key);
+  uint32_t d = 1;
+  while (M->dists[i]) {
+    if (M->dists[i] < d) {
+      mapEntry tmpE = M->slots[i];
+      uint32_t tmpD = M->dists[i];
+      M->slots[i] = entry;
+      M->dists[i] = d;
+      entry = tmpE;
+      d = tmpD;
+    }
+    i = (i + 1) & mask;
+    d++;
+  }
+  M->slots[i] = entry;
+  M->dists[i] = d;
+}
+
+//=================================================================
+// Open addressing: doubles the capacity if the load factor
+// would exceed 7/8 after adding a key
+static void oaRehash(map *M) {
+  if (8 * (M->nKeys + 1) <= 7 * M->capacity)
+    return;
+
+  size_t oldCapacity = M->capacity;
+  mapEntry *oldSlots = M->slots;
+  uint32_t *oldDists = M->dists;
+
+  M->capacity *= 2;
+  M->slots = safeCalloc(M->capacity, sizeof(mapEntry));
+  M->dists = safeCalloc(M->capacity, sizeof(uint32_t));
+
+  for (size_t i = 0; i < oldCapacity; i++) 
+    if (oldDists[i])
+      oaInsert(M, oldSlots[i]);
+
+  free(oldSlots);
+  free(oldDists);
+}
+
+//=================================================================
+// Open addressing: empties slot i by shifting the entries that
+// follow it one slot back, until an empty slot or an entry in 
+// its home slot is reached; this way no tombstones are needed
+static void oaRemove(map *M, size_t i) {
+  size_t mask = M->capacity - 1;
+  size_t j = (i + 1) & mask;
+  while (M->dists[j] > 1) {
+    M->slots[i] = M->slots[j];
+    M->dists[i] = M->dists[j] - 1;
+    i = j;
+    j = (j + 1) & mask;
+  }
+  M->slots[i] = (mapEntry){ NULL, NULL };
+  M->dists[i] = 0;
+}
+
 //=================================================================
 // Setters
 
@@ -59,9 +174,42 @@ void mapCopyVals(map *M, mapCopyValue copyValue,
   M->freeValue = freeValue;
 }
 
+void mapUsePool(map *M, pool *P) {
+  M->pool = P;
+}
+
+//=================================================================
+// Chaining: creates a new bucket list
+static dll *newBucket(map *M) {
+  return M->pool ? dllNewP(M->pool) : dllNew();
+}
+
+//=================================================================
+// Chaining: releases the memory of an entry
+static void releaseEntry(map *M, mapEntry *e) {
+  if (M->pool)
+    poolRelease(M->pool, e, sizeof(mapEntry));
+  else
+    free(e);
+}
+
 //=================================================================
 // Deallocates the map
 void mapFree(map *M) {
+  if (M->engine == OPEN_ADDRESSING) {
+    for (size_t i = 0; i < M->capacity; i++) {
+      if (! M->dists[i])
+        continue;
+      if (M->freeKey)
+        M->freeKey(M->slots[i].key);
+      if (M->freeValue)
+        M->freeValue(M->slots[i].value);
+    }
+    free(M->slots);
+    free(M->dists);
+    free(M);
+    return;
+  }
   for (size_t i = 0; i < M->capacity; i++) {
     if (M->buckets[i]) {
       dll *bucket = M->buckets[i];
@@ -70,7 +218,7 @@ void mapFree(map *M) {
           M->freeKey(e->key);         
         if (M->freeValue)
           M->freeValue(e->value);
-        free(e);
+        releaseEntry(M, e);
       }
       dllFree(bucket);
     }
@@ -88,6 +236,13 @@ static size_t getIndex(map *M, void *key) {
 //=================================================================
 // Returns true if the key exists and sets the pointer to the value
 bool mapHasKeyVal(map *M, void *key, void **value) {
+  if (M->engine == OPEN_ADDRESSING) {
+    size_t i = oaFind(M, key);
+    if (i == SIZE_MAX)
+      return false;
+    *value = M->slots[i].value;
+    return true;
+  }
   size_t index = getIndex(M, key);
   dll *bucket = M->buckets[index];
   if (! bucket || dllIsEmpty(bucket))
@@ -104,6 +259,8 @@ bool mapHasKeyVal(map *M, void *key, void **value) {
 //=================================================================
 // Returns true if the key exists
 bool mapHasKey(map *M, void *key) {
+  if (M->engine == OPEN_ADDRESSING)
+    return key && oaFind(M, key) != SIZE_MAX;
   if (!key || !M->buckets[getIndex(M, key)])
     return false;
   void *value = NULL;
@@ -113,6 +270,10 @@ bool mapHasKey(map *M, void *key) {
 //=================================================================
 // Returns the key from the table given an identifying key
 void *mapGetKey(map *M, void *key) {
+  if (M->engine == OPEN_ADDRESSING) {
+    size_t i = oaFind(M, key);
+    return i == SIZE_MAX ? NULL : M->slots[i].key;
+  }
   size_t index = getIndex(M, key);
   dll *bucket = M->buckets[index];
   if (! bucket) 
@@ -158,7 +319,7 @@ static void mapRehash(map *M) {
     for (mapEntry *e = dllFirst(bucket); e; e = dllNext(bucket)) {
       size_t newIndex = getIndex(M, e->key);
       if (! newBuckets[newIndex]) {
-        newBuckets[newIndex] = dllNew();
+        newBuckets[newIndex] = newBucket(M);
         M->nFilled++;
       } 
       dllPush(newBuckets[newIndex], e);
@@ -177,7 +338,8 @@ static void mapRehash(map *M) {
 static void mapAddNewkeyVal(map *M, void *key, void *value, 
                             dll *bucket) {
   
-  mapEntry *entry = safeCalloc(1, sizeof(mapEntry));
+  mapEntry *entry = M->pool ? poolAlloc(M->pool, sizeof(mapEntry))
+                            : safeCalloc(1, sizeof(mapEntry));
 
     // copy the key if a copy function is provided
   entry->key = M->copyKey ? M->copyKey(key) : key;
@@ -195,6 +357,26 @@ static void mapAddNewkeyVal(map *M, void *key, void *value,
 // Tries to add a key-value pair to the table; if the key
 // already exists, its value is updated with the new value
 void mapAddKey(map *M, void *key, void *value) {
+
+  if (M->engine == OPEN_ADDRESSING) {
+    size_t i = oaFind(M, key);
+    if (i != SIZE_MAX) {
+      if (M->freeValue) 
+        M->freeValue(M->slots[i].value);
+      M->slots[i].value = M->copyValue ? 
+                          M->copyValue(value) : value;
+      return;
+    }
+    oaRehash(M);
+    mapEntry entry = {
+      M->copyKey ? M->copyKey(key) : key,
+      M->copyValue ? M->copyValue(value) : value
+    };
+    oaInsert(M, entry);
+    M->nKeys++;
+    M->nFilled++;
+    return;
+  }
     
     // rehash if necessary
   mapRehash(M);
@@ -202,7 +384,7 @@ void mapAddKey(map *M, void *key, void *value) {
   size_t index = getIndex(M, key);
   
   if (! M->buckets[index]) {
-    M->buckets[index] = dllNew();
+    M->buckets[index] = newBucket(M);
     // no ownership for the entries, since we want
     // to keep the entries when rehashing, but still
     // want to free the bucket after rehashing
@@ -231,6 +413,19 @@ void mapAddKey(map *M, void *key, void *value) {
 // Deletes a key from the map
 // returns true if the key was removed, false if not found
 bool mapDelKey(map *M, void *key) {
+  if (M->engine == OPEN_ADDRESSING) {
+    size_t i = oaFind(M, key);
+    if (i == SIZE_MAX)
+      return false;
+    if (M->freeKey) 
+      M->freeKey(M->slots[i].key);
+    if (M->freeValue) 
+      M->freeValue(M->slots[i].value);
+    oaRemove(M, i);
+    M->nKeys--;
+    M->nFilled--;
+    return true;
+  }
   size_t index = getIndex(M, key);
   dll *bucket = M->buckets[index];
   if (! bucket) 
@@ -245,7 +440,7 @@ bool mapDelKey(map *M, void *key) {
       if (M->freeValue) 
         M->freeValue(e->value);
         // free the entry itself
-      free(e);
+      releaseEntry(M, e);
         // remove the entry from the bucket
       dllDeleteCurr(bucket);
         // one key less
@@ -274,6 +469,16 @@ mapEntry *mapFirst(map *M) {
 // returns NULL if end of the map is reached
 mapEntry *mapNext(map *M) {
 
+  if (M->engine == OPEN_ADDRESSING) {
+      // skip empty slots
+    while (M->iterBucket < M->capacity && 
+           ! M->dists[M->iterBucket])
+      M->iterBucket++;
+    if (M->iterBucket >= M->capacity)
+      return NULL;
+    return &M->slots[M->iterBucket++];
+  }
+
     // if the end of the table is reached, 
     // return NULL
   if (M->iterBucket >= M->capacity) 
@@ -313,6 +518,13 @@ mapEntry *mapNext(map *M) {
 // Computes the maximum size of the buckets
 size_t mapMaxBucketSize(map *M) {
   size_t max = 0;
+  if (M->engine == OPEN_ADDRESSING) {
+      // longest probe sequence
+    for (size_t i = 0; i < M->capacity; i++) 
+      if (M->dists[i] > max)
+        max = M->dists[i];
+    return max;
+  }
   for (size_t i = 0; i < M->capacity; i++) 
     if (M->buckets[i] && M->buckets[i]->size > max)
       max = M->buckets[i]->size;
@@ -323,6 +535,19 @@ size_t mapMaxBucketSize(map *M) {
 // Gives an overview of the distribution of keys 
 // over the buckets
 void mapStats(map *M) {
+  if (M->engine == OPEN_ADDRESSING) {
+    printf("\n+---------------------------+\n"
+           "|      Map statistics       |\n"
+           "+---------------------------+\n\n"
+           "   Number of slots....: %zu\n"
+           "   Number of keys.....: %zu\n"
+           "   Load factor........: %.2f\n"
+           "   Max. probe length..: %zu\n\n\n",
+           M->capacity, M->nKeys,
+           (double)M->nKeys / M->capacity, 
+           mapMaxBucketSize(M));
+    return;
+  }
   printf("\n+---------------------------+\n"
          "|      Map statistics       |\n"
          "+---------------------------+\n\n"
@@ -383,7 +608,9 @@ void mapShowEntry(map *M, void *key) {
 // Returns a copy of the map
 map *mapCopy(map *M) {
   
-  map *copy = mapNew(M->hash, M->capacity, M->cmpKey);
+  map *copy = M->engine == OPEN_ADDRESSING ?
+              mapNewOA(M->hash, M->capacity, M->cmpKey) :
+              mapNew(M->hash, M->capacity, M->cmpKey);
   if (M->copyKey)
     mapCopyKeys(copy, M->copyKey, M->freeKey);
   if (M->copyValue)
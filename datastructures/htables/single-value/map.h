@@ -1,5 +1,7 @@
 /* 
   Generic map implementation, using separate chaining
+  or, if created with mapNewOA, open addressing with
+  Robin Hood hashing and backward shift deletion
   Keys have exactly one value associated with them
   Author: David De Potter
   LICENSE: MIT, see LICENSE file in repository root folder
@@ -23,11 +25,23 @@ typedef void (*mapFreeValue)(void *val);
 typedef void *(*mapCopyKey)(void const *key);
 typedef void *(*mapCopyValue)(void const *val);
 
+  // collision resolution strategy
+typedef enum { CHAINING, OPEN_ADDRESSING } mapEngine;
+
+typedef struct {          // key-value pair
+  void *key;              // key
+  void *value;            // value
+} mapEntry;
+
   // hash map structure
 typedef struct {
-  size_t capacity;        // number of available buckets
+  mapEngine engine;       // chaining or open addressing
+  size_t capacity;        // number of available buckets/slots
   size_t nKeys;           // number of keys
   dll **buckets;          // array of doubly linked lists
+  mapEntry *slots;        // open addressing: array of entries
+  uint32_t *dists;        // open addressing: probe distance + 1
+                          // of the entry in each slot; 0 if empty
   mapHash hash;           // hash function
   mapCompKey cmpKey;      // comparison function for the keys
   uint64_t seed;          // magic seed for the map
@@ -41,19 +55,24 @@ typedef struct {
   mapCopyValue copyValue; // function to copy the value
   size_t nFilled;         // number of filled buckets
   char *label;            // label for the map
+  struct pool *pool;      // chaining: pool for the entries
+                          // and bucket lists, if any
 } map;
 
-typedef struct {          // key-value pair
-  void *key;              // key
-  void *value;            // value
-} mapEntry;
-
   // map function prototypes
 
-  // creates a new map
+  // creates a new map, using separate chaining
 map *mapNew(mapHash hash, size_t capacity, 
             mapCompKey cmpKey);
 
+  // creates a new map, using open addressing: the
+  // entries are stored inline in a single array and
+  // collisions are resolved by Robin Hood linear probing, 
+  // so that no allocations are needed per key; the 
+  // capacity is rounded up to a power of two
+map *mapNewOA(mapHash hash, size_t capacity, 
+              mapCompKey cmpKey);
+
   // sets the label for the map
   // default is "map"
 void mapSetLabel(map *M, char *label);
@@ -80,6 +99,12 @@ void mapOwnKeys(map *M, mapFreeKey freeKey);
   // freeing them when the map is freed
 void mapOwnVals(map *M, mapFreeValue freeValue);
 
+  // makes the map take its entries and bucket lists from
+  // the given pool (see lib/clib.h); should be called
+  // before adding any keys; an open addressing map keeps
+  // its entries inline and does not use the pool
+void mapUsePool(map *M, struct pool *P);
+
   // dellocates the map
 void mapFree(map *M);
 
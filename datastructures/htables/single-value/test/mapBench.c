@@ -0,0 +1,115 @@
+/*
+  Benchmark of the two map engines: separate chaining
+    (mapNew) versus open addressing (mapNewOA)
+  For each size, the keys 0..n-1 are inserted in random
+    order, then all of them are looked up, together with
+    n keys that are not in the map, and finally all keys
+    are deleted again; the results are checked on the way
+  Usage: ./mapBench.out [maxKeys]
+  Author: David De Potter
+*/
+
+#include "../map.h"
+#include <time.h>
+#include "../../../../lib/clib.h"
+
+//===================================================================
+// hash function for uint64_t keys (splitmix64 finalizer)
+uint64_t hashU64(void *key, uint64_t seed) {
+  uint64_t x = *(uint64_t *)key + seed;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+//===================================================================
+// comparison function for uint64_t keys
+int cmpU64(void const *a, void const *b) {
+  uint64_t x = *(uint64_t *)a;
+  uint64_t y = *(uint64_t *)b;
+  return x < y ? -1 : x > y;
+}
+
+//===================================================================
+// returns the elapsed time in seconds since start
+double elapsed(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//===================================================================
+// runs the benchmark on the given map and shows the throughput
+// in millions of operations per second
+void bench(map *M, char *label, uint64_t *keys, uint64_t *misses,
+           size_t n) {
+
+  clock_t start = clock();
+  for (size_t i = 0; i < n; i++)
+    mapAddKey(M, &keys[i], &keys[i]);
+  double tIns = elapsed(start);
+
+  size_t found = 0;
+  start = clock();
+  for (size_t i = 0; i < n; i++)
+    found += mapGetVal(M, &keys[i]) == &keys[i];
+  for (size_t i = 0; i < n; i++)
+    found += mapGetVal(M, &misses[i]) != NULL;
+  double tLook = elapsed(start);
+
+  size_t iterated = 0;
+  for (mapEntry *e = mapFirst(M); e; e = mapNext(M))
+    iterated++;
+
+  size_t deleted = 0;
+  start = clock();
+  for (size_t i = 0; i < n; i++)
+    deleted += mapDelKey(M, &keys[i]);
+  double tDel = elapsed(start);
+
+  if (found != n || iterated != n || deleted != n || mapSize(M))
+    fprintf(stderr, "%s: inconsistent results for n = %zu\n",
+            label, n);
+
+  printf("%10zu  %-10s  %10.2f  %10.2f  %10.2f\n", n, label,
+         tIns > 0 ? n / tIns / 1e6 : 0,
+         tLook > 0 ? 2 * n / tLook / 1e6 : 0,
+         tDel > 0 ? n / tDel / 1e6 : 0);
+}
+
+//===================================================================
+
+int main (int argc, char *argv[]) {
+  srand(42);
+  size_t maxN = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+
+  printf("Throughput in Mops/s\n\n"
+         "%10s  %-10s  %10s  %10s  %10s\n",
+         "keys", "engine", "insert", "lookup", "delete");
+
+  for (size_t n = 1000; n <= maxN; n *= 10) {
+      // keys 0..n-1 in random order, misses n..2n-1
+    uint64_t *keys = safeCalloc(n, sizeof(uint64_t));
+    uint64_t *misses = safeCalloc(n, sizeof(uint64_t));
+    for (size_t i = 0; i < n; i++) {
+      keys[i] = i;
+      misses[i] = n + i;
+    }
+    for (size_t i = n - 1; i > 0; i--) {
+      size_t j = ((size_t)rand() * RAND_MAX + rand()) % (i + 1);
+      uint64_t tmp = keys[i];
+      keys[i] = keys[j];
+      keys[j] = tmp;
+    }
+
+    map *M = mapNew(hashU64, 32, cmpU64);
+    bench(M, "chaining", keys, misses, n);
+    mapFree(M);
+
+    M = mapNewOA(hashU64, 32, cmpU64);
+    bench(M, "open addr", keys, misses, n);
+    mapFree(M);
+
+    free(keys);
+    free(misses);
+  }
+  return 0;
+}
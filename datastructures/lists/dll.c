@@ -21,6 +21,19 @@ dll *dllNew () {
   return L;
 }
 
+//=================================================================
+// Creates a new DLL, taking all memory from the pool
+dll *dllNewP (pool *P) {
+  dll *L = poolAlloc(P, sizeof(dll));
+  L->NIL = poolAlloc(P, sizeof(dllNode));
+  L->NIL->next = L->NIL;
+  L->NIL->prev = L->NIL;
+  L->iter = L->NIL;
+  L->delim = ", ";
+  L->pool = P;
+  return L;
+}
+
 //=================================================================
 // SETTERS
 // Sets the DLL to own the input data,
@@ -70,7 +83,7 @@ dll *dllCopy (dll *L, dllCpyData copyData, dllFreeData freeData) {
     fprintf(stderr, "dllCopy: freeData function not set\n");
     return NULL;
   }
-  dll *new = dllNew();
+  dll *new = L->pool ? dllNewP(L->pool) : dllNew();
   new->cmp = L->cmp;
   new->showData = L->showData;
   new->delim = L->delim;
@@ -92,6 +105,23 @@ dllNode *dllNewNode () {
   return node;
 }
 
+//=================================================================
+// Gets a new node, from the pool if the DLL has one
+static dllNode *dllAllocNode (dll *L) {
+  if (L->pool)
+    return poolAlloc(L->pool, sizeof(dllNode));
+  return dllNewNode();
+}
+
+//=================================================================
+// Releases the memory of a node, NOT its data
+static void dllReleaseNode (dll *L, dllNode *node) {
+  if (L->pool)
+    poolRelease(L->pool, node, sizeof(dllNode));
+  else 
+    free(node);
+}
+
 //=================================================================
 // Deallocates a DLL node
 static void dllFreeNode (dll *L, dllNode *node) {
@@ -99,7 +129,7 @@ static void dllFreeNode (dll *L, dllNode *node) {
     return;
   if (L->freeData) 
     L->freeData(node->dllData);
-  free(node);
+  dllReleaseNode(L, node);
 }
 
 //=================================================================
@@ -129,6 +159,11 @@ void dllFree (dll *L) {
     dllFreeNode(L, node);
     node = next;
   }
+  if (L->pool) {
+    poolRelease(L->pool, L->NIL, sizeof(dllNode));
+    poolRelease(L->pool, L, sizeof(dll));
+    return;
+  }
   free (L->NIL);
   free(L);
 }
@@ -139,7 +174,7 @@ void dllPush (dll *L, void *data) {
   if (! L) 
     return;
     // create a new first node
-  dllNode *n = dllNewNode();
+  dllNode *n = dllAllocNode(L);
     // current first node becomes the second node
   n->next = L->NIL->next;
   L->NIL->next->prev = n;
@@ -168,7 +203,7 @@ void dllInsert (dll *L, void *data) {
     return;
   }
     
-  dllNode *new = dllNewNode();
+  dllNode *new = dllAllocNode(L);
   new->dllData = data;
 
     // find the node to insert before
@@ -199,7 +234,7 @@ void dllPushBack (dll *L, void *data) {
   if (! L) 
     return;
     // create a new node (last node
-  dllNode *n = dllNewNode();
+  dllNode *n = dllAllocNode(L);
     // the last node becomes the penultimate node
   n->prev = L->NIL->prev;
   L->NIL->prev->next = n;
@@ -229,7 +264,7 @@ void *dllPop (dll *L) {
     // free the node, NOT the data
   n->prev->next = n->next;
   n->next->prev = n->prev;
-  free(n);
+  dllReleaseNode(L, n);
   L->size--;
   return data;
 }
@@ -249,7 +284,7 @@ void *dllPopBack (dll *L) {
     // free the node, NOT the data
   n->prev->next = n->next;
   n->next->prev = n->prev;
-  free(n);
+  dllReleaseNode(L, n);
   L->size--;
   return data;
 }
@@ -35,6 +35,8 @@ typedef struct {
   dllCpyData copyData;    // copy data function
   char *delim;            // delimiter string
   char *label;            // label for the DLL
+  struct pool *pool;      // pool for the nodes; NULL if
+                          // the nodes are allocated one by one
 } dll;
 
 // DLL function prototypes
@@ -42,6 +44,11 @@ typedef struct {
   // Creates a new DLL 
 dll *dllNew();
 
+  // Creates a new DLL whose header and nodes are all 
+  // taken from the given pool (see lib/clib.h); freeing
+  // the DLL returns them to the pool
+dll *dllNewP(struct pool *P);
+
   // Sets the DLL to own the input data,
   // freeing it when the DLL is freed
 void dllOwnData(dll *L, dllFreeData freeData);
@@ -10,7 +10,8 @@
 //===================================================================
 // Creates a new node with the given data
 static bsnode *bstNewNode (bstree *T, void *data) {
-  bsnode *n = safeCalloc(1, sizeof(bsnode));
+  bsnode *n = T->pool ? poolAlloc(T->pool, sizeof(bsnode)) 
+                      : safeCalloc(1, sizeof(bsnode));
   if (T->copy)
     n->data = T->copy(data);
   else
@@ -50,13 +51,22 @@ void bstOwnData (bstree *T, bstFreeData free) {
   T->free = free;
 }
 
+//===================================================================
+// Makes the tree take its nodes from the pool
+void bstUsePool (bstree *T, pool *P) {
+  T->pool = P;
+}
+
 //===================================================================
 // Deallocates a node
 static void bstFreeNode (bstree *T, bsnode *n) { 
   if (n){
     if (T->free)
       T->free(n->data);
-    free(n);
+    if (T->pool)
+      poolRelease(T->pool, n, sizeof(bsnode));
+    else
+      free(n);
   }
 }
 
@@ -75,6 +85,7 @@ static void bstFreeNodes (bstree *T, bsnode *x) {
 void bstFree (bstree *T) {
   if (T){
     bstFreeNodes(T, T->ROOT);
+      // the sentinel is never taken from the pool
     free(T->NIL);
     free(T);
   }
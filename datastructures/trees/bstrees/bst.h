@@ -37,6 +37,7 @@ typedef struct {
   bstFreeData free;         // function to free data
   bstCpyData copy;          // function to copy data
   size_t size;              // number of tree nodes
+  struct pool *pool;        // pool for the nodes, if any
 } bstree;
 
 // function prototypes
@@ -54,6 +55,10 @@ void bstOwnData(bstree *T, bstFreeData free);
   // sets the show function for the tree
 void bstSetShow(bstree *T, bstShowData show);
 
+  // makes the tree take its nodes from the given pool
+  // (see lib/clib.h); should be called before inserting
+void bstUsePool(bstree *T, struct pool *P);
+
   // returns true if the tree is empty
 bool bstIsEmpty (bstree *T);
 
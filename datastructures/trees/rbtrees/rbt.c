@@ -10,7 +10,8 @@
 //===================================================================
 // Creates a new node with given data
 static rbnode *rbtNewNode (rbtree *T, void *data) {
-  rbnode *n = safeCalloc(1, sizeof(rbnode));
+  rbnode *n = T->pool ? poolAlloc(T->pool, sizeof(rbnode)) 
+                      : safeCalloc(1, sizeof(rbnode));
   if (T->copy)
     n->data = T->copy(data);
   else
@@ -51,13 +52,22 @@ void rbtSetShow (rbtree *T, rbtShowData show) {
   T->show = show;
 }
 
+//===================================================================
+// Makes the tree take its nodes from the pool
+void rbtUsePool (rbtree *T, pool *P) {
+  T->pool = P;
+}
+
 //===================================================================
 // Deallocates memory for a node
 static void rbtFreeNode (rbtree *T, rbnode *n) {
   if (n) {
     if (T->free)
       T->free(n->data);
-    free(n);
+    if (T->pool)
+      poolRelease(T->pool, n, sizeof(rbnode));
+    else
+      free(n);
   }
 }
 
@@ -76,7 +86,8 @@ static void rbtFreeNodes (rbtree *T, rbnode *x) {
 void rbtFree (rbtree *T) {
   if (T) {
     rbtFreeNodes(T, T->ROOT);
-    rbtFreeNode(T, T->NIL);
+      // the sentinel is never taken from the pool
+    free(T->NIL);
     free(T);
   }
 }
@@ -38,6 +38,7 @@ typedef struct {
   rbtFreeData free;           // function to free data
   rbtCpyData copy;            // function to copy data
   size_t size;                // number of tree nodes
+  struct pool *pool;          // pool for the nodes, if any
 } rbtree; 
 
 // function prototypes
@@ -54,6 +55,10 @@ void rbtOwnData (rbtree *T, rbtFreeData free);
   
   // sets the show function for the tree
 void rbtSetShow (rbtree *T, rbtShowData show);
+
+  // makes the tree take its nodes from the given pool
+  // (see lib/clib.h); should be called before inserting
+void rbtUsePool (rbtree *T, struct pool *P);
   
   // returns true if the tree is empty
 bool rbtIsEmpty (rbtree *T);
@@ -1,5 +1,6 @@
 #include "clib.h"
 #include <string.h>
+#include <stddef.h>
 
 //=================================================================  
 // swaps two variables of any type
@@ -56,4 +57,445 @@ void *safeRealloc(void *ptr, size_t newSize) {
     exit(EXIT_FAILURE);
   }
   return ptr;
-}
\ No newline at end of file
+}
+
+//=================================================================
+// creates a new arena
+arena *arenaNew(size_t blockSize) {
+  arena *A = safeCalloc(1, sizeof(arena));
+  A->blockSize = blockSize ? blockSize : 1 << 16;
+  return A;
+}
+
+//=================================================================
+// returns n zeroed bytes from the arena, aligned to 16 bytes
+void *arenaAlloc(arena *A, size_t n) {
+  n = (n + 15) & ~(size_t)15;
+    // the block header is padded to a multiple of 16 bytes
+  size_t header = (sizeof(arenaBlock) + 15) & ~(size_t)15;
+  
+  if (! A->head || A->head->used + n > A->head->size) {
+      // the new block is at least large enough for n bytes
+    size_t size = MAX(A->blockSize, n);
+    arenaBlock *block = safeMalloc(header + size);
+    block->next = A->head;
+    block->size = size;
+    block->used = 0;
+    A->head = block;
+    A->nBlocks++;
+  }
+  
+  unsigned char *ptr = (unsigned char *)A->head + header 
+                       + A->head->used;
+  A->head->used += n;
+  memset(ptr, 0, n);
+  return ptr;
+}
+
+//=================================================================
+// releases all blocks of the arena
+void arenaFree(arena *A) {
+  if (! A) 
+    return;
+  while (A->head) {
+    arenaBlock *next = A->head->next;
+    free(A->head);
+    A->head = next;
+  }
+  free(A);
+}
+
+//=================================================================
+// creates a new pool
+pool *poolNew(void) {
+  pool *P = safeCalloc(1, sizeof(pool));
+  P->slabs = arenaNew(0);
+  return P;
+}
+
+//=================================================================
+// returns a zeroed object of the given size from the pool
+void *poolAlloc(pool *P, size_t size) {
+  P->nAllocs++;
+  if (size > POOL_MAX_OBJ)
+    return arenaAlloc(P->slabs, size);
+  
+  size_t cls = (size + 15) / 16;
+  void *obj = P->freeLists[cls];
+  if (! obj)
+    return arenaAlloc(P->slabs, cls * 16);
+  
+    // the first word of a released object links to the next
+  P->freeLists[cls] = *(void **)obj;
+  memset(obj, 0, cls * 16);
+  return obj;
+}
+
+//=================================================================
+// returns an object to its free list; large objects 
+// are only reclaimed when the pool is freed
+void poolRelease(pool *P, void *obj, size_t size) {
+  if (! obj)
+    return;
+  P->nReleases++;
+  if (size > POOL_MAX_OBJ)
+    return;
+  size_t cls = (size + 15) / 16;
+  *(void **)obj = P->freeLists[cls];
+  P->freeLists[cls] = obj;
+}
+
+//=================================================================
+// releases all memory of the pool at once
+void poolFree(pool *P) {
+  if (! P) 
+    return;
+  arenaFree(P->slabs);
+  free(P);
+}
+//=================================================================
+// creates a new reader on an open file
+reader *readerNew(FILE *file, size_t bufSize) {
+  reader *R = safeCalloc(1, sizeof(reader));
+  R->file = file;
+    // the buffer should at least hold any number
+  R->cap = bufSize ? MAX(bufSize, 64) : 1 << 20;
+  R->buf = safeMalloc(R->cap);
+  return R;
+}
+
+//=================================================================
+// deallocates the reader
+void readerFree(reader *R) {
+  if (! R)
+    return;
+  free(R->buf);
+  free(R);
+}
+
+//=================================================================
+// returns the shared reader on stdin
+reader *stdinReader(void) {
+  static reader *R = NULL;
+  if (! R)
+    R = readerNew(stdin, 0);
+  return R;
+}
+
+//=================================================================
+// refills the buffer of the reader
+bool readerFill(reader *R) {
+    // at the end of the input the buffer is left as it is
+  size_t n = fread(R->buf, 1, R->cap, R->file);
+  if (n == 0)
+    return false;
+  R->pos = 0;
+  R->len = n;
+  return true;
+}
+
+//=================================================================
+// consumes the bytes left in the buffer as a single chunk
+size_t readerChunk(reader *R, unsigned char const **chunk) {
+  if (R->pos == R->len && ! readerFill(R))
+    return 0;
+  *chunk = R->buf + R->pos;
+  size_t len = R->len - R->pos;
+  R->pos = R->len;
+  return len;
+}
+
+//=================================================================
+// returns true if c is a whitespace byte
+static inline bool isSpace(int c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+//=================================================================
+// skips all whitespace
+void readerSkipSpace(reader *R) {
+  while (R->pos < R->len || readerFill(R)) {
+    while (R->pos < R->len && isSpace(R->buf[R->pos]))
+      R->pos++;
+    if (R->pos < R->len)
+      return;
+  }
+}
+
+//=================================================================
+// skips spaces and tabs, and checks for the end of the line
+bool readerAtEol(reader *R) {
+  int c;
+  while ((c = readerPeek(R)) == ' ' || c == '\t' || c == '\r')
+    R->pos++;
+  return c == '\n' || c == EOF;
+}
+
+//=================================================================
+// skips the rest of the current line
+void readerSkipLine(reader *R) {
+  while (true) {
+    if (R->pos == R->len && ! readerFill(R))
+      return;
+    unsigned char *nl = memchr(R->buf + R->pos, '\n', 
+                               R->len - R->pos);
+    if (nl) {
+      R->pos = nl - R->buf + 1;
+      return;
+    }
+    R->pos = R->len;
+  }
+}
+
+//=================================================================
+// reads the next whitespace delimited token
+size_t readerToken(reader *R, char *buf, size_t size) {
+  readerSkipSpace(R);
+  size_t len = 0;
+    // scan the buffer directly, refilling it when the
+    // token runs up to its end
+  while (R->pos < R->len || (len > 0 && readerFill(R))) {
+    unsigned char *p = R->buf + R->pos;
+    unsigned char *end = R->buf + R->len;
+    while (p < end && ! isSpace(*p)) {
+      if (len + 1 < size)
+        buf[len] = *p;
+      len++;
+      p++;
+    }
+    R->pos = p - R->buf;
+    if (p < end)
+      break;
+  }
+  if (size)
+    buf[MIN(len, size - 1)] = '\0';
+  return len;
+}
+
+//=================================================================
+// reads the digits of an unsigned integer after an optional sign;
+// returns false if there are no digits
+static bool readDigits(reader *R, unsigned long long *x, bool *neg) {
+  readerSkipSpace(R);
+  int c = readerPeek(R);
+  *neg = c == '-';
+  if (c == '-' || c == '+') {
+    R->pos++;
+    c = readerPeek(R);
+  }
+  if (c < '0' || c > '9')
+    return false;
+  unsigned long long val = 0;
+  while ((c = readerPeek(R)) >= '0' && c <= '9') {
+    val = val * 10 + (c - '0');
+    R->pos++;
+  }
+  *x = val;
+  return true;
+}
+
+//=================================================================
+// reads the next signed integer
+bool readerLong(reader *R, long long *x) {
+  unsigned long long val;
+  bool neg;
+  if (! readDigits(R, &val, &neg))
+    return false;
+  *x = neg ? -(long long)val : (long long)val;
+  return true;
+}
+
+//=================================================================
+// reads the next unsigned integer; like scanf, a minus sign
+// negates the value in unsigned arithmetic
+bool readerULong(reader *R, unsigned long long *x) {
+  bool neg;
+  if (! readDigits(R, x, &neg))
+    return false;
+  if (neg)
+    *x = -*x;
+  return true;
+}
+
+//=================================================================
+// makes sure that the next n bytes of the input are in the 
+// buffer, unless the input ends before that
+static void readerEnsure(reader *R, size_t n) {
+  if (R->len - R->pos >= n)
+    return;
+  memmove(R->buf, R->buf + R->pos, R->len - R->pos);
+  R->len -= R->pos;
+  R->pos = 0;
+  R->len += fread(R->buf + R->len, 1, R->cap - R->len, R->file);
+}
+
+//=================================================================
+// reads the next double
+// Numbers with at most 19 significant digits and a small decimal 
+// exponent are converted exactly with a single multiplication or 
+// division by a power of ten, all others are left to strtod
+bool readerDouble(reader *R, double *x) {
+  static const double pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 
+    1e20, 1e21, 1e22
+  };
+  char num[64];
+  size_t len = 0;
+  int c;
+
+  readerSkipSpace(R);
+    // copy the characters that can be part of the number;
+    // they stay in the buffer, so they can be given back
+  readerEnsure(R, sizeof(num));
+  size_t start = R->pos;
+  while ((c = readerPeek(R)) != EOF && len < sizeof(num) - 1 &&
+         ((c >= '0' && c <= '9') || c == '.' || c == '-' ||
+          c == '+' || (c >= 'a' && c <= 'z') || 
+          (c >= 'A' && c <= 'Z'))) {
+    num[len++] = c;
+    R->pos++;
+  }
+  num[len] = '\0';
+
+    // fast path for plain decimal numbers
+  size_t i = 0;
+  bool neg = num[0] == '-';
+  if (num[0] == '-' || num[0] == '+')
+    i++;
+  uint64_t mant = 0;
+  int digits = 0, exp = 0;
+  bool seenDigit = false, seenDot = false;
+  for (; num[i]; i++) {
+    if (num[i] >= '0' && num[i] <= '9') {
+      seenDigit = true;
+      if (mant || num[i] != '0')
+        digits++;
+      mant = mant * 10 + (num[i] - '0');
+      if (seenDot)
+        exp--;
+    } else if (num[i] == '.' && ! seenDot) 
+      seenDot = true;
+    else
+      break;
+  }
+  if (seenDigit && (num[i] == 'e' || num[i] == 'E')) {
+    size_t j = i + 1;
+    bool expNeg = num[j] == '-';
+    if (num[j] == '-' || num[j] == '+')
+      j++;
+    if (num[j] >= '0' && num[j] <= '9') {
+      int e = 0;
+      for (; num[j] >= '0' && num[j] <= '9'; j++)
+        e = e < 10000 ? e * 10 + (num[j] - '0') : e;
+      exp += expNeg ? -e : e;
+      i = j;
+    }
+  }
+  if (seenDigit && num[i] == '\0' && digits <= 19 && 
+      mant <= (1ULL << 53) && exp >= -22 && exp <= 22) {
+    double val = (double)mant;
+    val = exp < 0 ? val / pow10[-exp] : val * pow10[exp];
+    *x = neg ? -val : val;
+    return true;
+  }
+
+    // anything else (inf, nan, hex floats, long mantissas ...)
+    // is converted by strtod, and the bytes that are not part
+    // of the number are given back
+  char *end;
+  double val = strtod(num, &end);
+  R->pos = start + (end - num);
+  if (end == num)
+    return false;
+  *x = val;
+  return true;
+}
+
+//=================================================================
+// reads one value as scanf would do with a single conversion
+bool readerScan(reader *R, char const *format, void *ptr) {
+  char const *f = format;
+  bool skip = false;
+  while (isSpace(*f)) {
+    skip = true;
+    f++;
+  }
+  if (*f++ != '%') {
+    fprintf(stderr, "readerScan: unsupported format \"%s\"\n", 
+            format);
+    return false;
+  }
+  
+    // length modifier
+  char mod[3] = "";
+  size_t m = 0;
+  while (m < 2 && strchr("hljztL", *f))
+    mod[m++] = *f++;
+  mod[m] = '\0';
+  char conv = *f++;
+
+  bool ok = true;
+  switch (conv) {
+    case 'c': {
+      if (skip)
+        readerSkipSpace(R);
+      int c = readerChar(R);
+      if (c == EOF)
+        return false;
+      *(char *)ptr = c;
+      break;
+    }
+    case 's':
+      ok = readerToken(R, ptr, SIZE_MAX) > 0;
+      break;
+    case 'f': case 'e': case 'g': case 'a': {
+      double x;
+      if (! (ok = readerDouble(R, &x)))
+        break;
+      if (mod[0] == 'l')
+        *(double *)ptr = x;
+      else if (mod[0] == 'L')
+        *(long double *)ptr = x;
+      else
+        *(float *)ptr = x;
+      break;
+    }
+    case 'd': case 'i': {
+      long long x;
+      if (! (ok = readerLong(R, &x)))
+        break;
+      if (strcmp(mod, "hh") == 0) *(signed char *)ptr = x;
+      else if (strcmp(mod, "h") == 0) *(short *)ptr = x;
+      else if (strcmp(mod, "l") == 0) *(long *)ptr = x;
+      else if (strcmp(mod, "ll") == 0) *(long long *)ptr = x;
+      else if (strcmp(mod, "z") == 0) *(size_t *)ptr = x;
+      else if (strcmp(mod, "j") == 0) *(intmax_t *)ptr = x;
+      else if (strcmp(mod, "t") == 0) *(ptrdiff_t *)ptr = x;
+      else *(int *)ptr = x;
+      break;
+    }
+    case 'u': {
+      unsigned long long x;
+      if (! (ok = readerULong(R, &x)))
+        break;
+      if (strcmp(mod, "hh") == 0) *(unsigned char *)ptr = x;
+      else if (strcmp(mod, "h") == 0) *(unsigned short *)ptr = x;
+      else if (strcmp(mod, "l") == 0) *(unsigned long *)ptr = x;
+      else if (strcmp(mod, "ll") == 0) *(unsigned long long *)ptr = x;
+      else if (strcmp(mod, "z") == 0) *(size_t *)ptr = x;
+      else if (strcmp(mod, "j") == 0) *(uintmax_t *)ptr = x;
+      else *(unsigned *)ptr = x;
+      break;
+    }
+    default:
+      fprintf(stderr, "readerScan: unsupported format \"%s\"\n", 
+              format);
+      return false;
+  }
+  
+    // trailing whitespace in the format skips whitespace
+  if (ok && isSpace(*f))
+    readerSkipSpace(R);
+  return ok;
+}
@@ -45,15 +45,97 @@
     } \
   }
 
+//:::::::::::::::::::::::: BUFFERED INPUT :::::::::::::::::::::::://
+
+  // A reader parses numbers and tokens directly from a large
+  // input buffer that is refilled in bulk, which is much faster
+  // than scanning the input one element at a time with scanf.
+  // Note that a reader on stdin reads ahead: once it is used,
+  // the remaining input should not be read with scanf any more
+typedef struct {
+  FILE *file;           // input file
+  unsigned char *buf;   // input buffer
+  size_t pos;           // position of the next byte in buf
+  size_t len;           // number of valid bytes in buf
+  size_t cap;           // capacity of buf
+} reader;
+
+  // creates a new reader on an open file; bufSize is the
+  // size of the input buffer, 0 selects a default of 1 MiB
+reader *readerNew(FILE *file, size_t bufSize);
+
+  // deallocates the reader; the file is not closed
+void readerFree(reader *R);
+
+  // returns the shared reader on stdin, used by the
+  // READ macros below
+reader *stdinReader(void);
+
+  // refills the buffer of the reader
+  // returns false at the end of the input
+bool readerFill(reader *R);
+
+  // returns the next byte without consuming it, or EOF
+static inline int readerPeek(reader *R) {
+  if (R->pos == R->len && ! readerFill(R))
+    return EOF;
+  return R->buf[R->pos];
+}
+
+  // returns and consumes the next byte, or EOF
+static inline int readerChar(reader *R) {
+  if (R->pos == R->len && ! readerFill(R))
+    return EOF;
+  return R->buf[R->pos++];
+}
+
+  // consumes all bytes that are left in the buffer, refilling it
+  // first if it is empty, and points chunk to them; the chunk is 
+  // valid until the next call on the reader
+  // returns the number of bytes in the chunk, 0 at the end of 
+  // the input
+size_t readerChunk(reader *R, unsigned char const **chunk);
+
+  // skips all whitespace
+void readerSkipSpace(reader *R);
+
+  // skips spaces and tabs, and returns true if the next
+  // byte is a newline or the end of the input
+bool readerAtEol(reader *R);
+
+  // skips the rest of the current line, including the newline
+void readerSkipLine(reader *R);
+
+  // reads the next whitespace delimited token into buf,
+  // truncating it to size - 1 bytes if needed
+  // returns the length of the token, 0 at the end of the input
+size_t readerToken(reader *R, char *buf, size_t size);
+
+  // read the next signed / unsigned integer or double,
+  // skipping leading whitespace; return false if there
+  // is no number at the current position
+bool readerLong(reader *R, long long *x);
+bool readerULong(reader *R, unsigned long long *x);
+bool readerDouble(reader *R, double *x);
+
+  // reads one value as scanf would do with a format holding
+  // a single conversion: %d, %i, %u, %f, %e, %g, %c or %s,
+  // with an optional length modifier (hh, h, l, ll, z, j, t, L)
+  // and optional whitespace around it
+  // returns false if no value could be read
+bool readerScan(reader *R, char const *format, void *ptr);
+
 //::::::::::::::::::::::::: READING INPUT :::::::::::::::::::::::://
 
+  // The macros below read from stdin through stdinReader
+
   // macro for reading input into a 1D array of known length
   // Examples:  READ_ARRAY(myInts, "%d", 20);
   //            READ_ARRAY(myDbls, "%lf", 15);
   //            READ_ARRAY(myString, "%c", 10);
 #define READ_ARRAY(arr, format, len) \
   for (size_t arr##i = 0; arr##i < len; ++arr##i) \
-    (void)! scanf(format, &arr[arr##i])
+    (void)! readerScan(stdinReader(), format, &arr[arr##i])
 
   // macro for reading input into a 2D matrix of given dimensions
   // Examples:  READ_MATRIX(myInts, "%d", 10, 5);
@@ -62,7 +144,8 @@
 #define READ_MATRIX(matrix, format, rows, cols) \
   for (size_t arr##i = 0; arr##i < rows; ++arr##i) \
     for (size_t arr##j = 0; arr##j < cols; ++arr##j) \
-      (void)! scanf(format, &matrix[arr##i][arr##j])
+      (void)! readerScan(stdinReader(), format, \
+                         &matrix[arr##i][arr##j])
 
   // macro for reading input from stdin as long as it lasts
   // creates a new array of the given type and format, and
@@ -74,7 +157,7 @@
 #define READ(type, arr, format, size) \
   type *arr = safeCalloc(100, sizeof(type)); \
   size_t size = 0; type arr##var; \
-  while (scanf(format, &arr##var) == 1) { \
+  while (readerScan(stdinReader(), format, &arr##var)) { \
     arr[size++] = arr##var; \
     if (size % 100 == 0) { \
       arr = safeRealloc(arr, (size + 100) * sizeof(type)); \
@@ -93,7 +176,7 @@
 #define READ_UNTIL(type, arr, format, delim, size) \
   type *arr = safeCalloc(100, sizeof(type)); \
   size_t size = 0; type arr##var; \
-  while (scanf(format, &arr##var) == 1) { \
+  while (readerScan(stdinReader(), format, &arr##var)) { \
     arr[size++] = arr##var; \
     if (size% 100 == 0) { \
       arr = safeRealloc(arr, (size + 100) * sizeof(type)); \
@@ -101,7 +184,8 @@
     } \
   } \
   arr[size] = '\0';\
-  (void) ! scanf("%*c ")
+  (void) readerChar(stdinReader()); \
+  readerSkipSpace(stdinReader())
     
 //::::::::::::::::::::::: MEMORY MANAGEMENT :::::::::::::::::::::://
 
@@ -175,6 +259,62 @@ void *safeRealloc(void *ptr, size_t newSize);
   // clears the input buffer
 void clearStdin(char *buffer);
 
+//:::::::::::::::::::::::: ARENAS AND POOLS :::::::::::::::::::::://
+
+  // An arena (region) hands out memory from large blocks
+  // by simply bumping a pointer; the memory cannot be freed
+  // piecemeal, but is released all at once by arenaFree
+typedef struct arenaBlock {
+  struct arenaBlock *next;  // previously filled block
+  size_t size;              // usable size of the block
+  size_t used;              // number of bytes handed out
+} arenaBlock;
+
+typedef struct {
+  arenaBlock *head;         // block that is being filled
+  size_t blockSize;         // default size of a new block
+  size_t nBlocks;           // number of blocks allocated
+} arena;
+
+  // creates a new arena; blockSize is the default size
+  // of the blocks, 0 selects a default of 64 KiB
+arena *arenaNew(size_t blockSize);
+
+  // returns n zeroed bytes from the arena, 
+  // aligned to 16 bytes
+void *arenaAlloc(arena *A, size_t n);
+
+  // releases all memory of the arena at once
+void arenaFree(arena *A);
+
+  // A pool is a set of fixed-size slab allocators on top of
+  // an arena: objects are grouped in size classes of 16 bytes
+  // up to POOL_MAX_OBJ bytes, and released objects are kept
+  // on a free list for their class, to be handed out again;
+  // everything is released at once by poolFree
+#define POOL_MAX_OBJ 256
+
+typedef struct pool {
+  arena *slabs;             // arena from which the slabs are cut
+  void *freeLists[POOL_MAX_OBJ / 16 + 1];  
+                            // free list per size class
+  size_t nAllocs;           // number of objects handed out
+  size_t nReleases;         // number of objects released
+} pool;
+
+  // creates a new pool
+pool *poolNew(void);
+
+  // returns a zeroed object of the given size from the pool
+void *poolAlloc(pool *P, size_t size);
+
+  // returns an object of the given size to the pool,
+  // so that it can be reused
+void poolRelease(pool *P, void *obj, size_t size);
+
+  // releases all memory of the pool at once
+void poolFree(pool *P);
+
 //:::::::::::::::::::::::::::: STRINGS ::::::::::::::::::::::::::://
 
 typedef struct {
@@ -188,8 +328,8 @@ typedef struct {
   string *arr = safeCalloc(1, sizeof(string)); \
   arr->data = safeCalloc(100, sizeof(unsigned char)); \
   arr->cap = 100; \
-  size_t arr##size##Len = 0; unsigned char arr##size##var; \
-  while (scanf("%c", &arr##size##var) == 1 \
+  size_t arr##size##Len = 0; int arr##size##var; \
+  while ((arr##size##var = readerChar(stdinReader())) != EOF \
          && arr##size##var != delim) { \
     arr->data[arr##size##Len++] = arr##size##var; \
     if (arr##size##Len == arr->cap) { \